@@ -7,6 +7,17 @@
 
 const double Car::PI = 3.14159265358979323846;
 
+// Defines the step period used at full fidelity, in seconds
+static const double full_step_period = 0.01;
+
+// Defines the distance between points checked by each sensor at full fidelity
+static const double full_sensor_increment = 2.0;
+
+// Defines how many times larger the step period and the sensor increment are
+// when screening at low fidelity
+static const double screening_step_factor = 2.0;
+static const double screening_sensor_factor = 2.0;
+
 Car::Car()
 {
     // Initialize sensor values
@@ -140,9 +151,11 @@ void Car::step_movement(const RoadGrid& grid, const double forward, const double
             (forward >= 0 && input_forward_prev >= 0) ||
             (forward <= 0 && input_forward_prev <= 0);
 
-        // Set the forward and turn increments
-        const double fwd_incr = 0.005 * ((input_same_sign) ? 1 : 10);
-        const double trn_incr = 0.085;
+        // Set the forward and turn increments, scaled with the step period so that
+        // the inputs change at the same rate for each fidelity
+        const double incr_scale = step_period() / full_step_period;
+        const double fwd_incr = 0.005 * ((input_same_sign) ? 1 : 10) * incr_scale;
+        const double trn_incr = 0.085 * incr_scale;
 
         // Filter the forward values
         const double fwd_val = step_filter(
@@ -181,10 +194,18 @@ void Car::step_movement(const RoadGrid& grid, const double forward, const double
         max_turn_right = std::max(max_turn_right, turn);
         max_turn_left = std::max(max_turn_left, -turn);
 
-        // Update the average speed and step count
+        // Update the average speed, average turn and step count
         average_speed = (average_speed * car_step_count + forward_speed) / (car_step_count + 1.0);
+        average_turn = (average_turn * car_step_count + std::abs(trn_val)) / (car_step_count + 1.0);
         car_step_count += 1;
 
+        // Sample the trajectory
+        if (car_step_count % trajectory_sample_steps == 0 && trajectory.size() < 2 * trajectory_max_samples)
+        {
+            trajectory.push_back(x);
+            trajectory.push_back(y);
+        }
+
         // Check for collision
         check_collision(grid);
 
@@ -277,6 +298,14 @@ void Car::reset()
     // Reset the velocity state
     car_step_count = 0;
     average_speed = 0.0;
+    average_turn = 0.0;
+    trajectory.clear();
+
+    // Reset the sensor results, so that each episode starts from the same inputs
+    for (Sensor& sensor : sensors)
+    {
+        sensor.result = SensorResult();
+    }
 }
 
 double Car::get_length() const
@@ -306,7 +335,17 @@ double Car::get_delta_distance() const
 
 double Car::step_period() const
 {
-    return 0.01;
+    return (fidelity == Fidelity::SCREENING) ? screening_step_factor * full_step_period : full_step_period;
+}
+
+void Car::set_fidelity(const Fidelity value)
+{
+    fidelity = value;
+}
+
+Car::Fidelity Car::get_fidelity() const
+{
+    return fidelity;
 }
 
 Car::~Car()
@@ -371,6 +410,11 @@ double Car::get_average_speed() const
     return average_speed;
 }
 
+double Car::get_average_turn() const
+{
+    return average_turn;
+}
+
 double Car::get_max_turn_right() const
 {
     return max_turn_right;
@@ -386,6 +430,11 @@ uint64_t Car::get_step_count() const
     return car_step_count;
 }
 
+const std::vector<double>& Car::get_trajectory() const
+{
+    return trajectory;
+}
+
 void Car::update_all_sensors(const RoadGrid& tile_grid)
 {
     for (size_t i = 0; i < sensors.size(); ++i)
@@ -404,7 +453,7 @@ void Car::update_all_sensors(const RoadGrid& tile_grid)
         const double dlat_rot = rot_vec_lat(sensor.delta_lon, sensor.delta_lat) / dmag;
 
         // Determine the increment to use in searching
-        const double incr = 2;
+        const double incr = (fidelity == Fidelity::SCREENING) ? screening_sensor_factor * full_sensor_increment : full_sensor_increment;
 
         double xval = origin_x;
         double yval = origin_y;
@@ -5,6 +5,7 @@
 #include <tiles/tile_grid.h>
 
 #include <array>
+#include <vector>
 
 /// <summary>
 /// Defines the car state object
@@ -17,6 +18,16 @@ public:
     /// </summary>
     static const double PI;
 
+    /// <summary>
+    /// Provides the simulation fidelity options, where screening uses a larger step
+    /// period and a coarser sensor search to cut the cost of simulating a design
+    /// </summary>
+    enum class Fidelity
+    {
+        FULL = 0,
+        SCREENING = 1
+    };
+
     /// <summary>
     /// Provides a state response for sensor parameters
     /// </summary>
@@ -147,6 +158,18 @@ public:
     /// <returns>the period requested for steps, in seconds</returns>
     double step_period() const;
 
+    /// <summary>
+    /// Sets the simulation fidelity used for the following steps
+    /// </summary>
+    /// <param name="value">the fidelity to simulate with</param>
+    void set_fidelity(const Fidelity value);
+
+    /// <summary>
+    /// Provides the simulation fidelity
+    /// </summary>
+    /// <returns>the fidelity used for steps</returns>
+    Fidelity get_fidelity() const;
+
     /// <summary>
     /// Obtains the sensor result value for the given sensor number and road grid
     /// </summary>
@@ -172,6 +195,12 @@ public:
     /// <returns>the average speed since the last reset</returns>
     double get_average_speed() const;
 
+    /// <summary>
+    /// Returns the average magnitude of the filtered turn since reset
+    /// </summary>
+    /// <returns>the average turn magnitude since the last reset, in [0, 1]</returns>
+    double get_average_turn() const;
+
     /// <summary>
     /// Returns the maximum turn input provided since reset to the right
     /// </summary>
@@ -190,6 +219,23 @@ public:
     /// <returns>the step count since the last reset</returns>
     uint64_t get_step_count() const;
 
+    /// <summary>
+    /// Returns the positions of the car sampled every trajectory_sample_steps steps
+    /// since reset, up to trajectory_max_samples positions
+    /// </summary>
+    /// <returns>the sampled positions as x, y pairs</returns>
+    const std::vector<double>& get_trajectory() const;
+
+    /// <summary>
+    /// Defines the number of steps between trajectory samples
+    /// </summary>
+    const static uint64_t trajectory_sample_steps = 100;
+
+    /// <summary>
+    /// Defines the largest number of trajectory samples kept
+    /// </summary>
+    const static size_t trajectory_max_samples = 16;
+
 public:
     ~Car();
 
@@ -332,6 +378,11 @@ protected:
     /// </summary>
     double average_speed = 0.0;
 
+    /// <summary>
+    /// Stores an overall average of the magnitude of the car's filtered turn
+    /// </summary>
+    double average_turn = 0.0;
+
     /// <summary>
     /// Stores the maximum right turn value used in the solution
     /// </summary>
@@ -342,11 +393,21 @@ protected:
     /// </summary>
     double max_turn_left = 0.0;
 
+    /// <summary>
+    /// Stores the sampled positions of the car since reset as x, y pairs
+    /// </summary>
+    std::vector<double> trajectory;
+
     /// <summary>
     /// Flag to track if the car has collided with something or not
     /// </summary>
     bool collided = false;
 
+    /// <summary>
+    /// The simulation fidelity used for steps
+    /// </summary>
+    Fidelity fidelity = Fidelity::FULL;
+
     /// <summary>
     /// Provides the overall bitmap for the car
     /// </summary>
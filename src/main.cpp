@@ -122,6 +122,7 @@ int main()
 
     // Draw the background display
     draw_background_bitmap_for_state(state, background_bitmap);
+    size_t background_grid_index = state.get_tile_grid_index();
 
     // Initialize the event queue and add events to the main queue
     ALLEGRO_EVENT_QUEUE* queue = al_create_event_queue();
@@ -201,10 +202,16 @@ int main()
                 case ALLEGRO_KEY_S:
                     state.toggle_save_best_networks();
                     break;
+                case ALLEGRO_KEY_R:
+                    state.write_rank_report("rank_report.txt");
+                    break;
                 case ALLEGRO_KEY_N:
-                    state.set_tile_grid_index((state.get_tile_grid_index() + 1) % state.get_tile_grid_count());
-                    draw_background_bitmap_for_state(state, background_bitmap);
-                    state.reset_car();
+                    // The track schedule chooses the track while optimizing across tracks
+                    if (state.get_current_mode() != GameState::GameMode::OPTIM || !state.optim_state.has_track_schedule())
+                    {
+                        state.set_tile_grid_index((state.get_tile_grid_index() + 1) % state.get_tile_grid_count());
+                        state.reset_car();
+                    }
                     break;
                 case ALLEGRO_KEY_P:
                     if (al_get_timer_started(car_step_timer))
@@ -248,6 +255,14 @@ int main()
         case ALLEGRO_EVENT_TIMER:
             if (event.timer.source == main_timer)
             {
+                // Redraw the background once the track changes, either from the keyboard
+                // or from the track schedule
+                if (state.get_tile_grid_index() != background_grid_index)
+                {
+                    draw_background_bitmap_for_state(state, background_bitmap);
+                    background_grid_index = state.get_tile_grid_index();
+                }
+
                 // Draw the background
                 al_draw_bitmap(background_bitmap, 0, 0, 0);
 
@@ -281,7 +296,7 @@ int main()
                     0);
 
                 // Define the output string
-                for (size_t i = 0; i < 5; ++i)
+                for (size_t i = 0; i < 10; ++i)
                 {
                     std::ostringstream status_str;
 
@@ -330,6 +345,44 @@ int main()
                             status_str << "Generation: " << state.optim_state.get_best_generation();
                         }
                         break;
+                    case 5:
+                        if (state.get_current_mode() == GameState::GameMode::OPTIM)
+                        {
+                            status_str << "Cache Hits: " << std::setprecision(3) << 100.0 * state.optim_state.get_cache_hit_rate() << "%";
+                        }
+                        break;
+                    case 6:
+                        if (state.get_current_mode() == GameState::GameMode::OPTIM)
+                        {
+                            const RacingMonitor& racing = state.optim_state.get_racing_monitor();
+                            if (racing.get_mode() != RacingMonitor::Mode::OFF)
+                            {
+                                status_str << "Racing Aborts: " << racing.get_aborted_count() << ", Steps: " << racing.get_simulated_steps();
+                                if (racing.get_mode() == RacingMonitor::Mode::SHADOW)
+                                {
+                                    status_str << ", Saved: " << racing.get_saved_steps() << ", Loss: " << racing.get_fitness_loss();
+                                }
+                            }
+                        }
+                        break;
+                    case 7:
+                        if (state.get_current_mode() == GameState::GameMode::OPTIM && state.optim_state.has_surrogate())
+                        {
+                            status_str << "Surrogate Rank Corr: " << std::setprecision(3) << state.optim_state.get_surrogate_rank_correlation() << ", Saved: " << state.optim_state.get_surrogate_saved_episodes();
+                        }
+                        break;
+                    case 8:
+                        if (state.get_current_mode() == GameState::GameMode::OPTIM && state.optim_state.has_multi_fidelity())
+                        {
+                            status_str << "Fidelity Corr: " << std::setprecision(3) << state.optim_state.get_fidelity_correlation() << ", Promoted: " << state.optim_state.get_fidelity_promoted_count();
+                        }
+                        break;
+                    case 9:
+                        if (state.get_current_mode() == GameState::GameMode::OPTIM && state.optim_state.has_restarts())
+                        {
+                            status_str << "Restarts: " << state.optim_state.get_restart_count() << ", Population: " << state.optim_state.get_population_size();
+                        }
+                        break;
                     }
 
                     al_draw_text(
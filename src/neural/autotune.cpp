@@ -0,0 +1,349 @@
+#include "neural/autotune.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <cstring>
+#include <intrin.h>
+#endif
+
+#include "neural/compiled_net.h"
+#include "neural/ternary_net.h"
+
+// Defines the number of network steps to run in each timing trial
+static const size_t timing_steps = 2000;
+
+// Defines the number of timing trials, with the shortest trial kept
+static const size_t timing_trials = 5;
+
+// Adds the provided value into the FNV-1a hash
+static void hash_value(
+    uint64_t& hash,
+    const uint64_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        hash ^= (value >> (8 * i)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+}
+
+KernelTuner::KernelTuner(const std::string& cache_fname) :
+    cache_fname(cache_fname),
+    cpu_name(cpu_model())
+{
+    load_cache();
+}
+
+KernelTuner::Kernel KernelTuner::select_kernel(
+    const NeuralNetwork& net,
+    const size_t batch_size,
+    const bool allow_approximate)
+{
+    // Use the cached kernel if available
+    const std::string key = cache_key(net, batch_size, allow_approximate);
+
+    const auto it = cache.find(key);
+    if (it != cache.end())
+    {
+        return it->second;
+    }
+
+    // Define the candidate kernels
+    std::vector<Kernel> candidates = { Kernel::GRAPH };
+
+    std::vector<double> weights;
+    if (net.get_layer_sizes().size() > 1 && net.get_layer_weights(1, weights))
+    {
+        candidates.push_back(Kernel::DENSE);
+        candidates.push_back(Kernel::SPARSE);
+
+        if (batch_size > 1)
+        {
+            candidates.push_back(Kernel::BATCHED);
+        }
+
+        if (allow_approximate)
+        {
+            candidates.push_back(Kernel::TERNARY);
+        }
+    }
+
+    // Time each candidate, keeping the fastest
+    Kernel best_kernel = Kernel::GRAPH;
+    double best_time = 0.0;
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        double kernel_time;
+
+        try
+        {
+            kernel_time = time_kernel(candidates[i], net, std::max<size_t>(batch_size, 1));
+        }
+        catch (const std::invalid_argument&)
+        {
+            continue;
+        }
+
+        if (i == 0 || kernel_time < best_time)
+        {
+            best_kernel = candidates[i];
+            best_time = kernel_time;
+        }
+    }
+
+    // Save the result
+    cache[key] = best_kernel;
+    save_cache();
+
+    return best_kernel;
+}
+
+std::unique_ptr<NeuralModel> KernelTuner::create_model(
+    const Kernel kernel,
+    const NeuralNetwork& net)
+{
+    switch (kernel)
+    {
+    case Kernel::DENSE:
+    case Kernel::BATCHED:
+        return std::make_unique<CompiledNetwork>(net, CompiledNetwork::Storage::DENSE);
+    case Kernel::SPARSE:
+        return std::make_unique<CompiledNetwork>(net, CompiledNetwork::Storage::SPARSE);
+    case Kernel::TERNARY:
+        return std::make_unique<TernaryNetwork>(TernaryNetwork::from_network(net));
+    default:
+        return net.clone();
+    }
+}
+
+std::string KernelTuner::kernel_name(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::DENSE:
+        return "dense";
+    case Kernel::SPARSE:
+        return "sparse";
+    case Kernel::BATCHED:
+        return "batched";
+    case Kernel::TERNARY:
+        return "ternary";
+    default:
+        return "graph";
+    }
+}
+
+uint64_t KernelTuner::topology_hash(const NeuralNetwork& net)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+
+    const std::vector<size_t> sizes = net.get_layer_sizes();
+    hash_value(hash, sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        hash_value(hash, sizes[i]);
+    }
+
+    const std::vector<NeuralLink>& links = net.get_links();
+    hash_value(hash, links.size());
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+        hash_value(hash, links[i].from_node_id());
+        hash_value(hash, links[i].to_node_id());
+    }
+
+    return hash;
+}
+
+std::string KernelTuner::cpu_model()
+{
+#if defined(_MSC_VER)
+    // Read the processor brand string from the extended CPUID leaves
+    int regs[4];
+    char brand[49] = { 0 };
+
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned int>(regs[0]) >= 0x80000004)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            __cpuid(regs, 0x80000002 + i);
+            std::memcpy(brand + 16 * i, regs, sizeof(regs));
+        }
+    }
+
+    std::string name(brand);
+#else
+    // Read the model name from the processor information file
+    std::string name;
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+
+    while (name.empty() && std::getline(cpuinfo, line))
+    {
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            const size_t pos = line.find(':');
+            if (pos != std::string::npos)
+            {
+                name = line.substr(pos + 1);
+            }
+        }
+    }
+#endif
+
+    // Remove surrounding whitespace
+    const size_t start = name.find_first_not_of(" \t");
+    const size_t end = name.find_last_not_of(" \t\r\n");
+
+    if (start == std::string::npos)
+    {
+        return "unknown";
+    }
+    else
+    {
+        return name.substr(start, end - start + 1);
+    }
+}
+
+double KernelTuner::time_kernel(
+    const Kernel kernel,
+    const NeuralNetwork& net,
+    const size_t batch_size)
+{
+    std::unique_ptr<NeuralModel> model = create_model(kernel, net);
+    CompiledNetwork* compiled = dynamic_cast<CompiledNetwork*>(model.get());
+
+    const size_t num_inputs = model->size_inputs() - 1;
+    const size_t num_outputs = model->size_outputs() - 1;
+
+    // Define repeatable random inputs and gains, so that sparse and quantized
+    // kernels see the same work as the trained network
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    std::vector<double> params(model->parameter_count());
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        params[i] = distribution(generator);
+    }
+    model->set_parameters(params.data());
+
+    std::vector<double> inputs(batch_size * num_inputs);
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        inputs[i] = distribution(generator);
+    }
+
+    std::vector<double> outputs(batch_size * num_outputs, 0.0);
+
+    // Evaluates the batch once with the kernel
+    const auto run_batch = [&]()
+    {
+        if (kernel == Kernel::BATCHED && compiled != nullptr)
+        {
+            compiled->step_batch(inputs.data(), batch_size, outputs.data());
+            return;
+        }
+
+        for (size_t b = 0; b < batch_size; ++b)
+        {
+            for (size_t i = 0; i < num_inputs; ++i)
+            {
+                model->set_input(i, inputs[b * num_inputs + i]);
+            }
+
+            model->step_network();
+
+            for (size_t i = 0; i < num_outputs; ++i)
+            {
+                model->get_output(i, outputs[b * num_outputs + i]);
+            }
+        }
+    };
+
+    // Time the batch, keeping the shortest trial to reject interruptions
+    const size_t repeats = std::max<size_t>(timing_steps / batch_size, 1);
+    double best_time = 0.0;
+
+    run_batch();
+
+    for (size_t trial = 0; trial < timing_trials; ++trial)
+    {
+        const auto start_time = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < repeats; ++i)
+        {
+            run_batch();
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        const double batch_time = elapsed.count() / static_cast<double>(repeats);
+
+        if (trial == 0 || batch_time < best_time)
+        {
+            best_time = batch_time;
+        }
+    }
+
+    return best_time;
+}
+
+std::string KernelTuner::cache_key(
+    const NeuralNetwork& net,
+    const size_t batch_size,
+    const bool allow_approximate) const
+{
+    std::ostringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << topology_hash(net) << std::dec;
+    ss << " " << static_cast<int>(batch_size);
+    ss << " " << (allow_approximate ? 1 : 0);
+    ss << " " << cpu_name;
+    return ss.str();
+}
+
+void KernelTuner::load_cache()
+{
+    // Each line contains the kernel name followed by the cache key
+    std::ifstream input(cache_fname);
+    std::string line;
+
+    const Kernel kernels[] = { Kernel::GRAPH, Kernel::DENSE, Kernel::SPARSE, Kernel::BATCHED, Kernel::TERNARY };
+
+    while (std::getline(input, line))
+    {
+        const size_t pos = line.find(' ');
+        if (pos == std::string::npos)
+        {
+            continue;
+        }
+
+        const std::string name = line.substr(0, pos);
+        for (const Kernel k : kernels)
+        {
+            if (kernel_name(k) == name)
+            {
+                cache[line.substr(pos + 1)] = k;
+            }
+        }
+    }
+}
+
+bool KernelTuner::save_cache() const
+{
+    std::ofstream output(cache_fname);
+    for (const auto& entry : cache)
+    {
+        output << kernel_name(entry.second) << " " << entry.first << std::endl;
+    }
+    return output.good();
+}
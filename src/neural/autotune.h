@@ -0,0 +1,135 @@
+#ifndef __IO_NEURAL_AUTOTUNE__
+#define __IO_NEURAL_AUTOTUNE__
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "neural/model.h"
+#include "neural/net.h"
+
+/// <summary>
+/// Selects the fastest inference kernel for a network topology and batch size by
+/// timing each candidate on the running machine. Results are cached in a file keyed
+/// by the CPU model and a hash of the topology, so that later runs skip the timing
+/// </summary>
+class KernelTuner
+{
+public:
+    /// <summary>
+    /// Provides the inference kernels that may be selected
+    /// </summary>
+    enum class Kernel
+    {
+        GRAPH = 0,
+        DENSE = 1,
+        SPARSE = 2,
+        BATCHED = 3,
+        TERNARY = 4
+    };
+
+public:
+    /// <summary>
+    /// Creates the tuner, loading any previous results from the cache file
+    /// </summary>
+    /// <param name="cache_fname">the file to load and save the selected kernels</param>
+    KernelTuner(const std::string& cache_fname);
+
+    /// <summary>
+    /// Provides the fastest kernel for the topology of the given network, timing
+    /// the candidates and saving the result if the choice is not already cached
+    /// </summary>
+    /// <param name="net">the network to select a kernel for</param>
+    /// <param name="batch_size">the number of inputs evaluated together</param>
+    /// <param name="allow_approximate">true if kernels that quantize the gains may be selected</param>
+    /// <returns>the selected kernel</returns>
+    Kernel select_kernel(
+        const NeuralNetwork& net,
+        const size_t batch_size,
+        const bool allow_approximate);
+
+    /// <summary>
+    /// Creates a model that evaluates the given network with the provided kernel
+    /// </summary>
+    /// <param name="kernel">the kernel to use</param>
+    /// <param name="net">the network to evaluate</param>
+    /// <returns>the model for the kernel</returns>
+    static std::unique_ptr<NeuralModel> create_model(
+        const Kernel kernel,
+        const NeuralNetwork& net);
+
+    /// <summary>
+    /// Provides the name of the given kernel
+    /// </summary>
+    /// <param name="kernel">the kernel</param>
+    /// <returns>the kernel name</returns>
+    static std::string kernel_name(const Kernel kernel);
+
+    /// <summary>
+    /// Provides a hash of the layer sizes and links in the network, ignoring the gains
+    /// </summary>
+    /// <param name="net">the network to hash</param>
+    /// <returns>the topology hash</returns>
+    static uint64_t topology_hash(const NeuralNetwork& net);
+
+    /// <summary>
+    /// Provides the model name of the running CPU, or "unknown" if it cannot be read
+    /// </summary>
+    /// <returns>the CPU model name</returns>
+    static std::string cpu_model();
+
+private:
+    /// <summary>
+    /// Provides the time to evaluate a batch of inputs with the given kernel
+    /// </summary>
+    /// <param name="kernel">the kernel to time</param>
+    /// <param name="net">the network to evaluate</param>
+    /// <param name="batch_size">the number of inputs in the batch</param>
+    /// <returns>the shortest time to evaluate the batch, in seconds</returns>
+    static double time_kernel(
+        const Kernel kernel,
+        const NeuralNetwork& net,
+        const size_t batch_size);
+
+    /// <summary>
+    /// Provides the cache key for the given topology and options on the running CPU
+    /// </summary>
+    /// <param name="net">the network</param>
+    /// <param name="batch_size">the batch size</param>
+    /// <param name="allow_approximate">true if approximate kernels are allowed</param>
+    /// <returns>the cache key</returns>
+    std::string cache_key(
+        const NeuralNetwork& net,
+        const size_t batch_size,
+        const bool allow_approximate) const;
+
+    /// <summary>
+    /// Loads the cached kernels from the cache file, ignoring unreadable lines
+    /// </summary>
+    void load_cache();
+
+    /// <summary>
+    /// Saves the cached kernels to the cache file
+    /// </summary>
+    /// <returns>true if successful</returns>
+    bool save_cache() const;
+
+private:
+    /// <summary>
+    /// The file used to load and save the selected kernels
+    /// </summary>
+    std::string cache_fname;
+
+    /// <summary>
+    /// The model name of the running CPU
+    /// </summary>
+    std::string cpu_name;
+
+    /// <summary>
+    /// The selected kernel for each cache key
+    /// </summary>
+    std::map<std::string, Kernel> cache;
+};
+
+#endif
@@ -0,0 +1,288 @@
+#include "neural/compiled_net.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+CompiledNetwork::CompiledNetwork(
+    const NeuralNetwork& net,
+    const Storage storage) :
+    source(net),
+    storage(storage),
+    layer_sizes(net.get_layer_sizes())
+{
+    // Ensure that layers were added
+    if (layer_sizes.size() == 0)
+    {
+        throw std::invalid_argument("network must have at least one layer");
+    }
+
+    // Determine which links are present by setting each gain to one, so that
+    // the sparse storage keeps links even while their gains are zero
+    NeuralNetwork pattern = net;
+    const std::vector<double> ones(pattern.parameter_count(), 1.0);
+    pattern.set_parameters(ones.data());
+
+    for (size_t i = 1; i < layer_sizes.size(); ++i)
+    {
+        CompiledLayer layer;
+        layer.rows = layer_sizes[i];
+        layer.cols = layer_sizes[i - 1] + 1;
+
+        std::vector<double> present;
+        if (!pattern.get_layer_weights(i, present))
+        {
+            std::ostringstream ss;
+            ss << "layer " << static_cast<int>(i) << " has links from outside the previous layer";
+            throw std::invalid_argument(ss.str());
+        }
+
+        // Define the compressed sparse rows for the links present
+        layer.row_starts.push_back(0);
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            for (size_t c = 0; c < layer.cols; ++c)
+            {
+                if (present[r * layer.cols + c] != 0.0)
+                {
+                    layer.sparse_cols.push_back(c);
+                }
+            }
+            layer.row_starts.push_back(layer.sparse_cols.size());
+        }
+
+        layer.sparse_values.assign(layer.sparse_cols.size(), 0.0);
+        compiled_layers.push_back(layer);
+    }
+
+    // Define the node values with a bias value after each layer
+    node_values.assign(layer_offset(layer_sizes.size()), 0.0);
+    for (size_t i = 0; i < layer_sizes.size(); ++i)
+    {
+        node_values[layer_offset(i) + layer_sizes[i]] = 1.0;
+    }
+
+    update_weights();
+}
+
+size_t CompiledNetwork::layer_offset(const size_t layer_index) const
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < layer_index; ++i)
+    {
+        offset += layer_sizes[i] + 1;
+    }
+    return offset;
+}
+
+void CompiledNetwork::update_weights()
+{
+    for (size_t i = 0; i < compiled_layers.size(); ++i)
+    {
+        CompiledLayer& layer = compiled_layers[i];
+        source.get_layer_weights(i + 1, layer.weights);
+
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            for (size_t j = layer.row_starts[r]; j < layer.row_starts[r + 1]; ++j)
+            {
+                layer.sparse_values[j] = layer.weights[r * layer.cols + layer.sparse_cols[j]];
+            }
+        }
+    }
+}
+
+bool CompiledNetwork::step_network()
+{
+    // Return false if the layer size is less than two
+    //   for no layers, or input layer is also output layer
+    if (layer_sizes.size() < 2)
+    {
+        return false;
+    }
+
+    size_t in_offset = 0;
+
+    for (size_t i = 0; i < compiled_layers.size(); ++i)
+    {
+        const CompiledLayer& layer = compiled_layers[i];
+        const double* in_vals = &node_values[in_offset];
+        double* out_vals = &node_values[in_offset + layer.cols];
+
+        if (storage == Storage::DENSE)
+        {
+            for (size_t r = 0; r < layer.rows; ++r)
+            {
+                const double* wrow = &layer.weights[r * layer.cols];
+                double sum = 0.0;
+                for (size_t c = 0; c < layer.cols; ++c)
+                {
+                    sum += wrow[c] * in_vals[c];
+                }
+                out_vals[r] = sum;
+            }
+        }
+        else
+        {
+            for (size_t r = 0; r < layer.rows; ++r)
+            {
+                double sum = 0.0;
+                for (size_t j = layer.row_starts[r]; j < layer.row_starts[r + 1]; ++j)
+                {
+                    sum += layer.sparse_values[j] * in_vals[layer.sparse_cols[j]];
+                }
+                out_vals[r] = sum;
+            }
+        }
+
+        in_offset += layer.cols;
+    }
+
+    return true;
+}
+
+bool CompiledNetwork::step_batch(
+    const double* inputs,
+    const size_t batch_size,
+    double* outputs)
+{
+    if (layer_sizes.size() < 2)
+    {
+        return false;
+    }
+
+    batch_values.resize(batch_size * layer_offset(layer_sizes.size()));
+
+    // Copy the inputs into the first layer block, adding the bias values
+    const size_t input_cols = layer_sizes.front() + 1;
+    for (size_t b = 0; b < batch_size; ++b)
+    {
+        std::copy(
+            inputs + b * layer_sizes.front(),
+            inputs + (b + 1) * layer_sizes.front(),
+            &batch_values[b * input_cols]);
+        batch_values[b * input_cols + layer_sizes.front()] = 1.0;
+    }
+
+    size_t in_offset = 0;
+
+    for (size_t i = 0; i < compiled_layers.size(); ++i)
+    {
+        const CompiledLayer& layer = compiled_layers[i];
+        const double* in_vals = &batch_values[in_offset];
+        double* out_vals = &batch_values[in_offset + batch_size * layer.cols];
+        const size_t out_cols = layer.rows + 1;
+
+        // Apply each weight row to every input in the batch while it is loaded
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            const double* wrow = &layer.weights[r * layer.cols];
+            for (size_t b = 0; b < batch_size; ++b)
+            {
+                const double* in_row = &in_vals[b * layer.cols];
+                double sum = 0.0;
+                for (size_t c = 0; c < layer.cols; ++c)
+                {
+                    sum += wrow[c] * in_row[c];
+                }
+                out_vals[b * out_cols + r] = sum;
+            }
+        }
+
+        for (size_t b = 0; b < batch_size; ++b)
+        {
+            out_vals[b * out_cols + layer.rows] = 1.0;
+        }
+
+        in_offset += batch_size * layer.cols;
+    }
+
+    // Copy the outputs from the final layer block, dropping the bias values
+    const size_t output_cols = layer_sizes.back() + 1;
+    for (size_t b = 0; b < batch_size; ++b)
+    {
+        const double* out_row = &batch_values[in_offset + b * output_cols];
+        std::copy(
+            out_row,
+            out_row + layer_sizes.back(),
+            outputs + b * layer_sizes.back());
+    }
+
+    return true;
+}
+
+bool CompiledNetwork::set_input(
+    const size_t index,
+    const double value)
+{
+    if (index < layer_sizes.front())
+    {
+        node_values[index] = value;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool CompiledNetwork::get_output(
+    const size_t index,
+    double& output) const
+{
+    if (index < layer_sizes.back())
+    {
+        output = node_values[layer_offset(layer_sizes.size() - 1) + index];
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+size_t CompiledNetwork::size_inputs() const
+{
+    return layer_sizes.front() + 1;
+}
+
+size_t CompiledNetwork::size_outputs() const
+{
+    return layer_sizes.back() + 1;
+}
+
+size_t CompiledNetwork::parameter_count() const
+{
+    return source.parameter_count();
+}
+
+std::vector<double> CompiledNetwork::get_parameters() const
+{
+    return source.get_parameters();
+}
+
+void CompiledNetwork::set_parameters(const double* values)
+{
+    source.set_parameters(values);
+    update_weights();
+}
+
+std::string CompiledNetwork::get_config() const
+{
+    return source.get_config();
+}
+
+NeuralModel::OutputHead CompiledNetwork::get_output_head() const
+{
+    return source.get_output_head();
+}
+
+void CompiledNetwork::set_output_head(const OutputHead head)
+{
+    source.set_output_head(head);
+}
+
+std::unique_ptr<NeuralModel> CompiledNetwork::clone() const
+{
+    return std::make_unique<CompiledNetwork>(*this);
+}
@@ -0,0 +1,213 @@
+#ifndef __IO_NEURAL_COMPILED_NET__
+#define __IO_NEURAL_COMPILED_NET__
+
+#include <vector>
+
+#include "neural/model.h"
+#include "neural/net.h"
+
+/// <summary>
+/// Defines a layered NeuralNetwork compiled into flat arrays, so that each step
+/// runs over contiguous memory instead of following node and link IDs
+/// </summary>
+class CompiledNetwork : public NeuralModel
+{
+public:
+    /// <summary>
+    /// Provides options for the storage of the layer weights
+    /// </summary>
+    enum class Storage
+    {
+        DENSE = 0,
+        SPARSE = 1
+    };
+
+public:
+    /// <summary>
+    /// Compiles the provided network. Will throw an std::invalid_argument if
+    /// the network has links between non-adjacent layers
+    /// </summary>
+    /// <param name="net">the network to compile</param>
+    /// <param name="storage">the storage to use for the layer weights; dense stores a
+    /// full matrix for each layer, and sparse stores only the links present</param>
+    CompiledNetwork(
+        const NeuralNetwork& net,
+        const Storage storage);
+
+    /// <summary>
+    /// Steps the network for a batch of inputs at once, sharing each weight load
+    /// across the batch. Uses dense storage regardless of the compiled storage
+    /// </summary>
+    /// <param name="inputs">the row-major batch_size x non-bias input count input values</param>
+    /// <param name="batch_size">the number of input rows</param>
+    /// <param name="outputs">the row-major batch_size x non-bias output count output values</param>
+    /// <returns>true if successful</returns>
+    bool step_batch(
+        const double* inputs,
+        const size_t batch_size,
+        double* outputs);
+
+    /// <summary>
+    /// Steps the network to calculate the new outputs from the given inputs
+    /// </summary>
+    /// <returns>true if successful</returns>
+    virtual bool step_network() override;
+
+    /// <summary>
+    /// Sets the given input to a provided value
+    /// </summary>
+    /// <param name="index">the input index to set</param>
+    /// <param name="value">the value to set</param>
+    /// <returns>true if successful</returns>
+    virtual bool set_input(
+        const size_t index,
+        const double value) override;
+
+    /// <summary>
+    /// Obtains the given output for a value
+    /// </summary>
+    /// <param name="index">the output index to get</param>
+    /// <param name="output">the output parameter to use</param>
+    /// <returns>true if successful</returns>
+    virtual bool get_output(
+        const size_t index,
+        double& output) const override;
+
+    /// <summary>
+    /// Provides the number of inputs, including the bias node
+    /// </summary>
+    /// <returns>the number of inputs</returns>
+    virtual size_t size_inputs() const override;
+
+    /// <summary>
+    /// Provides the number of outputs, including the bias node
+    /// </summary>
+    /// <returns>the number of outputs</returns>
+    virtual size_t size_outputs() const override;
+
+    /// <summary>
+    /// Provides the number of links in the source network
+    /// </summary>
+    /// <returns>the parameter count</returns>
+    virtual size_t parameter_count() const override;
+
+    /// <summary>
+    /// Provides the gain of each link in the source network, in link order
+    /// </summary>
+    /// <returns>the link gains</returns>
+    virtual std::vector<double> get_parameters() const override;
+
+    /// <summary>
+    /// Sets the gain of each link in the source network, in link order,
+    /// and updates the compiled weights
+    /// </summary>
+    /// <param name="values">a pointer to parameter_count() gains to set</param>
+    virtual void set_parameters(const double* values) override;
+
+    /// <summary>
+    /// Provides the configuration of the source network
+    /// </summary>
+    /// <returns>string configuration representation</returns>
+    virtual std::string get_config() const override;
+
+    /// <summary>
+    /// Provides how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <returns>the output head</returns>
+    virtual OutputHead get_output_head() const override;
+
+    /// <summary>
+    /// Sets how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <param name="head">the output head to set</param>
+    virtual void set_output_head(const OutputHead head) override;
+
+    /// <summary>
+    /// Creates a copy of the current network
+    /// </summary>
+    /// <returns>a new network with the same weights</returns>
+    virtual std::unique_ptr<NeuralModel> clone() const override;
+
+private:
+    /// <summary>
+    /// Defines the compiled weights feeding a layer
+    /// </summary>
+    struct CompiledLayer
+    {
+        /// <summary>
+        /// The number of non-bias nodes in the layer
+        /// </summary>
+        size_t rows = 0;
+
+        /// <summary>
+        /// The number of nodes in the previous layer, including the bias
+        /// </summary>
+        size_t cols = 0;
+
+        /// <summary>
+        /// The row-major rows x cols weight matrix
+        /// </summary>
+        std::vector<double> weights;
+
+        /// <summary>
+        /// The start index of each row in the sparse values, followed by the total count
+        /// </summary>
+        std::vector<size_t> row_starts;
+
+        /// <summary>
+        /// The column index of each sparse value
+        /// </summary>
+        std::vector<size_t> sparse_cols;
+
+        /// <summary>
+        /// The sparse weight values, for the links present in the source network
+        /// </summary>
+        std::vector<double> sparse_values;
+    };
+
+    /// <summary>
+    /// Provides the offset of the given layer in the node value vector
+    /// </summary>
+    /// <param name="layer_index">the layer index</param>
+    /// <returns>the index of the first node value in the layer</returns>
+    size_t layer_offset(const size_t layer_index) const;
+
+    /// <summary>
+    /// Updates the compiled weights from the source network gains
+    /// </summary>
+    void update_weights();
+
+private:
+    /// <summary>
+    /// The source network, used to provide the parameters and configuration
+    /// </summary>
+    NeuralNetwork source;
+
+    /// <summary>
+    /// The storage used for the single-input step
+    /// </summary>
+    Storage storage;
+
+    /// <summary>
+    /// The number of non-bias nodes in each layer
+    /// </summary>
+    std::vector<size_t> layer_sizes;
+
+    /// <summary>
+    /// The compiled weights feeding each layer after the input layer
+    /// </summary>
+    std::vector<CompiledLayer> compiled_layers;
+
+    /// <summary>
+    /// The node values for each layer, each followed by a bias value of one
+    /// </summary>
+    std::vector<double> node_values;
+
+    /// <summary>
+    /// The node values for each layer in a batched step, with each layer stored as a
+    /// row-major batch_size x (layer size + 1) block
+    /// </summary>
+    std::vector<double> batch_values;
+};
+
+#endif
@@ -0,0 +1,367 @@
+#include "neural/graph_net.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+GraphNetwork::GraphNetwork(
+    const size_t num_inputs,
+    const size_t num_outputs,
+    const std::vector<Link>& links) :
+    num_inputs(num_inputs),
+    num_outputs(num_outputs),
+    links(links)
+{
+    // Check for valid inputs
+    if (num_inputs == 0 || num_outputs == 0)
+    {
+        throw std::invalid_argument("graph network must have at least one input and output");
+    }
+
+    // Compact the hidden node IDs to follow the fixed nodes
+    const size_t num_fixed = num_inputs + 1 + num_outputs;
+
+    std::vector<size_t> hidden_ids;
+    for (const Link& link : links)
+    {
+        if (link.from_node_id >= num_fixed)
+        {
+            hidden_ids.push_back(link.from_node_id);
+        }
+
+        if (link.to_node_id >= num_fixed)
+        {
+            hidden_ids.push_back(link.to_node_id);
+        }
+    }
+
+    std::sort(hidden_ids.begin(), hidden_ids.end());
+    hidden_ids.erase(std::unique(hidden_ids.begin(), hidden_ids.end()), hidden_ids.end());
+
+    for (Link& link : this->links)
+    {
+        if (link.to_node_id <= num_inputs)
+        {
+            throw std::invalid_argument("graph network links must not go into an input or the bias node");
+        }
+        else if (link.from_node_id > num_inputs && link.from_node_id < num_fixed)
+        {
+            throw std::invalid_argument("graph network links must not come from an output");
+        }
+
+        for (size_t* id : { &link.from_node_id, &link.to_node_id })
+        {
+            if (*id >= num_fixed)
+            {
+                *id = num_fixed + static_cast<size_t>(std::lower_bound(hidden_ids.begin(), hidden_ids.end(), *id) - hidden_ids.begin());
+            }
+        }
+    }
+
+    const size_t num_nodes = num_fixed + hidden_ids.size();
+
+    // Define the outgoing links of each node
+    std::vector<size_t> out_starts(num_nodes + 1, 0);
+    std::vector<size_t> in_degree(num_nodes, 0);
+
+    for (const Link& link : this->links)
+    {
+        out_starts[link.from_node_id + 1] += 1;
+        in_degree[link.to_node_id] += 1;
+    }
+
+    for (size_t i = 0; i < num_nodes; ++i)
+    {
+        out_starts[i + 1] += out_starts[i];
+    }
+
+    std::vector<size_t> out_links(this->links.size(), 0);
+    {
+        std::vector<size_t> cursor(out_starts.begin(), out_starts.end() - 1);
+        for (size_t i = 0; i < this->links.size(); ++i)
+        {
+            out_links[cursor[this->links[i].from_node_id]++] = i;
+        }
+    }
+
+    // Order the nodes so that each node follows the nodes it reads from, computing
+    // every node other than the inputs and the bias node
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < num_nodes; ++i)
+    {
+        if (in_degree[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    size_t num_visited = 0;
+    while (!ready.empty())
+    {
+        const size_t node = ready.back();
+        ready.pop_back();
+        num_visited += 1;
+
+        if (node > num_inputs)
+        {
+            plan_nodes.push_back(node);
+        }
+
+        for (size_t j = out_starts[node]; j < out_starts[node + 1]; ++j)
+        {
+            const size_t to_node = this->links[out_links[j]].to_node_id;
+            in_degree[to_node] -= 1;
+
+            if (in_degree[to_node] == 0)
+            {
+                ready.push_back(to_node);
+            }
+        }
+    }
+
+    if (num_visited != num_nodes)
+    {
+        throw std::invalid_argument("graph network links must not form a cycle");
+    }
+
+    // Store the links into each node contiguously, in plan order
+    std::vector<size_t> plan_index(num_nodes, 0);
+    for (size_t k = 0; k < plan_nodes.size(); ++k)
+    {
+        plan_index[plan_nodes[k]] = k;
+    }
+
+    plan_starts.assign(plan_nodes.size() + 1, 0);
+    for (const Link& link : this->links)
+    {
+        plan_starts[plan_index[link.to_node_id] + 1] += 1;
+    }
+
+    for (size_t k = 0; k < plan_nodes.size(); ++k)
+    {
+        plan_starts[k + 1] += plan_starts[k];
+    }
+
+    plan_sources.assign(this->links.size(), 0);
+    plan_gains.assign(this->links.size(), 0.0);
+    plan_slots.assign(this->links.size(), 0);
+
+    std::vector<size_t> cursor(plan_starts.begin(), plan_starts.end() - 1);
+    for (size_t i = 0; i < this->links.size(); ++i)
+    {
+        const size_t slot = cursor[plan_index[this->links[i].to_node_id]]++;
+        plan_sources[slot] = this->links[i].from_node_id;
+        plan_gains[slot] = this->links[i].gain;
+        plan_slots[i] = slot;
+    }
+
+    // Define the node values with the bias value
+    node_values.assign(num_nodes, 0.0);
+    node_values[num_inputs] = 1.0;
+}
+
+bool GraphNetwork::step_network()
+{
+    for (size_t k = 0; k < plan_nodes.size(); ++k)
+    {
+        double sum = 0.0;
+        for (size_t j = plan_starts[k]; j < plan_starts[k + 1]; ++j)
+        {
+            sum += plan_gains[j] * node_values[plan_sources[j]];
+        }
+        node_values[plan_nodes[k]] = sum;
+    }
+
+    return true;
+}
+
+bool GraphNetwork::set_input(
+    const size_t index,
+    const double value)
+{
+    if (index < num_inputs)
+    {
+        node_values[index] = value;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool GraphNetwork::get_output(
+    const size_t index,
+    double& output) const
+{
+    if (index < num_outputs)
+    {
+        output = node_values[num_inputs + 1 + index];
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+size_t GraphNetwork::size_inputs() const
+{
+    return num_inputs + 1;
+}
+
+size_t GraphNetwork::size_outputs() const
+{
+    return num_outputs + 1;
+}
+
+size_t GraphNetwork::parameter_count() const
+{
+    return links.size();
+}
+
+std::vector<double> GraphNetwork::get_parameters() const
+{
+    std::vector<double> values(links.size(), 0.0);
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+        values[i] = links[i].gain;
+    }
+    return values;
+}
+
+void GraphNetwork::set_parameters(const double* values)
+{
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+        links[i].gain = values[i];
+        plan_gains[plan_slots[i]] = values[i];
+    }
+}
+
+std::string GraphNetwork::get_config() const
+{
+    const size_t num_nodes = node_values.size();
+    const size_t first_output = num_inputs + 1;
+    const size_t first_hidden = first_output + num_outputs;
+
+    // Place each hidden node one layer after the deepest node it reads from, following
+    // the plan order so that the sources are placed first
+    std::vector<size_t> depths(num_nodes, 0);
+    size_t output_depth = 1;
+
+    for (size_t k = 0; k < plan_nodes.size(); ++k)
+    {
+        const size_t node = plan_nodes[k];
+
+        size_t depth = 1;
+        for (size_t j = plan_starts[k]; j < plan_starts[k + 1]; ++j)
+        {
+            depth = std::max(depth, depths[plan_sources[j]] + 1);
+        }
+
+        depths[node] = depth;
+
+        if (node >= first_hidden)
+        {
+            output_depth = std::max(output_depth, depth + 1);
+        }
+    }
+
+    for (size_t i = first_output; i < first_hidden; ++i)
+    {
+        depths[i] = output_depth;
+    }
+
+    // Define the nodes of each layer, with an extra bias node in the output layer so
+    // that the output count matches a layered network
+    const size_t output_bias = num_nodes;
+    std::vector<std::vector<size_t>> layer_nodes(output_depth + 1);
+
+    for (size_t i = 0; i < num_nodes; ++i)
+    {
+        layer_nodes[depths[i]].push_back(i);
+    }
+
+    layer_nodes.back().push_back(output_bias);
+
+    // Define the links of each layer, adding a zero-gain link from the bias node to
+    // any layer without links, which the configuration format requires
+    std::vector<Link> config_links = links;
+    std::vector<std::vector<size_t>> layer_links(layer_nodes.size());
+
+    for (size_t i = 0; i < config_links.size(); ++i)
+    {
+        layer_links[depths[config_links[i].to_node_id]].push_back(i);
+    }
+
+    for (size_t l = 1; l < layer_links.size(); ++l)
+    {
+        if (layer_links[l].empty())
+        {
+            layer_links[l].push_back(config_links.size());
+            config_links.push_back(Link{ num_inputs, layer_nodes[l].front(), 0.0 });
+        }
+    }
+
+    // Write the nodes and links
+    std::ostringstream output;
+
+    output << num_nodes + 1 << std::endl;
+    for (size_t i = 0; i <= num_nodes; ++i)
+    {
+        output << ((i == num_inputs || i == output_bias) ? 1 : 0) << std::endl;
+    }
+
+    output << config_links.size() << std::endl;
+    for (const Link& link : config_links)
+    {
+        output << link.from_node_id << ">" << link.to_node_id << "=" << link.gain << std::endl;
+    }
+
+    // Write the layers
+    output << layer_nodes.size() << std::endl;
+    for (size_t l = 0; l < layer_nodes.size(); ++l)
+    {
+        output << layer_nodes[l].size() << std::endl;
+        for (const size_t node : layer_nodes[l])
+        {
+            output << node << std::endl;
+        }
+
+        output << layer_links[l].size() << std::endl;
+        for (const size_t link : layer_links[l])
+        {
+            output << link << std::endl;
+        }
+    }
+
+    if (output_head == OutputHead::CONTINUOUS)
+    {
+        output << "head=continuous" << std::endl;
+    }
+
+    output << 8080 << std::endl;
+
+    return output.str();
+}
+
+NeuralModel::OutputHead GraphNetwork::get_output_head() const
+{
+    return output_head;
+}
+
+void GraphNetwork::set_output_head(const OutputHead head)
+{
+    output_head = head;
+}
+
+std::unique_ptr<NeuralModel> GraphNetwork::clone() const
+{
+    return std::make_unique<GraphNetwork>(*this);
+}
+
+size_t GraphNetwork::hidden_count() const
+{
+    return node_values.size() - (num_inputs + 1 + num_outputs);
+}
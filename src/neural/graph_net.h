@@ -0,0 +1,191 @@
+#ifndef __IO_NEURAL_GRAPH_NET__
+#define __IO_NEURAL_GRAPH_NET__
+
+#include <vector>
+
+#include "neural/model.h"
+
+/// <summary>
+/// Defines a feed-forward network with an arbitrary link graph, such as a network
+/// evolved by NEAT, compiled once into a flat execution plan. The nodes computed by
+/// the network are ordered so that each node follows the nodes it reads from, and the
+/// links into each node are stored contiguously, so that each step is a single pass
+/// over flat arrays regardless of the topology.
+///
+/// Nodes are numbered with the inputs first, followed by the bias node and then the
+/// outputs, and any larger node ID is a hidden node. Hidden node IDs need not be
+/// contiguous, and are compacted when compiled
+/// </summary>
+class GraphNetwork : public NeuralModel
+{
+public:
+    /// <summary>
+    /// Defines a link of the graph
+    /// </summary>
+    struct Link
+    {
+        /// <summary>
+        /// The node the link comes from
+        /// </summary>
+        size_t from_node_id;
+
+        /// <summary>
+        /// The node the link goes to
+        /// </summary>
+        size_t to_node_id;
+
+        /// <summary>
+        /// The gain of the link
+        /// </summary>
+        double gain;
+    };
+
+public:
+    /// <summary>
+    /// Compiles the network for the given links. Will throw an std::invalid_argument if
+    /// a link goes into an input or the bias node, comes from an output, or if the
+    /// links form a cycle
+    /// </summary>
+    /// <param name="num_inputs">the number of non-bias inputs</param>
+    /// <param name="num_outputs">the number of non-bias outputs</param>
+    /// <param name="links">the links of the graph</param>
+    GraphNetwork(
+        const size_t num_inputs,
+        const size_t num_outputs,
+        const std::vector<Link>& links);
+
+    /// <summary>
+    /// Steps the network to calculate the new outputs from the given inputs
+    /// </summary>
+    /// <returns>true if successful</returns>
+    virtual bool step_network() override;
+
+    /// <summary>
+    /// Sets the given input to a provided value
+    /// </summary>
+    /// <param name="index">the input index to set</param>
+    /// <param name="value">the value to set</param>
+    /// <returns>true if successful</returns>
+    virtual bool set_input(
+        const size_t index,
+        const double value) override;
+
+    /// <summary>
+    /// Obtains the given output for a value
+    /// </summary>
+    /// <param name="index">the output index to get</param>
+    /// <param name="output">the output parameter to use</param>
+    /// <returns>true if successful</returns>
+    virtual bool get_output(
+        const size_t index,
+        double& output) const override;
+
+    /// <summary>
+    /// Provides the number of inputs, including the bias node
+    /// </summary>
+    /// <returns>the number of inputs</returns>
+    virtual size_t size_inputs() const override;
+
+    /// <summary>
+    /// Provides the number of outputs, including a bias node, as for a layered network
+    /// </summary>
+    /// <returns>the number of outputs</returns>
+    virtual size_t size_outputs() const override;
+
+    /// <summary>
+    /// Provides the number of links
+    /// </summary>
+    /// <returns>the parameter count</returns>
+    virtual size_t parameter_count() const override;
+
+    /// <summary>
+    /// Provides the gain of each link, in the order the links were provided
+    /// </summary>
+    /// <returns>the link gains</returns>
+    virtual std::vector<double> get_parameters() const override;
+
+    /// <summary>
+    /// Sets the gain of each link, in the order the links were provided,
+    /// and updates the compiled gains
+    /// </summary>
+    /// <param name="values">a pointer to parameter_count() gains to set</param>
+    virtual void set_parameters(const double* values) override;
+
+    /// <summary>
+    /// Provides the configuration of the network in the format read by
+    /// NeuralNetwork::from_config, with each hidden node placed in the layer after
+    /// the deepest node it reads from, and the outputs in the last layer. Layers
+    /// without links are given a zero-gain link from the input bias node
+    /// </summary>
+    /// <returns>string configuration representation</returns>
+    virtual std::string get_config() const override;
+
+    /// <summary>
+    /// Provides how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <returns>the output head</returns>
+    virtual OutputHead get_output_head() const override;
+
+    /// <summary>
+    /// Sets how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <param name="head">the output head to set</param>
+    virtual void set_output_head(const OutputHead head) override;
+
+    /// <summary>
+    /// Creates a copy of the current network
+    /// </summary>
+    /// <returns>a new network with the same plan and gains</returns>
+    virtual std::unique_ptr<NeuralModel> clone() const override;
+
+    /// <summary>
+    /// Provides the number of hidden nodes
+    /// </summary>
+    /// <returns>the hidden node count</returns>
+    size_t hidden_count() const;
+
+private:
+    /// <summary>
+    /// The number of non-bias inputs and outputs
+    /// </summary>
+    size_t num_inputs;
+    size_t num_outputs;
+
+    /// <summary>
+    /// The links of the graph, with node IDs compacted
+    /// </summary>
+    std::vector<Link> links;
+
+    /// <summary>
+    /// The compacted nodes computed each step, with each node after those it reads from
+    /// </summary>
+    std::vector<size_t> plan_nodes;
+
+    /// <summary>
+    /// The start index of the links into each plan node, followed by the total count
+    /// </summary>
+    std::vector<size_t> plan_starts;
+
+    /// <summary>
+    /// The source node and gain of each link in plan order
+    /// </summary>
+    std::vector<size_t> plan_sources;
+    std::vector<double> plan_gains;
+
+    /// <summary>
+    /// The position in the plan of each link, in the order the links were provided
+    /// </summary>
+    std::vector<size_t> plan_slots;
+
+    /// <summary>
+    /// The value of each compacted node, with the bias value of one
+    /// </summary>
+    std::vector<double> node_values;
+
+    /// <summary>
+    /// How the outputs of the network are interpreted as control inputs
+    /// </summary>
+    OutputHead output_head = OutputHead::VOTING;
+};
+
+#endif
@@ -0,0 +1,414 @@
+#include "neural/low_rank_net.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+// Computes the truncated singular value decomposition of the row-major matrix A
+// by one-sided Jacobi rotations, providing A ~= U * V with U as a rows x rank
+// matrix that includes the singular values, and V as a rank x cols matrix
+static void truncated_svd(
+    const std::vector<double>& a,
+    const size_t rows,
+    const size_t cols,
+    const size_t rank,
+    std::vector<double>& u,
+    std::vector<double>& v)
+{
+    // Define the working matrix, stored column-major to rotate columns, and the
+    // accumulated right rotation matrix
+    std::vector<double> w(rows * cols, 0.0);
+    std::vector<double> rot(cols * cols, 0.0);
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        for (size_t j = 0; j < cols; ++j)
+        {
+            w[j * rows + i] = a[i * cols + j];
+        }
+    }
+
+    for (size_t j = 0; j < cols; ++j)
+    {
+        rot[j * cols + j] = 1.0;
+    }
+
+    // Orthogonalize each pair of columns until no further rotation is needed
+    const size_t max_sweeps = 60;
+    const double tolerance = 1e-12;
+
+    for (size_t sweep = 0; sweep < max_sweeps; ++sweep)
+    {
+        bool rotated = false;
+
+        for (size_t p = 0; p + 1 < cols; ++p)
+        {
+            for (size_t q = p + 1; q < cols; ++q)
+            {
+                double* wp = &w[p * rows];
+                double* wq = &w[q * rows];
+
+                double alpha = 0.0;
+                double beta = 0.0;
+                double gamma = 0.0;
+
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    alpha += wp[i] * wp[i];
+                    beta += wq[i] * wq[i];
+                    gamma += wp[i] * wq[i];
+                }
+
+                if (std::abs(gamma) <= tolerance * std::sqrt(alpha * beta) || gamma == 0.0)
+                {
+                    continue;
+                }
+
+                rotated = true;
+
+                // Determine the Jacobi rotation to zero the column inner product
+                const double zeta = (beta - alpha) / (2.0 * gamma);
+                const double t = ((zeta >= 0.0) ? 1.0 : -1.0) / (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+                const double c = 1.0 / std::sqrt(1.0 + t * t);
+                const double s = c * t;
+
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    const double xp = wp[i];
+                    const double xq = wq[i];
+                    wp[i] = c * xp - s * xq;
+                    wq[i] = s * xp + c * xq;
+                }
+
+                double* rp = &rot[p * cols];
+                double* rq = &rot[q * cols];
+
+                for (size_t i = 0; i < cols; ++i)
+                {
+                    const double xp = rp[i];
+                    const double xq = rq[i];
+                    rp[i] = c * xp - s * xq;
+                    rq[i] = s * xp + c * xq;
+                }
+            }
+        }
+
+        if (!rotated)
+        {
+            break;
+        }
+    }
+
+    // Order the columns by their norm, which are the singular values
+    std::vector<double> norms(cols, 0.0);
+    for (size_t j = 0; j < cols; ++j)
+    {
+        for (size_t i = 0; i < rows; ++i)
+        {
+            norms[j] += w[j * rows + i] * w[j * rows + i];
+        }
+    }
+
+    std::vector<size_t> order(cols, 0);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&norms](const size_t i1, const size_t i2)
+    {
+        return norms[i1] > norms[i2];
+    });
+
+    // The rotated columns hold U * S and the rotation columns hold V
+    u.assign(rows * rank, 0.0);
+    v.assign(rank * cols, 0.0);
+
+    for (size_t k = 0; k < rank && k < cols; ++k)
+    {
+        const size_t j = order[k];
+        for (size_t i = 0; i < rows; ++i)
+        {
+            u[i * rank + k] = w[j * rows + i];
+        }
+        for (size_t i = 0; i < cols; ++i)
+        {
+            v[k * cols + i] = rot[j * cols + i];
+        }
+    }
+}
+
+LowRankNetwork LowRankNetwork::from_layers(
+    const std::vector<size_t>& layers,
+    const size_t rank)
+{
+    // Ensure that layers were added
+    if (layers.size() == 0)
+    {
+        throw std::invalid_argument("layers vector must have at least one layer");
+    }
+    else if (rank == 0)
+    {
+        throw std::invalid_argument("rank must be at least one");
+    }
+
+    // Check that size values are provided
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        if (layers[i] == 0)
+        {
+            std::ostringstream ss;
+            ss << "layer " << static_cast<int>(i) << " must have at least one node";
+            throw std::invalid_argument(ss.str());
+        }
+    }
+
+    // Create the net
+    LowRankNetwork net;
+    net.init_layers(layers, rank);
+    return net;
+}
+
+LowRankNetwork LowRankNetwork::from_network(
+    const NeuralNetwork& net,
+    const size_t rank)
+{
+    // Create the zeroed network with the same layer sizes
+    LowRankNetwork low_rank = from_layers(net.get_layer_sizes(), rank);
+
+    // Factorize each layer's weights
+    for (size_t i = 0; i < low_rank.factors.size(); ++i)
+    {
+        Factor& f = low_rank.factors[i];
+
+        std::vector<double> weights;
+        if (!net.get_layer_weights(i + 1, weights))
+        {
+            std::ostringstream ss;
+            ss << "layer " << static_cast<int>(i + 1) << " has links from outside the previous layer";
+            throw std::invalid_argument(ss.str());
+        }
+
+        truncated_svd(weights, f.rows, f.cols, f.rank, f.u, f.v);
+    }
+
+    low_rank.output_head = net.get_output_head();
+    return low_rank;
+}
+
+void LowRankNetwork::init_layers(
+    const std::vector<size_t>& layers,
+    const size_t rank)
+{
+    layer_sizes = layers;
+    factors.clear();
+
+    size_t max_rank = 0;
+
+    for (size_t i = 1; i < layers.size(); ++i)
+    {
+        Factor f;
+        f.rows = layers[i];
+        f.cols = layers[i - 1] + 1;
+        f.rank = std::min(rank, std::min(f.rows, f.cols));
+        f.u.assign(f.rows * f.rank, 0.0);
+        f.v.assign(f.rank * f.cols, 0.0);
+        factors.push_back(f);
+
+        max_rank = std::max(max_rank, f.rank);
+    }
+
+    // Define the node values with a bias value after each layer
+    node_values.assign(layer_offset(layers.size()), 0.0);
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        node_values[layer_offset(i) + layers[i]] = 1.0;
+    }
+
+    rank_values.assign(max_rank, 0.0);
+}
+
+size_t LowRankNetwork::layer_offset(const size_t layer_index) const
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < layer_index; ++i)
+    {
+        offset += layer_sizes[i] + 1;
+    }
+    return offset;
+}
+
+NeuralNetwork LowRankNetwork::to_network() const
+{
+    NeuralNetwork net = NeuralNetwork::from_layers(layer_sizes);
+    net.set_output_head(output_head);
+
+    for (size_t i = 0; i < factors.size(); ++i)
+    {
+        const Factor& f = factors[i];
+
+        // Multiply the factors to obtain the full weight matrix
+        std::vector<double> weights(f.rows * f.cols, 0.0);
+        for (size_t r = 0; r < f.rows; ++r)
+        {
+            for (size_t k = 0; k < f.rank; ++k)
+            {
+                const double uval = f.u[r * f.rank + k];
+                for (size_t c = 0; c < f.cols; ++c)
+                {
+                    weights[r * f.cols + c] += uval * f.v[k * f.cols + c];
+                }
+            }
+        }
+
+        net.set_layer_weights(i + 1, weights);
+    }
+
+    return net;
+}
+
+size_t LowRankNetwork::get_rank() const
+{
+    return rank_values.size();
+}
+
+bool LowRankNetwork::step_network()
+{
+    // Return false if the layer size is less than two
+    //   for no layers, or input layer is also output layer
+    if (layer_sizes.size() < 2)
+    {
+        return false;
+    }
+
+    size_t in_offset = 0;
+
+    for (size_t i = 0; i < factors.size(); ++i)
+    {
+        const Factor& f = factors[i];
+        const double* in_vals = &node_values[in_offset];
+        double* out_vals = &node_values[in_offset + f.cols];
+
+        // Project the inputs onto the rank-sized space
+        for (size_t k = 0; k < f.rank; ++k)
+        {
+            const double* vrow = &f.v[k * f.cols];
+            double sum = 0.0;
+            for (size_t c = 0; c < f.cols; ++c)
+            {
+                sum += vrow[c] * in_vals[c];
+            }
+            rank_values[k] = sum;
+        }
+
+        // Expand the rank-sized values into the layer outputs
+        for (size_t r = 0; r < f.rows; ++r)
+        {
+            const double* urow = &f.u[r * f.rank];
+            double sum = 0.0;
+            for (size_t k = 0; k < f.rank; ++k)
+            {
+                sum += urow[k] * rank_values[k];
+            }
+            out_vals[r] = sum;
+        }
+
+        in_offset += f.cols;
+    }
+
+    return true;
+}
+
+bool LowRankNetwork::set_input(
+    const size_t index,
+    const double value)
+{
+    if (layer_sizes.size() > 0 && index < layer_sizes.front())
+    {
+        node_values[index] = value;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool LowRankNetwork::get_output(
+    const size_t index,
+    double& output) const
+{
+    if (layer_sizes.size() > 0 && index < layer_sizes.back())
+    {
+        output = node_values[layer_offset(layer_sizes.size() - 1) + index];
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+size_t LowRankNetwork::size_inputs() const
+{
+    return (layer_sizes.size() > 0) ? layer_sizes.front() + 1 : 0;
+}
+
+size_t LowRankNetwork::size_outputs() const
+{
+    return (layer_sizes.size() > 0) ? layer_sizes.back() + 1 : 0;
+}
+
+size_t LowRankNetwork::parameter_count() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < factors.size(); ++i)
+    {
+        count += factors[i].u.size() + factors[i].v.size();
+    }
+    return count;
+}
+
+std::vector<double> LowRankNetwork::get_parameters() const
+{
+    std::vector<double> values;
+    values.reserve(parameter_count());
+
+    for (size_t i = 0; i < factors.size(); ++i)
+    {
+        values.insert(values.end(), factors[i].u.begin(), factors[i].u.end());
+        values.insert(values.end(), factors[i].v.begin(), factors[i].v.end());
+    }
+
+    return values;
+}
+
+void LowRankNetwork::set_parameters(const double* values)
+{
+    for (size_t i = 0; i < factors.size(); ++i)
+    {
+        Factor& f = factors[i];
+        std::copy(values, values + f.u.size(), f.u.begin());
+        values += f.u.size();
+        std::copy(values, values + f.v.size(), f.v.begin());
+        values += f.v.size();
+    }
+}
+
+std::string LowRankNetwork::get_config() const
+{
+    return to_network().get_config();
+}
+
+NeuralModel::OutputHead LowRankNetwork::get_output_head() const
+{
+    return output_head;
+}
+
+void LowRankNetwork::set_output_head(const OutputHead head)
+{
+    output_head = head;
+}
+
+std::unique_ptr<NeuralModel> LowRankNetwork::clone() const
+{
+    return std::make_unique<LowRankNetwork>(*this);
+}
@@ -0,0 +1,211 @@
+#ifndef __IO_NEURAL_LOW_RANK_NET__
+#define __IO_NEURAL_LOW_RANK_NET__
+
+#include <vector>
+
+#include "neural/model.h"
+#include "neural/net.h"
+
+/// <summary>
+/// Defines a fully-connected network where the weight matrix feeding each layer
+/// is stored as the product of two thin matrices, U * V, so that both the step
+/// cost and the parameter count scale with the rank instead of the layer width
+/// </summary>
+class LowRankNetwork : public NeuralModel
+{
+public:
+    /// <summary>
+    /// Creates a LowRankNetwork with all factors set to zero.
+    /// Will throw an std::invalid_argument for an invalid (empty,
+    /// zero layer size or zero rank) input
+    /// </summary>
+    /// <param name="layers">a vector of layers, with each size_t containing the
+    /// number of nodes to put in that layer, not including the bias node</param>
+    /// <param name="rank">the maximum rank of each layer's weight matrix</param>
+    /// <returns>LowRankNetwork</returns>
+    static LowRankNetwork from_layers(
+        const std::vector<size_t>& layers,
+        const size_t rank);
+
+    /// <summary>
+    /// Creates a LowRankNetwork from the truncated singular value decomposition
+    /// of each layer's weight matrix in the provided network.
+    /// Will throw an std::invalid_argument if the network is not layered
+    /// </summary>
+    /// <param name="net">the network to factorize</param>
+    /// <param name="rank">the maximum rank of each layer's weight matrix</param>
+    /// <returns>LowRankNetwork</returns>
+    static LowRankNetwork from_network(
+        const NeuralNetwork& net,
+        const size_t rank);
+
+public:
+    /// <summary>
+    /// Expands the factors into a full NeuralNetwork with the same layer sizes
+    /// </summary>
+    /// <returns>the equivalent full network</returns>
+    NeuralNetwork to_network() const;
+
+    /// <summary>
+    /// Provides the largest rank used by any layer
+    /// </summary>
+    /// <returns>the rank of the network</returns>
+    size_t get_rank() const;
+
+    /// <summary>
+    /// Steps the network to calculate the new outputs from the given inputs
+    /// </summary>
+    /// <returns>true if successful</returns>
+    virtual bool step_network() override;
+
+    /// <summary>
+    /// Sets the given input to a provided value
+    /// </summary>
+    /// <param name="index">the input index to set</param>
+    /// <param name="value">the value to set</param>
+    /// <returns>true if successful</returns>
+    virtual bool set_input(
+        const size_t index,
+        const double value) override;
+
+    /// <summary>
+    /// Obtains the given output for a value
+    /// </summary>
+    /// <param name="index">the output index to get</param>
+    /// <param name="output">the output parameter to use</param>
+    /// <returns>true if successful</returns>
+    virtual bool get_output(
+        const size_t index,
+        double& output) const override;
+
+    /// <summary>
+    /// Provides the number of inputs, including the bias node
+    /// </summary>
+    /// <returns>the number of inputs</returns>
+    virtual size_t size_inputs() const override;
+
+    /// <summary>
+    /// Provides the number of outputs, including the bias node
+    /// </summary>
+    /// <returns>the number of outputs</returns>
+    virtual size_t size_outputs() const override;
+
+    /// <summary>
+    /// Provides the number of factor values in the network
+    /// </summary>
+    /// <returns>the parameter count</returns>
+    virtual size_t parameter_count() const override;
+
+    /// <summary>
+    /// Provides the factor values, with U followed by V for each layer
+    /// </summary>
+    /// <returns>the factor values</returns>
+    virtual std::vector<double> get_parameters() const override;
+
+    /// <summary>
+    /// Sets the factor values, with U followed by V for each layer
+    /// </summary>
+    /// <param name="values">a pointer to parameter_count() values to set</param>
+    virtual void set_parameters(const double* values) override;
+
+    /// <summary>
+    /// Provides the configuration of the expanded network
+    /// </summary>
+    /// <returns>string configuration representation</returns>
+    virtual std::string get_config() const override;
+
+    /// <summary>
+    /// Provides how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <returns>the output head</returns>
+    virtual OutputHead get_output_head() const override;
+
+    /// <summary>
+    /// Sets how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <param name="head">the output head to set</param>
+    virtual void set_output_head(const OutputHead head) override;
+
+    /// <summary>
+    /// Creates a copy of the current network
+    /// </summary>
+    /// <returns>a new network with the same factors</returns>
+    virtual std::unique_ptr<NeuralModel> clone() const override;
+
+private:
+    /// <summary>
+    /// Defines the factorization of the weight matrix feeding a layer
+    /// </summary>
+    struct Factor
+    {
+        /// <summary>
+        /// The number of non-bias nodes in the layer
+        /// </summary>
+        size_t rows = 0;
+
+        /// <summary>
+        /// The number of nodes in the previous layer, including the bias
+        /// </summary>
+        size_t cols = 0;
+
+        /// <summary>
+        /// The rank of the factorization
+        /// </summary>
+        size_t rank = 0;
+
+        /// <summary>
+        /// The row-major rows x rank left factor
+        /// </summary>
+        std::vector<double> u;
+
+        /// <summary>
+        /// The row-major rank x cols right factor
+        /// </summary>
+        std::vector<double> v;
+    };
+
+    /// <summary>
+    /// Initializes the layer sizes and zeroed factors, capping the rank of each
+    /// layer at the smaller dimension of its weight matrix
+    /// </summary>
+    /// <param name="layers">the non-bias node count in each layer</param>
+    /// <param name="rank">the maximum rank of each layer</param>
+    void init_layers(
+        const std::vector<size_t>& layers,
+        const size_t rank);
+
+    /// <summary>
+    /// Provides the offset of the given layer in the node value vector
+    /// </summary>
+    /// <param name="layer_index">the layer index</param>
+    /// <returns>the index of the first node value in the layer</returns>
+    size_t layer_offset(const size_t layer_index) const;
+
+private:
+    /// <summary>
+    /// The number of non-bias nodes in each layer
+    /// </summary>
+    std::vector<size_t> layer_sizes;
+
+    /// <summary>
+    /// The factors feeding each layer after the input layer
+    /// </summary>
+    std::vector<Factor> factors;
+
+    /// <summary>
+    /// The node values for each layer, each followed by a bias value of one
+    /// </summary>
+    std::vector<double> node_values;
+
+    /// <summary>
+    /// Intermediate storage for the rank-sized product of V and the layer inputs
+    /// </summary>
+    std::vector<double> rank_values;
+
+    /// <summary>
+    /// How the outputs of the network are interpreted as control inputs
+    /// </summary>
+    OutputHead output_head = OutputHead::VOTING;
+};
+
+#endif
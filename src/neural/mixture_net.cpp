@@ -0,0 +1,307 @@
+#include "neural/mixture_net.h"
+
+#include <sstream>
+#include <stdexcept>
+
+// Defines the first line of a mixture configuration
+static const std::string mixture_header = "mixture";
+
+// Writes the given network configuration, preceded by its line count
+static void write_sub_config(
+    std::ostream& output,
+    const std::string& config)
+{
+    size_t num_lines = 0;
+    for (size_t i = 0; i < config.size(); ++i)
+    {
+        if (config[i] == '\n')
+        {
+            num_lines += 1;
+        }
+    }
+
+    output << num_lines << std::endl << config;
+}
+
+// Reads a network configuration written by write_sub_config
+static NeuralNetwork read_sub_config(std::istream& input)
+{
+    std::string line;
+    size_t num_lines = 0;
+
+    if (!std::getline(input, line))
+    {
+        throw std::invalid_argument("unable to read mixture network line count");
+    }
+
+    try
+    {
+        num_lines = std::stoul(line);
+    }
+    catch (const std::logic_error&)
+    {
+        throw std::invalid_argument("invalid mixture network line count " + line);
+    }
+
+    std::ostringstream config;
+    for (size_t i = 0; i < num_lines; ++i)
+    {
+        if (!std::getline(input, line))
+        {
+            throw std::invalid_argument("mixture network configuration ended early");
+        }
+        config << line << std::endl;
+    }
+
+    return NeuralNetwork::from_config(config.str());
+}
+
+MixtureNetwork MixtureNetwork::from_layers(
+    const std::vector<size_t>& expert_layers,
+    const size_t num_experts)
+{
+    // Ensure that experts were requested
+    if (num_experts == 0)
+    {
+        throw std::invalid_argument("mixture must have at least one expert");
+    }
+    else if (expert_layers.size() == 0)
+    {
+        throw std::invalid_argument("layers vector must have at least one layer");
+    }
+
+    // Create the gate and experts
+    MixtureNetwork net;
+    net.gate = NeuralNetwork::from_layers({ expert_layers.front(), num_experts });
+
+    for (size_t i = 0; i < num_experts; ++i)
+    {
+        net.experts.push_back(NeuralNetwork::from_layers(expert_layers));
+    }
+
+    net.input_values.assign(expert_layers.front(), 0.0);
+
+    return net;
+}
+
+MixtureNetwork MixtureNetwork::from_config(const std::string& config)
+{
+    // Define the input reader
+    std::istringstream input(config);
+    std::string line;
+
+    // Check the header
+    if (!std::getline(input, line) || line != mixture_header)
+    {
+        throw std::invalid_argument("configuration does not start with the mixture header");
+    }
+
+    // Read the number of experts
+    size_t num_experts = 0;
+    if (!std::getline(input, line))
+    {
+        throw std::invalid_argument("unable to read mixture expert count");
+    }
+
+    try
+    {
+        num_experts = std::stoul(line);
+    }
+    catch (const std::logic_error&)
+    {
+        throw std::invalid_argument("invalid mixture expert count " + line);
+    }
+
+    // Read the gate and experts
+    MixtureNetwork net;
+    net.gate = read_sub_config(input);
+
+    for (size_t i = 0; i < num_experts; ++i)
+    {
+        net.experts.push_back(read_sub_config(input));
+    }
+
+    // Check the network sizes
+    if (net.experts.size() == 0)
+    {
+        throw std::invalid_argument("mixture must have at least one expert");
+    }
+    else if (net.gate.size_outputs() - 1 != net.experts.size())
+    {
+        throw std::invalid_argument("mixture gate must have one output for each expert");
+    }
+
+    for (size_t i = 0; i < net.experts.size(); ++i)
+    {
+        if (net.experts[i].size_inputs() != net.gate.size_inputs() ||
+            net.experts[i].size_outputs() != net.experts.front().size_outputs())
+        {
+            throw std::invalid_argument("mixture experts must have the same input and output sizes as the gate and each other");
+        }
+    }
+
+    // Check that the ending value is correct
+    if (!std::getline(input, line) || line != "8080")
+    {
+        throw std::invalid_argument("configuration end value is incorrect");
+    }
+
+    net.input_values.assign(net.gate.size_inputs() - 1, 0.0);
+
+    return net;
+}
+
+bool MixtureNetwork::is_mixture_config(const std::string& config)
+{
+    return config.compare(0, mixture_header.size() + 1, mixture_header + "\n") == 0;
+}
+
+size_t MixtureNetwork::get_expert_count() const
+{
+    return experts.size();
+}
+
+size_t MixtureNetwork::get_selected_expert() const
+{
+    return selected_expert;
+}
+
+bool MixtureNetwork::step_network()
+{
+    // Step the gate with the current inputs
+    for (size_t i = 0; i < input_values.size(); ++i)
+    {
+        gate.set_input(i, input_values[i]);
+    }
+
+    if (!gate.step_network())
+    {
+        return false;
+    }
+
+    // Select the expert with the largest gate output
+    double best_val = 0.0;
+    for (size_t i = 0; i < experts.size(); ++i)
+    {
+        double val = 0.0;
+        gate.get_output(i, val);
+
+        if (i == 0 || val > best_val)
+        {
+            best_val = val;
+            selected_expert = i;
+        }
+    }
+
+    // Step only the selected expert
+    NeuralNetwork& expert = experts[selected_expert];
+    for (size_t i = 0; i < input_values.size(); ++i)
+    {
+        expert.set_input(i, input_values[i]);
+    }
+
+    return expert.step_network();
+}
+
+bool MixtureNetwork::set_input(
+    const size_t index,
+    const double value)
+{
+    if (index < input_values.size())
+    {
+        input_values[index] = value;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool MixtureNetwork::get_output(
+    const size_t index,
+    double& output) const
+{
+    return experts[selected_expert].get_output(index, output);
+}
+
+size_t MixtureNetwork::size_inputs() const
+{
+    return gate.size_inputs();
+}
+
+size_t MixtureNetwork::size_outputs() const
+{
+    return experts.front().size_outputs();
+}
+
+size_t MixtureNetwork::parameter_count() const
+{
+    size_t count = gate.parameter_count();
+    for (size_t i = 0; i < experts.size(); ++i)
+    {
+        count += experts[i].parameter_count();
+    }
+    return count;
+}
+
+std::vector<double> MixtureNetwork::get_parameters() const
+{
+    std::vector<double> values = gate.get_parameters();
+
+    for (size_t i = 0; i < experts.size(); ++i)
+    {
+        const std::vector<double> expert_values = experts[i].get_parameters();
+        values.insert(values.end(), expert_values.begin(), expert_values.end());
+    }
+
+    return values;
+}
+
+void MixtureNetwork::set_parameters(const double* values)
+{
+    gate.set_parameters(values);
+    values += gate.parameter_count();
+
+    for (size_t i = 0; i < experts.size(); ++i)
+    {
+        experts[i].set_parameters(values);
+        values += experts[i].parameter_count();
+    }
+}
+
+std::string MixtureNetwork::get_config() const
+{
+    std::ostringstream output;
+
+    output << mixture_header << std::endl;
+    output << experts.size() << std::endl;
+
+    write_sub_config(output, gate.get_config());
+    for (size_t i = 0; i < experts.size(); ++i)
+    {
+        write_sub_config(output, experts[i].get_config());
+    }
+
+    output << 8080 << std::endl;
+
+    return output.str();
+}
+
+NeuralModel::OutputHead MixtureNetwork::get_output_head() const
+{
+    return experts.front().get_output_head();
+}
+
+void MixtureNetwork::set_output_head(const OutputHead head)
+{
+    for (size_t i = 0; i < experts.size(); ++i)
+    {
+        experts[i].set_output_head(head);
+    }
+}
+
+std::unique_ptr<NeuralModel> MixtureNetwork::clone() const
+{
+    return std::make_unique<MixtureNetwork>(*this);
+}
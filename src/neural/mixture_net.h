@@ -0,0 +1,163 @@
+#ifndef __IO_NEURAL_MIXTURE_NET__
+#define __IO_NEURAL_MIXTURE_NET__
+
+#include <string>
+#include <vector>
+
+#include "neural/model.h"
+#include "neural/net.h"
+
+/// <summary>
+/// Defines a mixture of expert networks with a gating network. Each step evaluates
+/// the gate, and then only the expert with the largest gate output, so that the
+/// step cost stays near that of a single expert as experts are added
+/// </summary>
+class MixtureNetwork : public NeuralModel
+{
+public:
+    /// <summary>
+    /// Creates a MixtureNetwork with all gains set to zero. The gate connects the expert
+    /// inputs directly to one output for each expert.
+    /// Will throw an std::invalid_argument for an invalid (empty, zero layer size
+    /// or zero expert count) input
+    /// </summary>
+    /// <param name="expert_layers">a vector of layers for each expert, with each size_t
+    /// containing the number of nodes to put in that layer, not including the bias node</param>
+    /// <param name="num_experts">the number of experts</param>
+    /// <returns>MixtureNetwork</returns>
+    static MixtureNetwork from_layers(
+        const std::vector<size_t>& expert_layers,
+        const size_t num_experts);
+
+    /// <summary>
+    /// Provides a mixture network from the given configuration string, as provided by get_config.
+    /// Will throw an std::invalid_argument if the network is unable to be created
+    /// </summary>
+    /// <param name="config">the configuration string</param>
+    /// <returns>the network associated with the given configuration</returns>
+    static MixtureNetwork from_config(const std::string& config);
+
+    /// <summary>
+    /// Determines whether the given configuration string is for a mixture network
+    /// </summary>
+    /// <param name="config">the configuration string</param>
+    /// <returns>true if the configuration starts with the mixture header</returns>
+    static bool is_mixture_config(const std::string& config);
+
+public:
+    /// <summary>
+    /// Provides the number of expert networks
+    /// </summary>
+    /// <returns>the expert count</returns>
+    size_t get_expert_count() const;
+
+    /// <summary>
+    /// Provides the index of the expert selected in the last step
+    /// </summary>
+    /// <returns>the selected expert index</returns>
+    size_t get_selected_expert() const;
+
+    /// <summary>
+    /// Steps the gate, and then the expert with the largest gate output
+    /// </summary>
+    /// <returns>true if successful</returns>
+    virtual bool step_network() override;
+
+    /// <summary>
+    /// Sets the given input to a provided value
+    /// </summary>
+    /// <param name="index">the input index to set</param>
+    /// <param name="value">the value to set</param>
+    /// <returns>true if successful</returns>
+    virtual bool set_input(
+        const size_t index,
+        const double value) override;
+
+    /// <summary>
+    /// Obtains the given output of the expert selected in the last step
+    /// </summary>
+    /// <param name="index">the output index to get</param>
+    /// <param name="output">the output parameter to use</param>
+    /// <returns>true if successful</returns>
+    virtual bool get_output(
+        const size_t index,
+        double& output) const override;
+
+    /// <summary>
+    /// Provides the number of inputs, including the bias node
+    /// </summary>
+    /// <returns>the number of inputs</returns>
+    virtual size_t size_inputs() const override;
+
+    /// <summary>
+    /// Provides the number of outputs, including the bias node
+    /// </summary>
+    /// <returns>the number of outputs</returns>
+    virtual size_t size_outputs() const override;
+
+    /// <summary>
+    /// Provides the number of link gains in the gate and experts
+    /// </summary>
+    /// <returns>the parameter count</returns>
+    virtual size_t parameter_count() const override;
+
+    /// <summary>
+    /// Provides the link gains of the gate, followed by those of each expert
+    /// </summary>
+    /// <returns>the link gains</returns>
+    virtual std::vector<double> get_parameters() const override;
+
+    /// <summary>
+    /// Sets the link gains of the gate, followed by those of each expert
+    /// </summary>
+    /// <param name="values">a pointer to parameter_count() gains to set</param>
+    virtual void set_parameters(const double* values) override;
+
+    /// <summary>
+    /// Provides the mixture configuration, containing the gate and expert
+    /// configurations after a mixture header
+    /// </summary>
+    /// <returns>string configuration representation</returns>
+    virtual std::string get_config() const override;
+
+    /// <summary>
+    /// Provides how the outputs of the experts are interpreted as control inputs
+    /// </summary>
+    /// <returns>the output head</returns>
+    virtual OutputHead get_output_head() const override;
+
+    /// <summary>
+    /// Sets how the outputs of the experts are interpreted as control inputs
+    /// </summary>
+    /// <param name="head">the output head to set</param>
+    virtual void set_output_head(const OutputHead head) override;
+
+    /// <summary>
+    /// Creates a copy of the current network
+    /// </summary>
+    /// <returns>a new network with the same gate and experts</returns>
+    virtual std::unique_ptr<NeuralModel> clone() const override;
+
+private:
+    /// <summary>
+    /// The gating network, with one output for each expert
+    /// </summary>
+    NeuralNetwork gate;
+
+    /// <summary>
+    /// The expert networks
+    /// </summary>
+    std::vector<NeuralNetwork> experts;
+
+    /// <summary>
+    /// The current input values, passed to the gate and selected expert on each step
+    /// </summary>
+    std::vector<double> input_values;
+
+    /// <summary>
+    /// The index of the expert selected in the last step
+    /// </summary>
+    size_t selected_expert = 0;
+};
+
+#endif
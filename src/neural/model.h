@@ -0,0 +1,114 @@
+#ifndef __IO_NEURAL_MODEL__
+#define __IO_NEURAL_MODEL__
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Defines the common interface for a network that may be stepped by the
+/// game state and have its parameters set by the optimization
+/// </summary>
+class NeuralModel
+{
+public:
+    /// <summary>
+    /// Provides options for how the outputs are interpreted as control inputs
+    /// </summary>
+    enum class OutputHead
+    {
+        VOTING = 0,
+        CONTINUOUS = 1
+    };
+
+public:
+    /// <summary>
+    /// Destructs the model
+    /// </summary>
+    virtual ~NeuralModel() = default;
+
+    /// <summary>
+    /// Steps the model to calculate the new outputs from the given inputs
+    /// </summary>
+    /// <returns>true if successful</returns>
+    virtual bool step_network() = 0;
+
+    /// <summary>
+    /// Sets the given input to a provided value
+    /// </summary>
+    /// <param name="index">the input index to set</param>
+    /// <param name="value">the value to set</param>
+    /// <returns>true if successful</returns>
+    virtual bool set_input(
+        const size_t index,
+        const double value) = 0;
+
+    /// <summary>
+    /// Obtains the given output for a value
+    /// </summary>
+    /// <param name="index">the output index to get</param>
+    /// <param name="output">the output parameter to use</param>
+    /// <returns>true if successful</returns>
+    virtual bool get_output(
+        const size_t index,
+        double& output) const = 0;
+
+    /// <summary>
+    /// Provides the number of inputs
+    /// </summary>
+    /// <returns>the number of inputs</returns>
+    virtual size_t size_inputs() const = 0;
+
+    /// <summary>
+    /// Provides the number of outputs
+    /// </summary>
+    /// <returns>the number of outputs</returns>
+    virtual size_t size_outputs() const = 0;
+
+    /// <summary>
+    /// Provides the number of parameters used to define the model
+    /// </summary>
+    /// <returns>the parameter count</returns>
+    virtual size_t parameter_count() const = 0;
+
+    /// <summary>
+    /// Provides the current parameter values of the model
+    /// </summary>
+    /// <returns>a vector of parameter_count() values</returns>
+    virtual std::vector<double> get_parameters() const = 0;
+
+    /// <summary>
+    /// Sets the parameters of the model
+    /// </summary>
+    /// <param name="values">a pointer to parameter_count() values to set</param>
+    virtual void set_parameters(const double* values) = 0;
+
+    /// <summary>
+    /// Provides the string representation of the current model, in the
+    /// configuration format read by NeuralNetwork::from_config, or by
+    /// MixtureNetwork::from_config for mixture networks
+    /// </summary>
+    /// <returns>string configuration representation</returns>
+    virtual std::string get_config() const = 0;
+
+    /// <summary>
+    /// Provides how the outputs of the model are interpreted as control inputs
+    /// </summary>
+    /// <returns>the output head</returns>
+    virtual OutputHead get_output_head() const = 0;
+
+    /// <summary>
+    /// Sets how the outputs of the model are interpreted as control inputs
+    /// </summary>
+    /// <param name="head">the output head to set</param>
+    virtual void set_output_head(const OutputHead head) = 0;
+
+    /// <summary>
+    /// Creates a copy of the current model
+    /// </summary>
+    /// <returns>a new model with the same structure and parameters</returns>
+    virtual std::unique_ptr<NeuralModel> clone() const = 0;
+};
+
+#endif
@@ -263,6 +263,11 @@ std::vector<NeuralLink>& NeuralNetwork::get_links()
     return links;
 }
 
+const std::vector<NeuralLink>& NeuralNetwork::get_links() const
+{
+    return links;
+}
+
 std::string NeuralNetwork::get_status() const
 {
     // Define the string stream
@@ -329,6 +334,13 @@ std::string NeuralNetwork::get_config() const
         }
     }
 
+    // Write the output head, if not the default voting head, so that voting
+    // configurations remain readable by earlier versions
+    if (output_head == OutputHead::CONTINUOUS)
+    {
+        output << "head=continuous" << std::endl;
+    }
+
     output << 8080 << std::endl;
 
     // Return combined values
@@ -459,11 +471,22 @@ NeuralNetwork NeuralNetwork::from_config(const std::string& config)
         net.layers.push_back(layer);
     }
 
-    // Check that the ending value is 0
-    size_t end_val = 10;
-    input >> end_val;
+    // Read the optional output head, and check the ending value
+    std::string end_str;
+    input >> end_str;
 
-    if (!input || end_val != 8080)
+    if (end_str == "head=continuous")
+    {
+        net.output_head = OutputHead::CONTINUOUS;
+        input >> end_str;
+    }
+    else if (end_str == "head=voting")
+    {
+        net.output_head = OutputHead::VOTING;
+        input >> end_str;
+    }
+
+    if (!input || end_str != "8080")
     {
         throw std::invalid_argument("configuration end value is incorrect");
     }
@@ -471,3 +494,177 @@ NeuralNetwork NeuralNetwork::from_config(const std::string& config)
     // Return the network
     return net;
 }
+
+NeuralModel::OutputHead NeuralNetwork::get_output_head() const
+{
+    return output_head;
+}
+
+void NeuralNetwork::set_output_head(const OutputHead head)
+{
+    output_head = head;
+}
+
+size_t NeuralNetwork::parameter_count() const
+{
+    return links.size();
+}
+
+std::vector<double> NeuralNetwork::get_parameters() const
+{
+    std::vector<double> values(links.size(), 0.0);
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+        values[i] = links[i].get_gain();
+    }
+    return values;
+}
+
+void NeuralNetwork::set_parameters(const double* values)
+{
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+        links[i].set_gain(values[i]);
+    }
+}
+
+std::vector<size_t> NeuralNetwork::get_layer_sizes() const
+{
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        size_t count = 0;
+        for (size_t j = 0; j < layers[i].node_ids.size(); ++j)
+        {
+            if (!nodes[layers[i].node_ids[j]].is_bias_node())
+            {
+                count += 1;
+            }
+        }
+        sizes.push_back(count);
+    }
+    return sizes;
+}
+
+std::vector<size_t> NeuralNetwork::get_layer_positions(const size_t layer_index) const
+{
+    // Define the position for each node, defaulting to outside of the layer
+    std::vector<size_t> positions(nodes.size(), nodes.size());
+    const NeuralLayer& layer = layers[layer_index];
+
+    // Add the non-bias nodes in order
+    size_t count = 0;
+    for (size_t i = 0; i < layer.node_ids.size(); ++i)
+    {
+        if (!nodes[layer.node_ids[i]].is_bias_node())
+        {
+            positions[layer.node_ids[i]] = count;
+            count += 1;
+        }
+    }
+
+    // Place all bias nodes after the non-bias nodes
+    for (size_t i = 0; i < layer.node_ids.size(); ++i)
+    {
+        if (nodes[layer.node_ids[i]].is_bias_node())
+        {
+            positions[layer.node_ids[i]] = count;
+        }
+    }
+
+    return positions;
+}
+
+bool NeuralNetwork::get_layer_weights(
+    const size_t layer_index,
+    std::vector<double>& weights) const
+{
+    // Ensure that the layer has a previous layer
+    if (layer_index == 0 || layer_index >= layers.size())
+    {
+        return false;
+    }
+
+    // Determine the matrix size and node positions
+    const std::vector<size_t> sizes = get_layer_sizes();
+    const size_t rows = sizes[layer_index];
+    const size_t cols = sizes[layer_index - 1] + 1;
+
+    const std::vector<size_t> row_pos = get_layer_positions(layer_index);
+    const std::vector<size_t> col_pos = get_layer_positions(layer_index - 1);
+
+    // Add each link into the matrix
+    weights.assign(rows * cols, 0.0);
+
+    const NeuralLayer& layer = layers[layer_index];
+    for (size_t i = 0; i < layer.link_ids.size(); ++i)
+    {
+        const NeuralLink& link = links[layer.link_ids[i]];
+        const size_t r = row_pos[link.to_node_id()];
+        const size_t c = col_pos[link.from_node_id()];
+
+        if (c >= cols || r > rows)
+        {
+            return false;
+        }
+        else if (r < rows)
+        {
+            weights[r * cols + c] += link.get_gain();
+        }
+    }
+
+    return true;
+}
+
+bool NeuralNetwork::set_layer_weights(
+    const size_t layer_index,
+    const std::vector<double>& weights)
+{
+    // Ensure that the layer has a previous layer
+    if (layer_index == 0 || layer_index >= layers.size())
+    {
+        return false;
+    }
+
+    // Determine the matrix size and node positions
+    const std::vector<size_t> sizes = get_layer_sizes();
+    const size_t rows = sizes[layer_index];
+    const size_t cols = sizes[layer_index - 1] + 1;
+
+    if (weights.size() != rows * cols)
+    {
+        return false;
+    }
+
+    const std::vector<size_t> row_pos = get_layer_positions(layer_index);
+    const std::vector<size_t> col_pos = get_layer_positions(layer_index - 1);
+
+    // Set each link from the matrix
+    const NeuralLayer& layer = layers[layer_index];
+    for (size_t i = 0; i < layer.link_ids.size(); ++i)
+    {
+        NeuralLink& link = links[layer.link_ids[i]];
+        const size_t r = row_pos[link.to_node_id()];
+        const size_t c = col_pos[link.from_node_id()];
+
+        if (c >= cols || r > rows)
+        {
+            return false;
+        }
+        else if (r < rows)
+        {
+            link.set_gain(weights[r * cols + c]);
+        }
+        else
+        {
+            link.set_gain(0.0);
+        }
+    }
+
+    return true;
+}
+
+std::unique_ptr<NeuralModel> NeuralNetwork::clone() const
+{
+    return std::make_unique<NeuralNetwork>(*this);
+}
@@ -7,12 +7,13 @@
 
 #include "neural/layer.h"
 #include "neural/link.h"
+#include "neural/model.h"
 #include "neural/node.h"
 
 /// <summary>
 /// The overall neural network
 /// </summary>
-class NeuralNetwork
+class NeuralNetwork : public NeuralModel
 {
 public:
     /// <summary>
@@ -32,7 +33,7 @@ public:
     /// Steps the neural network to calculate the new outputs from the given inputs
     /// </summary>
     /// <returns>true if successful</returns>
-    bool step_network();
+    virtual bool step_network() override;
 
     /// <summary>
     /// Adds a new layer to the network. Will not allow a new layer
@@ -55,9 +56,9 @@ public:
     /// <param name="index">the input index to set</param>
     /// <param name="value">the value to set</param>
     /// <returns>true if successful</returns>
-    bool set_input(
+    virtual bool set_input(
         const size_t index,
-        const double value);
+        const double value) override;
 
     /// <summary>
     /// Obtains the given output for a value
@@ -65,21 +66,21 @@ public:
     /// <param name="index">the output index to get</param>
     /// <param name="output">the output parameter to use</param>
     /// <returns>true if successful</returns>
-    bool get_output(
+    virtual bool get_output(
         const size_t index,
-        double& output) const;
+        double& output) const override;
 
     /// <summary>
     /// Provides the number of inputs
     /// </summary>
     /// <returns>the number of inputs</returns>
-    size_t size_inputs() const;
+    virtual size_t size_inputs() const override;
 
     /// <summary>
     /// Provides the number of outputs
     /// </summary>
     /// <returns>the number of outputs</returns>
-    size_t size_outputs() const;
+    virtual size_t size_outputs() const override;
 
     /// <summary>
     /// Obtains a vector of all links to be used in setting
@@ -88,6 +89,60 @@ public:
     /// <returns>a mutable vector of links</returns>
     std::vector<NeuralLink>& get_links();
 
+    /// <summary>
+    /// Obtains a vector of all links in the network
+    /// </summary>
+    /// <returns>a constant vector of links</returns>
+    const std::vector<NeuralLink>& get_links() const;
+
+    /// <summary>
+    /// Provides the number of link gains in the network
+    /// </summary>
+    /// <returns>the parameter count</returns>
+    virtual size_t parameter_count() const override;
+
+    /// <summary>
+    /// Provides the gain of each link, in link order
+    /// </summary>
+    /// <returns>the link gains</returns>
+    virtual std::vector<double> get_parameters() const override;
+
+    /// <summary>
+    /// Sets the gain of each link, in link order
+    /// </summary>
+    /// <param name="values">a pointer to parameter_count() gains to set</param>
+    virtual void set_parameters(const double* values) override;
+
+    /// <summary>
+    /// Provides the number of non-bias nodes in each layer, from the
+    /// input layer to the output layer
+    /// </summary>
+    /// <returns>the number of non-bias nodes in each layer</returns>
+    std::vector<size_t> get_layer_sizes() const;
+
+    /// <summary>
+    /// Provides the dense weight matrix feeding the given layer. The matrix is row-major,
+    /// with one row for each non-bias node in the layer and one column for each non-bias
+    /// node in the previous layer, followed by a final column for the previous layer's bias
+    /// </summary>
+    /// <param name="layer_index">the layer index to obtain weights for, at least one</param>
+    /// <param name="weights">the output parameter to fill with the weights</param>
+    /// <returns>true if successful; false if a link does not come from the previous layer</returns>
+    bool get_layer_weights(
+        const size_t layer_index,
+        std::vector<double>& weights) const;
+
+    /// <summary>
+    /// Sets the gains of the links feeding the given layer from a dense weight matrix
+    /// in the form provided by get_layer_weights. Links into bias nodes are set to zero
+    /// </summary>
+    /// <param name="layer_index">the layer index to set weights for, at least one</param>
+    /// <param name="weights">the weights to set</param>
+    /// <returns>true if successful</returns>
+    bool set_layer_weights(
+        const size_t layer_index,
+        const std::vector<double>& weights);
+
     /// <summary>
     /// Provides some simple text output of the current status
     /// </summary>
@@ -98,7 +153,7 @@ public:
     /// Provides the string representation of the current network
     /// </summary>
     /// <returns>string configuration representation</returns>
-    std::string get_config() const;
+    virtual std::string get_config() const override;
 
     /// <summary>
     /// Provides a neural network from the given neural network configuration string
@@ -108,6 +163,34 @@ public:
     /// <returns>the network associated with the given configuration</returns>
     static NeuralNetwork from_config(const std::string& config);
 
+    /// <summary>
+    /// Provides how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <returns>the output head</returns>
+    virtual OutputHead get_output_head() const override;
+
+    /// <summary>
+    /// Sets how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <param name="head">the output head to set</param>
+    virtual void set_output_head(const OutputHead head) override;
+
+    /// <summary>
+    /// Creates a copy of the current network
+    /// </summary>
+    /// <returns>a new network with the same structure and gains</returns>
+    virtual std::unique_ptr<NeuralModel> clone() const override;
+
+private:
+    /// <summary>
+    /// Provides the position of each node within the given layer, with all bias nodes
+    /// sharing the position after the non-bias nodes, or the node count for nodes
+    /// outside of the layer
+    /// </summary>
+    /// <param name="layer_index">the layer index to map</param>
+    /// <returns>a vector indexed by node ID with the node position in the layer</returns>
+    std::vector<size_t> get_layer_positions(const size_t layer_index) const;
+
 private:
     /// <summary>
     /// The neural network layers, to be evaluated from
@@ -124,6 +207,11 @@ private:
     /// The neural network links
     /// </summary>
     std::vector<NeuralLink> links;
+
+    /// <summary>
+    /// How the outputs of the network are interpreted as control inputs
+    /// </summary>
+    OutputHead output_head = OutputHead::VOTING;
 };
 
 #endif
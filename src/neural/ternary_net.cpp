@@ -0,0 +1,426 @@
+#include "neural/ternary_net.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+const size_t TernaryNetwork::activation_bits = 8;
+
+// Provides the number of set bits in the given word, using the hardware
+// instruction where the compiler target provides it
+static inline uint64_t count_bits(const uint64_t val)
+{
+#if defined(_MSC_VER)
+    return __popcnt64(val);
+#elif defined(__POPCNT__)
+    return static_cast<uint64_t>(__builtin_popcountll(val));
+#else
+    uint64_t v = val - ((val >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (v * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+TernaryNetwork TernaryNetwork::from_layers(const std::vector<size_t>& layers)
+{
+    // Ensure that layers were added
+    if (layers.size() == 0)
+    {
+        throw std::invalid_argument("layers vector must have at least one layer");
+    }
+
+    // Check that size values are provided
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        if (layers[i] == 0)
+        {
+            std::ostringstream ss;
+            ss << "layer " << static_cast<int>(i) << " must have at least one node";
+            throw std::invalid_argument(ss.str());
+        }
+    }
+
+    // Create the net
+    TernaryNetwork net;
+    net.init_layers(layers);
+    return net;
+}
+
+TernaryNetwork TernaryNetwork::from_network(const NeuralNetwork& net)
+{
+    // Create the zeroed network with the same layer sizes
+    TernaryNetwork ternary = from_layers(net.get_layer_sizes());
+
+    // Quantize each layer's weights
+    for (size_t i = 0; i < ternary.packed_layers.size(); ++i)
+    {
+        PackedLayer& layer = ternary.packed_layers[i];
+
+        std::vector<double> weights;
+        if (!net.get_layer_weights(i + 1, weights))
+        {
+            std::ostringstream ss;
+            ss << "layer " << static_cast<int>(i + 1) << " has links from outside the previous layer";
+            throw std::invalid_argument(ss.str());
+        }
+
+        // Determine the zero threshold from the mean gain magnitude
+        double mean_abs = 0.0;
+        for (size_t j = 0; j < weights.size(); ++j)
+        {
+            mean_abs += std::abs(weights[j]);
+        }
+        mean_abs /= static_cast<double>(weights.size());
+
+        const double threshold = 0.7 * mean_abs;
+
+        // Set the gains, and the scale from the mean of the magnitudes kept
+        double scale_sum = 0.0;
+        size_t scale_count = 0;
+
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            for (size_t c = 0; c < layer.cols; ++c)
+            {
+                const double w = weights[r * layer.cols + c];
+                if (std::abs(w) > threshold)
+                {
+                    set_gain(layer, r, c, (w > 0.0) ? 1.0 : -1.0);
+                    scale_sum += std::abs(w);
+                    scale_count += 1;
+                }
+            }
+        }
+
+        layer.scale = (scale_count > 0) ? scale_sum / static_cast<double>(scale_count) : 1.0;
+    }
+
+    ternary.output_head = net.get_output_head();
+    return ternary;
+}
+
+void TernaryNetwork::init_layers(const std::vector<size_t>& layers)
+{
+    layer_sizes = layers;
+    packed_layers.clear();
+
+    size_t max_words = 0;
+
+    for (size_t i = 1; i < layers.size(); ++i)
+    {
+        PackedLayer layer;
+        layer.rows = layers[i];
+        layer.cols = layers[i - 1] + 1;
+        layer.words = (layer.cols + 63) / 64;
+        layer.positive.assign(layer.rows * layer.words, 0);
+        layer.negative.assign(layer.rows * layer.words, 0);
+        packed_layers.push_back(layer);
+
+        max_words = std::max(max_words, layer.words);
+    }
+
+    // Define the node values with a bias value after each layer
+    node_values.assign(layer_offset(layers.size()), 0.0);
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        node_values[layer_offset(i) + layers[i]] = 1.0;
+    }
+
+    positive_planes.assign(activation_bits * max_words, 0);
+    negative_planes.assign(activation_bits * max_words, 0);
+}
+
+int TernaryNetwork::get_gain(
+    const PackedLayer& layer,
+    const size_t row,
+    const size_t col)
+{
+    const size_t word = row * layer.words + col / 64;
+    const uint64_t bit = static_cast<uint64_t>(1) << (col % 64);
+
+    if (layer.positive[word] & bit)
+    {
+        return 1;
+    }
+    else if (layer.negative[word] & bit)
+    {
+        return -1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+void TernaryNetwork::set_gain(
+    PackedLayer& layer,
+    const size_t row,
+    const size_t col,
+    const double gain)
+{
+    const size_t word = row * layer.words + col / 64;
+    const uint64_t bit = static_cast<uint64_t>(1) << (col % 64);
+
+    layer.positive[word] &= ~bit;
+    layer.negative[word] &= ~bit;
+
+    if (gain > 0.5)
+    {
+        layer.positive[word] |= bit;
+    }
+    else if (gain < -0.5)
+    {
+        layer.negative[word] |= bit;
+    }
+}
+
+size_t TernaryNetwork::layer_offset(const size_t layer_index) const
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < layer_index; ++i)
+    {
+        offset += layer_sizes[i] + 1;
+    }
+    return offset;
+}
+
+NeuralNetwork TernaryNetwork::to_network() const
+{
+    NeuralNetwork net = NeuralNetwork::from_layers(layer_sizes);
+    net.set_output_head(output_head);
+
+    for (size_t i = 0; i < packed_layers.size(); ++i)
+    {
+        const PackedLayer& layer = packed_layers[i];
+
+        std::vector<double> weights(layer.rows * layer.cols, 0.0);
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            for (size_t c = 0; c < layer.cols; ++c)
+            {
+                weights[r * layer.cols + c] = layer.scale * get_gain(layer, r, c);
+            }
+        }
+
+        net.set_layer_weights(i + 1, weights);
+    }
+
+    return net;
+}
+
+bool TernaryNetwork::set_layer_scale(
+    const size_t layer_index,
+    const double scale)
+{
+    if (layer_index == 0 || layer_index > packed_layers.size())
+    {
+        return false;
+    }
+    else
+    {
+        packed_layers[layer_index - 1].scale = scale;
+        return true;
+    }
+}
+
+bool TernaryNetwork::step_network()
+{
+    // Return false if the layer size is less than two
+    //   for no layers, or input layer is also output layer
+    if (layer_sizes.size() < 2)
+    {
+        return false;
+    }
+
+    const double max_level = static_cast<double>((static_cast<uint64_t>(1) << activation_bits) - 1);
+
+    size_t in_offset = 0;
+
+    for (size_t i = 0; i < packed_layers.size(); ++i)
+    {
+        const PackedLayer& layer = packed_layers[i];
+        const double* in_vals = &node_values[in_offset];
+        double* out_vals = &node_values[in_offset + layer.cols];
+
+        // Determine the input scale from the largest input magnitude
+        double in_scale = 0.0;
+        for (size_t c = 0; c < layer.cols; ++c)
+        {
+            in_scale = std::max(in_scale, std::abs(in_vals[c]));
+        }
+
+        if (in_scale == 0.0)
+        {
+            std::fill(out_vals, out_vals + layer.rows, 0.0);
+            in_offset += layer.cols;
+            continue;
+        }
+
+        // Quantize the input magnitudes into sign-separated bit planes
+        std::fill(positive_planes.begin(), positive_planes.begin() + activation_bits * layer.words, 0);
+        std::fill(negative_planes.begin(), negative_planes.begin() + activation_bits * layer.words, 0);
+
+        for (size_t c = 0; c < layer.cols; ++c)
+        {
+            const uint64_t level = static_cast<uint64_t>(std::abs(in_vals[c]) / in_scale * max_level + 0.5);
+            std::vector<uint64_t>& planes = (in_vals[c] > 0.0) ? positive_planes : negative_planes;
+            const uint64_t bit = static_cast<uint64_t>(1) << (c % 64);
+
+            for (size_t b = 0; b < activation_bits; ++b)
+            {
+                if ((level >> b) & 1)
+                {
+                    planes[b * layer.words + c / 64] |= bit;
+                }
+            }
+        }
+
+        // Accumulate each output from the popcount of the matching planes and gains
+        const double out_scale = layer.scale * in_scale / max_level;
+
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            const uint64_t* pos_gain = &layer.positive[r * layer.words];
+            const uint64_t* neg_gain = &layer.negative[r * layer.words];
+
+            int64_t sum = 0;
+
+            for (size_t b = 0; b < activation_bits; ++b)
+            {
+                const uint64_t* pos_in = &positive_planes[b * layer.words];
+                const uint64_t* neg_in = &negative_planes[b * layer.words];
+
+                uint64_t plus = 0;
+                uint64_t minus = 0;
+
+                // Positive and negative inputs never share a bit, so the matching
+                // terms may be combined before counting
+                for (size_t w = 0; w < layer.words; ++w)
+                {
+                    plus += count_bits((pos_in[w] & pos_gain[w]) | (neg_in[w] & neg_gain[w]));
+                    minus += count_bits((pos_in[w] & neg_gain[w]) | (neg_in[w] & pos_gain[w]));
+                }
+
+                sum += (static_cast<int64_t>(plus) - static_cast<int64_t>(minus)) << b;
+            }
+
+            out_vals[r] = out_scale * static_cast<double>(sum);
+        }
+
+        in_offset += layer.cols;
+    }
+
+    return true;
+}
+
+bool TernaryNetwork::set_input(
+    const size_t index,
+    const double value)
+{
+    if (layer_sizes.size() > 0 && index < layer_sizes.front())
+    {
+        node_values[index] = value;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool TernaryNetwork::get_output(
+    const size_t index,
+    double& output) const
+{
+    if (layer_sizes.size() > 0 && index < layer_sizes.back())
+    {
+        output = node_values[layer_offset(layer_sizes.size() - 1) + index];
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+size_t TernaryNetwork::size_inputs() const
+{
+    return (layer_sizes.size() > 0) ? layer_sizes.front() + 1 : 0;
+}
+
+size_t TernaryNetwork::size_outputs() const
+{
+    return (layer_sizes.size() > 0) ? layer_sizes.back() + 1 : 0;
+}
+
+size_t TernaryNetwork::parameter_count() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < packed_layers.size(); ++i)
+    {
+        count += packed_layers[i].rows * packed_layers[i].cols;
+    }
+    return count;
+}
+
+std::vector<double> TernaryNetwork::get_parameters() const
+{
+    std::vector<double> values;
+    values.reserve(parameter_count());
+
+    for (size_t i = 0; i < packed_layers.size(); ++i)
+    {
+        const PackedLayer& layer = packed_layers[i];
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            for (size_t c = 0; c < layer.cols; ++c)
+            {
+                values.push_back(static_cast<double>(get_gain(layer, r, c)));
+            }
+        }
+    }
+
+    return values;
+}
+
+void TernaryNetwork::set_parameters(const double* values)
+{
+    for (size_t i = 0; i < packed_layers.size(); ++i)
+    {
+        PackedLayer& layer = packed_layers[i];
+        for (size_t r = 0; r < layer.rows; ++r)
+        {
+            for (size_t c = 0; c < layer.cols; ++c)
+            {
+                set_gain(layer, r, c, *values);
+                values += 1;
+            }
+        }
+    }
+}
+
+std::string TernaryNetwork::get_config() const
+{
+    return to_network().get_config();
+}
+
+NeuralModel::OutputHead TernaryNetwork::get_output_head() const
+{
+    return output_head;
+}
+
+void TernaryNetwork::set_output_head(const OutputHead head)
+{
+    output_head = head;
+}
+
+std::unique_ptr<NeuralModel> TernaryNetwork::clone() const
+{
+    return std::make_unique<TernaryNetwork>(*this);
+}
@@ -0,0 +1,248 @@
+#ifndef __IO_NEURAL_TERNARY_NET__
+#define __IO_NEURAL_TERNARY_NET__
+
+#include <cstdint>
+#include <vector>
+
+#include "neural/model.h"
+#include "neural/net.h"
+
+/// <summary>
+/// Defines a fully-connected network where each gain is constrained to -1, 0 or +1,
+/// multiplied by a per-layer scale. Gains are bit-packed into positive and negative
+/// masks with 64 gains per word, and layer inputs are quantized into bit planes so that
+/// each step is evaluated with AND-popcount operations instead of multiplications
+/// </summary>
+class TernaryNetwork : public NeuralModel
+{
+public:
+    /// <summary>
+    /// Creates a TernaryNetwork with all gains set to zero and a layer scale of one.
+    /// Will throw an std::invalid_argument for an invalid (empty or zero layer size) input
+    /// </summary>
+    /// <param name="layers">a vector of layers, with each size_t containing the
+    /// number of nodes to put in that layer, not including the bias node</param>
+    /// <returns>TernaryNetwork</returns>
+    static TernaryNetwork from_layers(const std::vector<size_t>& layers);
+
+    /// <summary>
+    /// Creates a TernaryNetwork by quantizing the gains of the provided network. Gains
+    /// smaller than a threshold of 0.7 times the mean magnitude are set to zero, and the
+    /// layer scale is the mean magnitude of the remaining gains.
+    /// Will throw an std::invalid_argument if the network is not layered
+    /// </summary>
+    /// <param name="net">the network to quantize</param>
+    /// <returns>TernaryNetwork</returns>
+    static TernaryNetwork from_network(const NeuralNetwork& net);
+
+public:
+    /// <summary>
+    /// Expands the ternary gains and layer scales into a full NeuralNetwork
+    /// </summary>
+    /// <returns>the equivalent full network</returns>
+    NeuralNetwork to_network() const;
+
+    /// <summary>
+    /// Sets the scale multiplied into each gain of the given layer
+    /// </summary>
+    /// <param name="layer_index">the layer index, at least one</param>
+    /// <param name="scale">the scale to set</param>
+    /// <returns>true if successful</returns>
+    bool set_layer_scale(
+        const size_t layer_index,
+        const double scale);
+
+    /// <summary>
+    /// Steps the network to calculate the new outputs from the given inputs
+    /// </summary>
+    /// <returns>true if successful</returns>
+    virtual bool step_network() override;
+
+    /// <summary>
+    /// Sets the given input to a provided value
+    /// </summary>
+    /// <param name="index">the input index to set</param>
+    /// <param name="value">the value to set</param>
+    /// <returns>true if successful</returns>
+    virtual bool set_input(
+        const size_t index,
+        const double value) override;
+
+    /// <summary>
+    /// Obtains the given output for a value
+    /// </summary>
+    /// <param name="index">the output index to get</param>
+    /// <param name="output">the output parameter to use</param>
+    /// <returns>true if successful</returns>
+    virtual bool get_output(
+        const size_t index,
+        double& output) const override;
+
+    /// <summary>
+    /// Provides the number of inputs, including the bias node
+    /// </summary>
+    /// <returns>the number of inputs</returns>
+    virtual size_t size_inputs() const override;
+
+    /// <summary>
+    /// Provides the number of outputs, including the bias node
+    /// </summary>
+    /// <returns>the number of outputs</returns>
+    virtual size_t size_outputs() const override;
+
+    /// <summary>
+    /// Provides the number of ternary gains in the network
+    /// </summary>
+    /// <returns>the parameter count</returns>
+    virtual size_t parameter_count() const override;
+
+    /// <summary>
+    /// Provides the ternary gains as -1.0, 0.0 or 1.0, in row-major order for each layer
+    /// </summary>
+    /// <returns>the gain values</returns>
+    virtual std::vector<double> get_parameters() const override;
+
+    /// <summary>
+    /// Sets the ternary gains, in row-major order for each layer. Values are
+    /// rounded to the nearest of -1, 0 and +1
+    /// </summary>
+    /// <param name="values">a pointer to parameter_count() values to set</param>
+    virtual void set_parameters(const double* values) override;
+
+    /// <summary>
+    /// Provides the configuration of the expanded network
+    /// </summary>
+    /// <returns>string configuration representation</returns>
+    virtual std::string get_config() const override;
+
+    /// <summary>
+    /// Provides how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <returns>the output head</returns>
+    virtual OutputHead get_output_head() const override;
+
+    /// <summary>
+    /// Sets how the outputs of the network are interpreted as control inputs
+    /// </summary>
+    /// <param name="head">the output head to set</param>
+    virtual void set_output_head(const OutputHead head) override;
+
+    /// <summary>
+    /// Creates a copy of the current network
+    /// </summary>
+    /// <returns>a new network with the same gains</returns>
+    virtual std::unique_ptr<NeuralModel> clone() const override;
+
+private:
+    /// <summary>
+    /// Defines the packed gains feeding a layer
+    /// </summary>
+    struct PackedLayer
+    {
+        /// <summary>
+        /// The number of non-bias nodes in the layer
+        /// </summary>
+        size_t rows = 0;
+
+        /// <summary>
+        /// The number of nodes in the previous layer, including the bias
+        /// </summary>
+        size_t cols = 0;
+
+        /// <summary>
+        /// The number of 64-bit words used to store each row
+        /// </summary>
+        size_t words = 0;
+
+        /// <summary>
+        /// The scale multiplied into each gain
+        /// </summary>
+        double scale = 1.0;
+
+        /// <summary>
+        /// The row-major masks of the gains equal to +1
+        /// </summary>
+        std::vector<uint64_t> positive;
+
+        /// <summary>
+        /// The row-major masks of the gains equal to -1
+        /// </summary>
+        std::vector<uint64_t> negative;
+    };
+
+    /// <summary>
+    /// Initializes the layer sizes and zeroed gains
+    /// </summary>
+    /// <param name="layers">the non-bias node count in each layer</param>
+    void init_layers(const std::vector<size_t>& layers);
+
+    /// <summary>
+    /// Provides the ternary gain at the given location
+    /// </summary>
+    /// <param name="layer">the packed layer</param>
+    /// <param name="row">the row index</param>
+    /// <param name="col">the column index</param>
+    /// <returns>-1, 0 or +1</returns>
+    static int get_gain(
+        const PackedLayer& layer,
+        const size_t row,
+        const size_t col);
+
+    /// <summary>
+    /// Sets the ternary gain at the given location
+    /// </summary>
+    /// <param name="layer">the packed layer</param>
+    /// <param name="row">the row index</param>
+    /// <param name="col">the column index</param>
+    /// <param name="gain">the gain, rounded to the nearest of -1, 0 and +1</param>
+    static void set_gain(
+        PackedLayer& layer,
+        const size_t row,
+        const size_t col,
+        const double gain);
+
+    /// <summary>
+    /// Provides the offset of the given layer in the node value vector
+    /// </summary>
+    /// <param name="layer_index">the layer index</param>
+    /// <returns>the index of the first node value in the layer</returns>
+    size_t layer_offset(const size_t layer_index) const;
+
+private:
+    /// <summary>
+    /// The number of bits used to quantize the magnitude of each layer input
+    /// </summary>
+    static const size_t activation_bits;
+
+    /// <summary>
+    /// The number of non-bias nodes in each layer
+    /// </summary>
+    std::vector<size_t> layer_sizes;
+
+    /// <summary>
+    /// The packed gains feeding each layer after the input layer
+    /// </summary>
+    std::vector<PackedLayer> packed_layers;
+
+    /// <summary>
+    /// The node values for each layer, each followed by a bias value of one
+    /// </summary>
+    std::vector<double> node_values;
+
+    /// <summary>
+    /// The positive input bit planes, with activation_bits planes of the layer words
+    /// </summary>
+    std::vector<uint64_t> positive_planes;
+
+    /// <summary>
+    /// The negative input bit planes, with activation_bits planes of the layer words
+    /// </summary>
+    std::vector<uint64_t> negative_planes;
+
+    /// <summary>
+    /// How the outputs of the network are interpreted as control inputs
+    /// </summary>
+    OutputHead output_head = OutputHead::VOTING;
+};
+
+#endif
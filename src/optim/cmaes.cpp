@@ -0,0 +1,427 @@
+#include "optim/cmaes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+const double CmaesOptim::initial_step_fraction = 0.1;
+
+CmaesOptim::CmaesOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    const bool separable,
+    std::unique_ptr<RandomSource> random_source) :
+    num_des_var(num_des_var),
+    separable(separable),
+    current_generation(0),
+    designs(num_designs, num_des_var),
+    samples_z(num_designs * num_des_var, 0.0),
+    samples_y(num_designs * num_des_var, 0.0),
+    mean(num_des_var, 0.0),
+    path_c(num_des_var, 0.0),
+    path_sigma(num_des_var, 0.0),
+    mean_step_y(num_des_var, 0.0),
+    mean_step_z(num_des_var, 0.0),
+    order(num_designs, 0),
+    random(std::move(random_source))
+{
+    // Check for valid inputs
+    if (num_designs < 2 || num_des_var == 0)
+    {
+        throw std::invalid_argument("population must have at least two designs and design variables must be positive");
+    }
+
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
+    // Define the recombination weights for the fittest half of the designs
+    const size_t mu = num_designs / 2;
+    weights.resize(mu);
+
+    for (size_t i = 0; i < mu; ++i)
+    {
+        weights[i] = std::log(static_cast<double>(mu) + 0.5) - std::log(static_cast<double>(i + 1));
+    }
+
+    const double weight_sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double weight_sq_sum = 0.0;
+
+    for (size_t i = 0; i < mu; ++i)
+    {
+        weights[i] /= weight_sum;
+        weight_sq_sum += weights[i] * weights[i];
+    }
+
+    mu_eff = 1.0 / weight_sq_sum;
+
+    // Define the learning rates and damping
+    const double n = static_cast<double>(num_des_var);
+
+    c_c = (4.0 + mu_eff / n) / (n + 4.0 + 2.0 * mu_eff / n);
+    c_sigma = (mu_eff + 2.0) / (n + mu_eff + 5.0);
+    c_1 = 2.0 / ((n + 1.3) * (n + 1.3) + mu_eff);
+    c_mu = std::min(1.0 - c_1, 2.0 * (mu_eff - 2.0 + 1.0 / mu_eff) / ((n + 2.0) * (n + 2.0) + mu_eff));
+    damping = 1.0 + 2.0 * std::max(0.0, std::sqrt((mu_eff - 1.0) / (n + 1.0)) - 1.0) + c_sigma;
+    chi_n = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    // The separable covariance has fewer degrees of freedom, and so may be learned faster
+    if (separable)
+    {
+        c_1 = std::min(1.0, c_1 * (n + 2.0) / 3.0);
+        c_mu = std::min(1.0 - c_1, c_mu * (n + 2.0) / 3.0);
+    }
+
+    // Define the initial distribution and designs
+    init_population();
+}
+
+void CmaesOptim::init_population()
+{
+    reset_distribution(std::vector<double>(num_des_var, 0.5 * (lower_bound + upper_bound)));
+}
+
+void CmaesOptim::init_population(const std::vector<double>& other)
+{
+    if (other.size() != design_variable_count())
+    {
+        throw std::invalid_argument("input design variable size does not match between init vector and optimizer");
+    }
+
+    reset_distribution(other);
+}
+
+void CmaesOptim::reset_distribution(const std::vector<double>& initial_mean)
+{
+    for (size_t j = 0; j < num_des_var; ++j)
+    {
+        mean[j] = constrain_value(initial_mean[j]);
+    }
+
+    std::fill(path_c.begin(), path_c.end(), 0.0);
+    std::fill(path_sigma.begin(), path_sigma.end(), 0.0);
+
+    // Set the covariance to the identity
+    if (separable)
+    {
+        covariance.assign(num_des_var, 1.0);
+    }
+    else
+    {
+        covariance.assign(num_des_var * num_des_var, 0.0);
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            covariance[j * num_des_var + j] = 1.0;
+        }
+    }
+
+    sigma = initial_step_fraction * (upper_bound - lower_bound);
+    updates_since_reset = 0;
+
+    update_factor();
+    sample_designs();
+}
+
+void CmaesOptim::sample_designs()
+{
+    const size_t n = num_des_var;
+
+    random->fill_normal(samples_z.data(), samples_z.size(), 0.0, 1.0);
+
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        const double* z = &samples_z[i * n];
+        double* y = &samples_y[i * n];
+
+        // Transform the normal sample by the covariance factor
+        if (separable)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                y[j] = factor[j] * z[j];
+            }
+        }
+        else
+        {
+            for (size_t r = 0; r < n; ++r)
+            {
+                const double* frow = &factor[r * n];
+                double sum = 0.0;
+                for (size_t c = 0; c <= r; ++c)
+                {
+                    sum += frow[c] * z[c];
+                }
+                y[r] = sum;
+            }
+        }
+
+        // Define the design, limited to the bounds
+        double* x = designs.design(i);
+        for (size_t j = 0; j < n; ++j)
+        {
+            x[j] = constrain_value(mean[j] + sigma * y[j]);
+        }
+    }
+
+    designs.reset_fitness();
+}
+
+void CmaesOptim::update_designs()
+{
+    const size_t n = num_des_var;
+
+    // Order the designs by fitness, with the fittest first
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](const size_t i1, const size_t i2)
+    {
+        return designs.fitness(i1) > designs.fitness(i2);
+    });
+
+    // Determine the weighted steps of the selected designs. The steps use the
+    // unconstrained samples, so that the paths follow the sampled distribution
+    std::fill(mean_step_y.begin(), mean_step_y.end(), 0.0);
+    std::fill(mean_step_z.begin(), mean_step_z.end(), 0.0);
+
+    for (size_t k = 0; k < weights.size(); ++k)
+    {
+        const double w = weights[k];
+        const double* y = &samples_y[order[k] * n];
+        const double* z = &samples_z[order[k] * n];
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            mean_step_y[j] += w * y[j];
+            mean_step_z[j] += w * z[j];
+        }
+    }
+
+    // Move the mean
+    for (size_t j = 0; j < n; ++j)
+    {
+        mean[j] = constrain_value(mean[j] + sigma * mean_step_y[j]);
+    }
+
+    // Update the step size path. The inverse square root of the covariance applied to
+    // the weighted step is the weighted normal sample, as the samples are transformed
+    // by a factor of the covariance
+    const double ps_scale = std::sqrt(c_sigma * (2.0 - c_sigma) * mu_eff);
+    double ps_norm_sq = 0.0;
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        path_sigma[j] = (1.0 - c_sigma) * path_sigma[j] + ps_scale * mean_step_z[j];
+        ps_norm_sq += path_sigma[j] * path_sigma[j];
+    }
+
+    const double ps_norm = std::sqrt(ps_norm_sq);
+
+    // Update the covariance path, stalling it while the step size path is long
+    updates_since_reset += 1;
+    const double path_correction = std::sqrt(1.0 - std::pow(1.0 - c_sigma, 2.0 * static_cast<double>(updates_since_reset)));
+    const bool hsig = ps_norm / path_correction / chi_n < 1.4 + 2.0 / (static_cast<double>(n) + 1.0);
+
+    const double pc_scale = hsig ? std::sqrt(c_c * (2.0 - c_c) * mu_eff) : 0.0;
+    for (size_t j = 0; j < n; ++j)
+    {
+        path_c[j] = (1.0 - c_c) * path_c[j] + pc_scale * mean_step_y[j];
+    }
+
+    // Update the covariance and step size
+    update_covariance(hsig);
+
+    sigma *= std::exp((c_sigma / damping) * (ps_norm / chi_n - 1.0));
+    sigma = std::min(std::max(sigma, 1e-12), upper_bound - lower_bound);
+
+    // Sample the next designs
+    update_factor();
+    sample_designs();
+
+    current_generation += 1;
+}
+
+void CmaesOptim::update_covariance(const bool hsig)
+{
+    const size_t n = num_des_var;
+    const double old_scale = 1.0 - c_1 - c_mu + (hsig ? 0.0 : c_1 * c_c * (2.0 - c_c));
+
+    if (separable)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            double rank_mu = 0.0;
+            for (size_t k = 0; k < weights.size(); ++k)
+            {
+                const double y = samples_y[order[k] * n + j];
+                rank_mu += weights[k] * y * y;
+            }
+
+            covariance[j] = old_scale * covariance[j] + c_1 * path_c[j] * path_c[j] + c_mu * rank_mu;
+        }
+    }
+    else
+    {
+        // Update the lower triangle row by row, with each inner loop running over
+        // contiguous memory, and then copy it into the upper triangle
+        for (size_t r = 0; r < n; ++r)
+        {
+            double* crow = &covariance[r * n];
+            const double pc_r = c_1 * path_c[r];
+
+            for (size_t c = 0; c <= r; ++c)
+            {
+                crow[c] = old_scale * crow[c] + pc_r * path_c[c];
+            }
+
+            for (size_t k = 0; k < weights.size(); ++k)
+            {
+                const double* y = &samples_y[order[k] * n];
+                const double coeff = c_mu * weights[k] * y[r];
+
+                for (size_t c = 0; c <= r; ++c)
+                {
+                    crow[c] += coeff * y[c];
+                }
+            }
+        }
+
+        for (size_t r = 0; r < n; ++r)
+        {
+            for (size_t c = r + 1; c < n; ++c)
+            {
+                covariance[r * n + c] = covariance[c * n + r];
+            }
+        }
+    }
+}
+
+void CmaesOptim::update_factor()
+{
+    const size_t n = num_des_var;
+
+    if (separable)
+    {
+        factor.resize(n);
+        for (size_t j = 0; j < n; ++j)
+        {
+            factor[j] = std::sqrt(std::max(covariance[j], 0.0));
+        }
+        return;
+    }
+
+    factor.assign(n * n, 0.0);
+
+    // Determine the Cholesky factor, adding to the diagonal of the covariance
+    // if rounding has made it lose positive definiteness
+    double max_diag = 0.0;
+    for (size_t j = 0; j < n; ++j)
+    {
+        max_diag = std::max(max_diag, covariance[j * n + j]);
+    }
+
+    double jitter = 0.0;
+    bool success = false;
+
+    while (!success)
+    {
+        success = true;
+
+        for (size_t j = 0; j < n && success; ++j)
+        {
+            const double* fj = &factor[j * n];
+
+            double diag = covariance[j * n + j] + jitter;
+            for (size_t k = 0; k < j; ++k)
+            {
+                diag -= fj[k] * fj[k];
+            }
+
+            if (!(diag > 0.0))
+            {
+                success = false;
+                break;
+            }
+
+            const double fjj = std::sqrt(diag);
+            factor[j * n + j] = fjj;
+
+            for (size_t i = j + 1; i < n; ++i)
+            {
+                const double* fi = &factor[i * n];
+                double sum = covariance[i * n + j];
+                for (size_t k = 0; k < j; ++k)
+                {
+                    sum -= fi[k] * fj[k];
+                }
+                factor[i * n + j] = sum / fjj;
+            }
+        }
+
+        if (!success)
+        {
+            jitter = (jitter == 0.0) ? 1e-12 * std::max(max_diag, 1e-12) : 10.0 * jitter;
+            std::fill(factor.begin(), factor.end(), 0.0);
+        }
+    }
+
+    // Keep the jitter in the covariance so that the factor matches it
+    if (jitter > 0.0)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            covariance[j * n + j] += jitter;
+        }
+    }
+}
+
+const double* CmaesOptim::get_design(const size_t i) const
+{
+    if (i >= designs.size())
+    {
+        throw std::out_of_range("design index out of range for getting variables");
+    }
+    else
+    {
+        return designs.design(i);
+    }
+}
+
+size_t CmaesOptim::design_count() const
+{
+    return designs.size();
+}
+
+size_t CmaesOptim::design_variable_count() const
+{
+    return num_des_var;
+}
+
+void CmaesOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (ind >= designs.size())
+    {
+        throw std::out_of_range("design index out of range for setting fitness");
+    }
+    else
+    {
+        designs.fitness(ind) = val;
+    }
+}
+
+size_t CmaesOptim::get_generation() const
+{
+    return current_generation;
+}
+
+double CmaesOptim::get_step_size() const
+{
+    return sigma;
+}
+
+bool CmaesOptim::is_separable() const
+{
+    return separable;
+}
@@ -0,0 +1,261 @@
+#ifndef __IO_OPTIM_CMAES__
+#define __IO_OPTIM_CMAES__
+
+#include <memory>
+#include <vector>
+
+#include "optim/optimizer.h"
+#include "optim/population.h"
+#include "optim/random.h"
+
+/// <summary>
+/// CmaesOptim provides the covariance matrix adaptation evolution strategy. Each
+/// generation samples designs from a normal distribution around the mean, and then
+/// moves the mean towards the fittest designs while adapting the step size and the
+/// covariance of the distribution to the successful steps. The separable variant
+/// adapts only the diagonal of the covariance, so that the cost of each generation
+/// grows linearly with the number of design variables instead of quadratically
+/// </summary>
+class CmaesOptim : public Optimizer
+{
+public:
+    /// <summary>
+    /// Constructs the CMA-ES optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the number of designs sampled in each generation, at least two</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="separable">true to adapt only the diagonal of the covariance</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    CmaesOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        const bool separable,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for a given design, limited to the bounds
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Provides the count of the current designs
+    /// </summary>
+    /// <returns>the number of designs in the optimization algorithm</returns>
+    virtual size_t design_count() const override;
+
+    /// <summary>
+    /// Provides the count of the design variables
+    /// </summary>
+    /// <returns>the number of design variables in the optimization</returns>
+    virtual size_t design_variable_count() const override;
+
+    /// <summary>
+    /// Sets the fitness score for a given design
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Updates the mean, step size and covariance from the fittest designs,
+    /// and samples the next designs
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the current generation count for the optimization steps
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Resets the distribution to the center of the design space, with the
+    /// initial step size and an identity covariance, and samples new designs
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Resets the distribution to the given design variables, with the
+    /// initial step size and an identity covariance, and samples new designs
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Provides the current step size of the distribution
+    /// </summary>
+    /// <returns>the step size</returns>
+    double get_step_size() const;
+
+    /// <summary>
+    /// Provides whether only the diagonal of the covariance is adapted
+    /// </summary>
+    /// <returns>true for the separable variant</returns>
+    bool is_separable() const;
+
+private:
+    /// <summary>
+    /// Resets the distribution around the given mean
+    /// </summary>
+    /// <param name="initial_mean">the mean design variables</param>
+    void reset_distribution(const std::vector<double>& initial_mean);
+
+    /// <summary>
+    /// Samples the designs from the current distribution
+    /// </summary>
+    void sample_designs();
+
+    /// <summary>
+    /// Updates the covariance with the rank-one and rank-mu updates
+    /// </summary>
+    /// <param name="hsig">true if the evolution path length is within the expected range</param>
+    void update_covariance(const bool hsig);
+
+    /// <summary>
+    /// Updates the factor used to sample from the covariance, which is the lower
+    /// Cholesky factor for the full covariance and the element-wise square root of
+    /// the diagonal for the separable covariance
+    /// </summary>
+    void update_factor();
+
+private:
+    /// <summary>
+    /// The initial step size, as a fraction of the design range
+    /// </summary>
+    static const double initial_step_fraction;
+
+    /// <summary>
+    /// Storage for the number of design variables in a solution
+    /// </summary>
+    size_t num_des_var;
+
+    /// <summary>
+    /// Defines whether only the diagonal of the covariance is adapted
+    /// </summary>
+    bool separable;
+
+    /// <summary>
+    /// Storage for the current generation value for the solution
+    /// </summary>
+    size_t current_generation;
+
+    /// <summary>
+    /// The number of distribution updates since the last reset, used to correct
+    /// the evolution path length for its initialization at zero
+    /// </summary>
+    size_t updates_since_reset;
+
+    /// <summary>
+    /// The sampled designs, limited to the bounds, and their fitness values
+    /// </summary>
+    Population designs;
+
+    /// <summary>
+    /// The standard normal samples for each design, stored row-major by design
+    /// </summary>
+    std::vector<double> samples_z;
+
+    /// <summary>
+    /// The samples transformed by the covariance factor, stored row-major by design,
+    /// so that each unconstrained design is the mean plus the step size times its row
+    /// </summary>
+    std::vector<double> samples_y;
+
+    /// <summary>
+    /// The mean of the distribution
+    /// </summary>
+    std::vector<double> mean;
+
+    /// <summary>
+    /// The evolution path for the covariance
+    /// </summary>
+    std::vector<double> path_c;
+
+    /// <summary>
+    /// The conjugate evolution path for the step size
+    /// </summary>
+    std::vector<double> path_sigma;
+
+    /// <summary>
+    /// The covariance, as a row-major matrix, or the diagonal for the separable variant
+    /// </summary>
+    std::vector<double> covariance;
+
+    /// <summary>
+    /// The covariance factor, as a row-major lower triangular matrix, or the
+    /// square root of the diagonal for the separable variant
+    /// </summary>
+    std::vector<double> factor;
+
+    /// <summary>
+    /// The weighted mean of the transformed samples of the selected designs
+    /// </summary>
+    std::vector<double> mean_step_y;
+
+    /// <summary>
+    /// The weighted mean of the normal samples of the selected designs
+    /// </summary>
+    std::vector<double> mean_step_z;
+
+    /// <summary>
+    /// The design indices ordered from the highest to lowest fitness
+    /// </summary>
+    std::vector<size_t> order;
+
+    /// <summary>
+    /// The recombination weights of the selected designs
+    /// </summary>
+    std::vector<double> weights;
+
+    /// <summary>
+    /// The variance effective selection mass
+    /// </summary>
+    double mu_eff;
+
+    /// <summary>
+    /// The learning rate for the covariance evolution path
+    /// </summary>
+    double c_c;
+
+    /// <summary>
+    /// The learning rate for the step size evolution path
+    /// </summary>
+    double c_sigma;
+
+    /// <summary>
+    /// The learning rate for the rank-one covariance update
+    /// </summary>
+    double c_1;
+
+    /// <summary>
+    /// The learning rate for the rank-mu covariance update
+    /// </summary>
+    double c_mu;
+
+    /// <summary>
+    /// The damping for the step size update
+    /// </summary>
+    double damping;
+
+    /// <summary>
+    /// The expected length of a standard normal vector
+    /// </summary>
+    double chi_n;
+
+    /// <summary>
+    /// The step size of the distribution
+    /// </summary>
+    double sigma;
+
+    /// <summary>
+    /// The random number generator
+    /// </summary>
+    std::unique_ptr<RandomSource> random;
+};
+
+#endif
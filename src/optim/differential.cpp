@@ -0,0 +1,233 @@
+#include "optim/differential.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+const double DifferentialOptim::differential_weight = 0.5;
+const double DifferentialOptim::crossover_rate = 0.9;
+
+DifferentialOptim::DifferentialOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    const Strategy strategy,
+    std::unique_ptr<RandomSource> random_source) :
+    num_des_var(num_des_var),
+    strategy(strategy),
+    current_generation(0),
+    targets_evaluated(false),
+    targets(num_designs, num_des_var),
+    trials(num_designs, num_des_var),
+    crossover_values(num_designs * num_des_var, 0.0),
+    random(std::move(random_source))
+{
+    // Check for valid inputs
+    if (num_designs < 4 || num_des_var == 0)
+    {
+        throw std::invalid_argument("population must have at least four designs and design variables must be positive");
+    }
+
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
+    // Initialize the population
+    init_population();
+}
+
+void DifferentialOptim::init_population()
+{
+    // Loop through each design
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        // Define a new random variable for each design variable
+        random->fill_uniform(targets.design(i), num_des_var, lower_bound, upper_bound);
+    }
+
+    targets_evaluated = false;
+    build_trials();
+}
+
+void DifferentialOptim::init_population(const std::vector<double>& other)
+{
+    if (other.size() != design_variable_count())
+    {
+        throw std::invalid_argument("input design variable size does not match between init vector and optimizer");
+    }
+
+    // Loop through each design
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        // Define a new design variable within 25% of the previous value, limiting the results
+        double* desvars = targets.design(i);
+        random->fill_uniform(desvars, num_des_var, -1.0, 1.0);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            desvars[j] = constrain_value(other[j] + 0.25 * desvars[j] * (upper_bound - lower_bound));
+        }
+    }
+
+    targets_evaluated = false;
+    build_trials();
+}
+
+size_t DifferentialOptim::draw_index(
+    const size_t* excluded,
+    const size_t num_excluded)
+{
+    while (true)
+    {
+        const size_t ind = random->next_index(targets.size());
+        if (std::find(excluded, excluded + num_excluded, ind) == excluded + num_excluded)
+        {
+            return ind;
+        }
+    }
+}
+
+void DifferentialOptim::build_trials()
+{
+    const size_t num_designs = targets.size();
+
+    // Evaluate the targets themselves until they have fitness values
+    if (!targets_evaluated)
+    {
+        for (size_t i = 0; i < num_designs; ++i)
+        {
+            std::memcpy(trials.design(i), targets.design(i), num_des_var * sizeof(double));
+        }
+
+        trials.reset_fitness();
+        return;
+    }
+
+    // Determine the fittest target for the current-to-best strategy
+    size_t best_ind = 0;
+    for (size_t i = 1; i < num_designs; ++i)
+    {
+        if (targets.fitness(i) > targets.fitness(best_ind))
+        {
+            best_ind = i;
+        }
+    }
+
+    // Draw the crossover values for the entire population at once
+    random->fill_uniform(crossover_values.data(), crossover_values.size(), 0.0, 1.0);
+
+    const double f = differential_weight;
+
+    for (size_t i = 0; i < num_designs; ++i)
+    {
+        // Select the distinct targets used to form the mutant
+        size_t inds[4] = { i, 0, 0, 0 };
+        inds[1] = draw_index(inds, 1);
+        inds[2] = draw_index(inds, 2);
+        inds[3] = draw_index(inds, 3);
+
+        const double* target = targets.design(i);
+        const double* x1 = targets.design(inds[1]);
+        const double* x2 = targets.design(inds[2]);
+        const double* x3 = targets.design(inds[3]);
+        const double* best = targets.design(best_ind);
+        const double* cross = &crossover_values[i * num_des_var];
+        double* trial = trials.design(i);
+
+        // Force at least one design variable to come from the mutant
+        const size_t forced = random->next_index(num_des_var);
+
+        // Build each design variable from the mutant or the target, selecting
+        // without branches so that the loop runs over contiguous rows
+        if (strategy == Strategy::CURRENT_TO_BEST_1_BIN)
+        {
+            for (size_t j = 0; j < num_des_var; ++j)
+            {
+                const double mutant = target[j] + f * (best[j] - target[j]) + f * (x1[j] - x2[j]);
+                const bool take = cross[j] < crossover_rate || j == forced;
+                trial[j] = constrain_value(take ? mutant : target[j]);
+            }
+        }
+        else
+        {
+            for (size_t j = 0; j < num_des_var; ++j)
+            {
+                const double mutant = x1[j] + f * (x2[j] - x3[j]);
+                const bool take = cross[j] < crossover_rate || j == forced;
+                trial[j] = constrain_value(take ? mutant : target[j]);
+            }
+        }
+    }
+
+    trials.reset_fitness();
+}
+
+void DifferentialOptim::update_designs()
+{
+    if (targets_evaluated)
+    {
+        // Keep each trial that is at least as fit as its target
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            if (trials.fitness(i) >= targets.fitness(i))
+            {
+                std::memcpy(targets.design(i), trials.design(i), num_des_var * sizeof(double));
+                targets.fitness(i) = trials.fitness(i);
+            }
+        }
+    }
+    else
+    {
+        // The trials were the targets, so take their fitness values
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            targets.fitness(i) = trials.fitness(i);
+        }
+
+        targets_evaluated = true;
+    }
+
+    build_trials();
+    current_generation += 1;
+}
+
+const double* DifferentialOptim::get_design(const size_t i) const
+{
+    if (i >= trials.size())
+    {
+        throw std::out_of_range("design index out of range for getting variables");
+    }
+    else
+    {
+        return trials.design(i);
+    }
+}
+
+size_t DifferentialOptim::design_count() const
+{
+    return trials.size();
+}
+
+size_t DifferentialOptim::design_variable_count() const
+{
+    return num_des_var;
+}
+
+void DifferentialOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (ind >= trials.size())
+    {
+        throw std::out_of_range("design index out of range for setting fitness");
+    }
+    else
+    {
+        trials.fitness(ind) = val;
+    }
+}
+
+size_t DifferentialOptim::get_generation() const
+{
+    return current_generation;
+}
@@ -0,0 +1,165 @@
+#ifndef __IO_OPTIM_DIFFERENTIAL__
+#define __IO_OPTIM_DIFFERENTIAL__
+
+#include <memory>
+#include <vector>
+
+#include "optim/optimizer.h"
+#include "optim/population.h"
+#include "optim/random.h"
+
+/// <summary>
+/// DifferentialOptim provides the differential evolution algorithm. Each generation
+/// builds one trial design per target design by adding a scaled difference of other
+/// targets to a base design and crossing the result with the target. A trial replaces
+/// its target when its fitness is at least as high
+/// </summary>
+class DifferentialOptim : public Optimizer
+{
+public:
+    /// <summary>
+    /// Provides options for how the mutant design is formed
+    /// </summary>
+    enum class Strategy
+    {
+        RAND_1_BIN = 0,
+        CURRENT_TO_BEST_1_BIN = 1
+    };
+
+public:
+    /// <summary>
+    /// Constructs the differential evolution optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the number of target designs, at least four</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="strategy">how the mutant design is formed</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    DifferentialOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        const Strategy strategy,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for a given trial design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Provides the count of the current designs
+    /// </summary>
+    /// <returns>the number of designs in the optimization algorithm</returns>
+    virtual size_t design_count() const override;
+
+    /// <summary>
+    /// Provides the count of the design variables
+    /// </summary>
+    /// <returns>the number of design variables in the optimization</returns>
+    virtual size_t design_variable_count() const override;
+
+    /// <summary>
+    /// Sets the fitness score for a given trial design
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Replaces each target by its trial if the trial is at least as fit, and
+    /// builds the next trial designs
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the current generation count for the optimization steps
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Initializes the designs to random values within the upper and lower bound values
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes the designs to random values roughly surrounding
+    /// the given design variables
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+private:
+    /// <summary>
+    /// Builds the trial designs for the entire population from the targets
+    /// </summary>
+    void build_trials();
+
+    /// <summary>
+    /// Draws a target index that differs from each of the excluded indices
+    /// </summary>
+    /// <param name="excluded">the indices to exclude</param>
+    /// <param name="num_excluded">the number of indices to exclude</param>
+    /// <returns>the target index</returns>
+    size_t draw_index(
+        const size_t* excluded,
+        const size_t num_excluded);
+
+private:
+    /// <summary>
+    /// The scale applied to the difference designs
+    /// </summary>
+    static const double differential_weight;
+
+    /// <summary>
+    /// The probability that each design variable is taken from the mutant design
+    /// </summary>
+    static const double crossover_rate;
+
+    /// <summary>
+    /// Storage for the number of design variables in a solution
+    /// </summary>
+    size_t num_des_var;
+
+    /// <summary>
+    /// Defines how the mutant design is formed
+    /// </summary>
+    Strategy strategy;
+
+    /// <summary>
+    /// Storage for the current generation value for the solution
+    /// </summary>
+    size_t current_generation;
+
+    /// <summary>
+    /// Defines whether the targets have fitness values. Until they do, the
+    /// trials are copies of the targets so that the targets are evaluated first
+    /// </summary>
+    bool targets_evaluated;
+
+    /// <summary>
+    /// The target designs and their fitness values
+    /// </summary>
+    Population targets;
+
+    /// <summary>
+    /// The trial designs and their fitness values
+    /// </summary>
+    Population trials;
+
+    /// <summary>
+    /// The uniform random values used for the crossover of the entire population
+    /// </summary>
+    std::vector<double> crossover_values;
+
+    /// <summary>
+    /// The random number generator
+    /// </summary>
+    std::unique_ptr<RandomSource> random;
+};
+
+#endif
@@ -0,0 +1,141 @@
+#include "optim/discrete_genetic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+const double DiscreteGeneticOptim::mutation_probability = 0.02;
+const double DiscreteGeneticOptim::init_probability = 0.25;
+
+DiscreteGeneticOptim::DiscreteGeneticOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    std::unique_ptr<RandomSource> random_source) :
+    GeneticOptim(num_designs, num_des_var, std::move(random_source))
+{
+    // Replace the continuous initial population with discrete values
+    init_population();
+}
+
+void DiscreteGeneticOptim::init_population()
+{
+    // Loop through each design
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        // Define a new random value for each design variable
+        double* desvars = designs.design(i);
+        random->fill_uniform(desvars, num_des_var, 0.0, 1.0);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            desvars[j] = to_discrete(desvars[j], 1.0);
+        }
+    }
+}
+
+void DiscreteGeneticOptim::init_population(const std::vector<double>& other)
+{
+    if (other.size() != design_variable_count())
+    {
+        throw std::invalid_argument("input design variable size does not match between init vector and optimizer");
+    }
+
+    // Loop through each design
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        // Round each design variable, replacing a fraction with random values
+        double* desvars = designs.design(i);
+        random->fill_uniform(desvars, num_des_var, 0.0, 1.0);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            double& desvar = desvars[j];
+
+            if (desvar < init_probability)
+            {
+                desvar = to_discrete(desvar, init_probability);
+            }
+            else
+            {
+                desvar = (other[j] > 0.5) ? 1.0 : ((other[j] < -0.5) ? -1.0 : 0.0);
+            }
+        }
+    }
+}
+
+void DiscreteGeneticOptim::seed_population(
+    const std::vector<std::vector<double>>& seeds,
+    const double spread,
+    const double interpolation_rate)
+{
+    GeneticOptim::seed_population(seeds, spread, interpolation_rate);
+
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        double* desvars = designs.design(i);
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            desvars[j] = (desvars[j] > 0.5) ? 1.0 : ((desvars[j] < -0.5) ? -1.0 : 0.0);
+        }
+    }
+}
+
+void DiscreteGeneticOptim::update_designs()
+{
+    record_generation_stats();
+    update_selection_fitness();
+    select_parents();
+
+    // Perform the sample combinations
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        // Define the two value indices, with the first as the fitter design
+        const size_t ind1 = parent_indices[2 * i];
+        const size_t ind2 = parent_indices[2 * i + 1];
+
+        const bool first_max = designs.fitness(ind1) > designs.fitness(ind2);
+        const size_t ind_max = first_max ? ind1 : ind2;
+        const size_t ind_min = first_max ? ind2 : ind1;
+
+        // Define the probability of taking a value from the better parent
+        const double fit_max = designs.fitness(ind_max);
+        const double w1 = fit_max / std::max(fit_max + designs.fitness(ind_min), 0.01);
+
+        // Obtain the parents and the child to set into the next population
+        const double* val_max = designs.design(ind_max);
+        const double* val_min = designs.design(ind_min);
+        double* child = next_designs.design(i);
+
+        // Draw the mutation and parent selection values for each design variable
+        random->fill_uniform(random_values.data(), 2 * num_des_var, 0.0, 1.0);
+        const double* mutation_vals = &random_values[0];
+        const double* parent_vals = &random_values[num_des_var];
+
+        // Take each design variable from a parent, or replace it with a random value
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            if (mutation_vals[j] < mutation_probability)
+            {
+                child[j] = to_discrete(mutation_vals[j], mutation_probability);
+            }
+            else if (parent_vals[j] < w1)
+            {
+                child[j] = val_max[j];
+            }
+            else
+            {
+                child[j] = val_min[j];
+            }
+        }
+    }
+
+    // Swap to the new population
+    swap_populations();
+}
+
+double DiscreteGeneticOptim::to_discrete(
+    const double val,
+    const double probability)
+{
+    return std::min(std::floor(3.0 * val / probability), 2.0) - 1.0;
+}
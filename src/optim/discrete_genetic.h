@@ -0,0 +1,82 @@
+#ifndef __IO_DISCRETE_GENETIC_OPTIM__
+#define __IO_DISCRETE_GENETIC_OPTIM__
+
+#include "optim/genetic.h"
+
+/// <summary>
+/// DiscreteGeneticOptim provides a genetic optimization algorithm where each
+/// design variable is constrained to one of -1, 0 or +1, for use with ternary networks
+/// </summary>
+class DiscreteGeneticOptim : public GeneticOptim
+{
+public:
+    /// <summary>
+    /// Constructs the Discrete Genetic Optimization algorithm
+    /// </summary>
+    /// <param name="num_population">the size of the population to use</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    DiscreteGeneticOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Updates the designs by taking each design variable from one of the two parents,
+    /// favoring the parent with the higher fitness, and replacing a small fraction of
+    /// design variables with a random value
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Initializes the population to random values of -1, 0 or +1
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes the population to the given design variables, rounded to the
+    /// nearest of -1, 0 and +1, with a fraction of values replaced by a random value
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Initializes the population from several seed designs, rounding each design
+    /// variable to the nearest of -1, 0 and +1
+    /// </summary>
+    /// <param name="seeds">the seed design variables, ordered from the most preferred</param>
+    /// <param name="spread">the largest random offset, as a fraction of the design range</param>
+    /// <param name="interpolation_rate">the probability that a design is interpolated between two seeds</param>
+    virtual void seed_population(
+        const std::vector<std::vector<double>>& seeds,
+        const double spread,
+        const double interpolation_rate) override;
+
+protected:
+    /// <summary>
+    /// Converts a uniform random value in [0, probability) to a random value
+    /// of -1, 0 or +1, so that the value used to decide whether to replace a
+    /// design variable also provides the replacement
+    /// </summary>
+    /// <param name="val">the uniform random value</param>
+    /// <param name="probability">the upper bound of the random value</param>
+    /// <returns>the random design variable value</returns>
+    static double to_discrete(
+        const double val,
+        const double probability);
+
+protected:
+    /// <summary>
+    /// The probability that a design variable is replaced by a random value on each update
+    /// </summary>
+    static const double mutation_probability;
+
+    /// <summary>
+    /// The probability that a design variable is replaced by a random value when
+    /// initializing around another design
+    /// </summary>
+    static const double init_probability;
+};
+
+#endif
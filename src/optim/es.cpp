@@ -0,0 +1,236 @@
+#include "optim/es.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+const double EsOptim::noise_std = 0.5;
+const double EsOptim::learning_rate = 0.1;
+const double EsOptim::beta_1 = 0.9;
+const double EsOptim::beta_2 = 0.999;
+
+EsOptim::EsOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    std::unique_ptr<RandomSource> random_source) :
+    num_des_var(num_des_var),
+    current_generation(0),
+    updates_since_reset(0),
+    designs(num_designs, num_des_var),
+    seeds(num_designs / 2, 0),
+    mean(num_des_var, 0.0),
+    gradient(num_des_var, 0.0),
+    moment_1(num_des_var, 0.0),
+    moment_2(num_des_var, 0.0),
+    noise(num_des_var, 0.0),
+    order(num_designs, 0),
+    shaped_fitness(num_designs, 0.0),
+    random(std::move(random_source))
+{
+    // Check for valid inputs
+    if (num_designs == 0 || num_designs % 2 != 0 || num_des_var == 0)
+    {
+        throw std::invalid_argument("population must be a positive even number and design variables must be positive");
+    }
+
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
+    // Define the initial mean and designs
+    init_population();
+}
+
+void EsOptim::init_population()
+{
+    std::fill(mean.begin(), mean.end(), 0.5 * (lower_bound + upper_bound));
+    std::fill(moment_1.begin(), moment_1.end(), 0.0);
+    std::fill(moment_2.begin(), moment_2.end(), 0.0);
+    updates_since_reset = 0;
+
+    sample_designs();
+}
+
+void EsOptim::init_population(const std::vector<double>& other)
+{
+    if (other.size() != design_variable_count())
+    {
+        throw std::invalid_argument("input design variable size does not match between init vector and optimizer");
+    }
+
+    for (size_t j = 0; j < num_des_var; ++j)
+    {
+        mean[j] = constrain_value(other[j]);
+    }
+
+    std::fill(moment_1.begin(), moment_1.end(), 0.0);
+    std::fill(moment_2.begin(), moment_2.end(), 0.0);
+    updates_since_reset = 0;
+
+    sample_designs();
+}
+
+void EsOptim::fill_noise(
+    const uint64_t seed,
+    double* values,
+    const size_t count)
+{
+    Xoshiro256Random noise_random(seed);
+    noise_random.fill_normal(values, count, 0.0, noise_std);
+}
+
+void EsOptim::generate_design(
+    const std::vector<double>& mean,
+    const uint64_t seed,
+    const bool negate,
+    double* design)
+{
+    fill_noise(seed, design, mean.size());
+
+    const double sign = negate ? -1.0 : 1.0;
+    for (size_t j = 0; j < mean.size(); ++j)
+    {
+        design[j] = constrain_value(mean[j] + sign * design[j]);
+    }
+}
+
+void EsOptim::sample_designs()
+{
+    for (size_t p = 0; p < seeds.size(); ++p)
+    {
+        seeds[p] = static_cast<uint64_t>(random->next_index(std::numeric_limits<size_t>::max()));
+
+        // Generate the perturbation once and mirror it for the second design
+        double* plus = designs.design(2 * p);
+        double* minus = designs.design(2 * p + 1);
+        fill_noise(seeds[p], noise.data(), num_des_var);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            plus[j] = constrain_value(mean[j] + noise[j]);
+            minus[j] = constrain_value(mean[j] - noise[j]);
+        }
+    }
+
+    designs.reset_fitness();
+}
+
+void EsOptim::update_designs()
+{
+    const size_t num_designs = designs.size();
+
+    // Shape the fitness values by rank, centered on zero, so that the update is
+    // insensitive to the scale of the fitness and to outliers
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](const size_t i1, const size_t i2)
+    {
+        return designs.fitness(i1) < designs.fitness(i2);
+    });
+
+    for (size_t r = 0; r < num_designs; ++r)
+    {
+        shaped_fitness[order[r]] = static_cast<double>(r) / static_cast<double>(num_designs - 1) - 0.5;
+    }
+
+    // Estimate the search gradient from the fitness difference of each mirrored
+    // pair, regenerating the perturbation from its seed
+    std::fill(gradient.begin(), gradient.end(), 0.0);
+
+    for (size_t p = 0; p < seeds.size(); ++p)
+    {
+        const double diff = shaped_fitness[2 * p] - shaped_fitness[2 * p + 1];
+        if (diff == 0.0)
+        {
+            continue;
+        }
+
+        fill_noise(seeds[p], noise.data(), num_des_var);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            gradient[j] += diff * noise[j];
+        }
+    }
+
+    const double gradient_scale = 1.0 / (static_cast<double>(num_designs) * noise_std * noise_std);
+
+    // Step the mean with the bias-corrected Adam update
+    updates_since_reset += 1;
+    const double correction_1 = 1.0 - std::pow(beta_1, static_cast<double>(updates_since_reset));
+    const double correction_2 = 1.0 - std::pow(beta_2, static_cast<double>(updates_since_reset));
+    const double step = learning_rate * std::sqrt(correction_2) / correction_1;
+
+    for (size_t j = 0; j < num_des_var; ++j)
+    {
+        const double g = gradient_scale * gradient[j];
+        moment_1[j] = beta_1 * moment_1[j] + (1.0 - beta_1) * g;
+        moment_2[j] = beta_2 * moment_2[j] + (1.0 - beta_2) * g * g;
+        mean[j] = constrain_value(mean[j] + step * moment_1[j] / (std::sqrt(moment_2[j]) + 1e-8));
+    }
+
+    // Sample the next designs
+    sample_designs();
+
+    current_generation += 1;
+}
+
+const double* EsOptim::get_design(const size_t i) const
+{
+    if (i >= designs.size())
+    {
+        throw std::out_of_range("design index out of range for getting variables");
+    }
+    else
+    {
+        return designs.design(i);
+    }
+}
+
+size_t EsOptim::design_count() const
+{
+    return designs.size();
+}
+
+size_t EsOptim::design_variable_count() const
+{
+    return num_des_var;
+}
+
+void EsOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (ind >= designs.size())
+    {
+        throw std::out_of_range("design index out of range for setting fitness");
+    }
+    else
+    {
+        designs.fitness(ind) = val;
+    }
+}
+
+size_t EsOptim::get_generation() const
+{
+    return current_generation;
+}
+
+const std::vector<double>& EsOptim::get_mean() const
+{
+    return mean;
+}
+
+uint64_t EsOptim::get_design_seed(const size_t i) const
+{
+    if (i >= designs.size())
+    {
+        throw std::out_of_range("design index out of range for getting the seed");
+    }
+    else
+    {
+        return seeds[i / 2];
+    }
+}
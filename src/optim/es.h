@@ -0,0 +1,216 @@
+#ifndef __IO_OPTIM_ES__
+#define __IO_OPTIM_ES__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "optim/optimizer.h"
+#include "optim/population.h"
+#include "optim/random.h"
+
+/// <summary>
+/// EsOptim provides a natural evolution strategy that estimates a search gradient
+/// around a single mean design. Designs are sampled in mirrored pairs, the mean plus
+/// and minus the same normal perturbation, and the fitness values are shaped by rank
+/// before being used to step the mean with the Adam update. Each perturbation is
+/// regenerated from its seed rather than stored, so that a design is fully described
+/// by the mean, its seed and its sign
+/// </summary>
+class EsOptim : public Optimizer
+{
+public:
+    /// <summary>
+    /// Constructs the evolution strategy optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the number of designs sampled in each generation, a positive even number</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="random_source">the random number generator used to draw the seeds,
+    /// or nullptr to use a Xoshiro256Random with a fixed seed</param>
+    EsOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for a given design, limited to the bounds
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Provides the count of the current designs
+    /// </summary>
+    /// <returns>the number of designs in the optimization algorithm</returns>
+    virtual size_t design_count() const override;
+
+    /// <summary>
+    /// Provides the count of the design variables
+    /// </summary>
+    /// <returns>the number of design variables in the optimization</returns>
+    virtual size_t design_variable_count() const override;
+
+    /// <summary>
+    /// Sets the fitness score for a given design
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Steps the mean along the estimated search gradient and samples the next designs
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the current generation count for the optimization steps
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Resets the mean to the center of the design space and samples new designs
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Resets the mean to the given design variables and samples new designs
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Provides the current mean design variables
+    /// </summary>
+    /// <returns>the mean</returns>
+    const std::vector<double>& get_mean() const;
+
+    /// <summary>
+    /// Provides the seed of the perturbation for a given design. Even designs add
+    /// the perturbation to the mean, and odd designs subtract it
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>the perturbation seed</returns>
+    uint64_t get_design_seed(const size_t i) const;
+
+    /// <summary>
+    /// Regenerates a design from the mean and the seed of its perturbation
+    /// </summary>
+    /// <param name="mean">the mean design variables</param>
+    /// <param name="seed">the perturbation seed</param>
+    /// <param name="negate">true to subtract the perturbation from the mean</param>
+    /// <param name="design">the mean.size() design variables to set, limited to the bounds</param>
+    static void generate_design(
+        const std::vector<double>& mean,
+        const uint64_t seed,
+        const bool negate,
+        double* design);
+
+private:
+    /// <summary>
+    /// Draws a new seed for each pair of designs and samples the designs
+    /// </summary>
+    void sample_designs();
+
+    /// <summary>
+    /// Fills the buffer with the perturbation for the given seed
+    /// </summary>
+    /// <param name="seed">the perturbation seed</param>
+    /// <param name="values">the buffer to fill</param>
+    /// <param name="count">the number of values to fill</param>
+    static void fill_noise(
+        const uint64_t seed,
+        double* values,
+        const size_t count);
+
+private:
+    /// <summary>
+    /// The standard deviation of the perturbations
+    /// </summary>
+    static const double noise_std;
+
+    /// <summary>
+    /// The step size of the Adam update
+    /// </summary>
+    static const double learning_rate;
+
+    /// <summary>
+    /// The decay rate of the first moment in the Adam update
+    /// </summary>
+    static const double beta_1;
+
+    /// <summary>
+    /// The decay rate of the second moment in the Adam update
+    /// </summary>
+    static const double beta_2;
+
+    /// <summary>
+    /// Storage for the number of design variables in a solution
+    /// </summary>
+    size_t num_des_var;
+
+    /// <summary>
+    /// Storage for the current generation value for the solution
+    /// </summary>
+    size_t current_generation;
+
+    /// <summary>
+    /// The number of Adam updates since the last reset, used for the bias correction
+    /// </summary>
+    size_t updates_since_reset;
+
+    /// <summary>
+    /// The sampled designs, limited to the bounds, and their fitness values
+    /// </summary>
+    Population designs;
+
+    /// <summary>
+    /// The perturbation seed for each pair of designs
+    /// </summary>
+    std::vector<uint64_t> seeds;
+
+    /// <summary>
+    /// The mean design variables
+    /// </summary>
+    std::vector<double> mean;
+
+    /// <summary>
+    /// The estimated search gradient
+    /// </summary>
+    std::vector<double> gradient;
+
+    /// <summary>
+    /// The first moment of the gradient for the Adam update
+    /// </summary>
+    std::vector<double> moment_1;
+
+    /// <summary>
+    /// The second moment of the gradient for the Adam update
+    /// </summary>
+    std::vector<double> moment_2;
+
+    /// <summary>
+    /// The buffer used to regenerate each perturbation
+    /// </summary>
+    std::vector<double> noise;
+
+    /// <summary>
+    /// The design indices ordered from the lowest to highest fitness
+    /// </summary>
+    std::vector<size_t> order;
+
+    /// <summary>
+    /// The rank-shaped fitness of each design
+    /// </summary>
+    std::vector<double> shaped_fitness;
+
+    /// <summary>
+    /// The random number generator used to draw the seeds
+    /// </summary>
+    std::unique_ptr<RandomSource> random;
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include "optim/evaluation_schedule.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+EvaluationSchedule::EvaluationSchedule(
+    const size_t num_designs,
+    const size_t num_tracks) :
+    num_tracks(num_tracks),
+    active_designs(num_designs, 0),
+    distance_sums(num_designs, 0.0),
+    episode_counts(num_designs, 0),
+    track_caps(num_tracks + 1, 0.0)
+{
+    // Check for valid inputs
+    if (num_designs == 0 || num_tracks == 0)
+    {
+        throw std::invalid_argument("designs and tracks must be positive for the evaluation schedule");
+    }
+
+    start_generation();
+}
+
+void EvaluationSchedule::start_generation()
+{
+    active_designs.resize(distance_sums.size());
+    std::iota(active_designs.begin(), active_designs.end(), 0);
+    std::fill(distance_sums.begin(), distance_sums.end(), 0.0);
+    std::fill(episode_counts.begin(), episode_counts.end(), 0);
+    std::fill(track_caps.begin(), track_caps.end(), std::numeric_limits<double>::max());
+
+    active_index = 0;
+    track = 0;
+    generation_episodes = 0;
+}
+
+size_t EvaluationSchedule::current_design() const
+{
+    return active_designs[active_index];
+}
+
+size_t EvaluationSchedule::current_track() const
+{
+    return track;
+}
+
+void EvaluationSchedule::report(const double distance)
+{
+    const size_t design = current_design();
+    distance_sums[design] += distance;
+    episode_counts[design] += 1;
+    generation_episodes += 1;
+}
+
+bool EvaluationSchedule::advance()
+{
+    active_index += 1;
+    if (active_index < active_designs.size())
+    {
+        return true;
+    }
+
+    // Complete the generation once every track has been used
+    track += 1;
+    if (track >= num_tracks)
+    {
+        last_generation_episodes = generation_episodes;
+        update_track_caps();
+        return false;
+    }
+
+    // Advance the better half of the designs to the next track
+    std::stable_sort(active_designs.begin(), active_designs.end(), [this](const size_t i1, const size_t i2)
+    {
+        return mean_distance(i1) > mean_distance(i2);
+    });
+
+    active_designs.resize((active_designs.size() + 1) / 2);
+    active_index = 0;
+
+    return true;
+}
+
+double EvaluationSchedule::get_fitness(const size_t design) const
+{
+    return std::min(mean_distance(design), track_caps[episode_counts.at(design)]);
+}
+
+size_t EvaluationSchedule::get_episode_count() const
+{
+    return last_generation_episodes;
+}
+
+double EvaluationSchedule::mean_distance(const size_t design) const
+{
+    if (episode_counts[design] == 0)
+    {
+        return 0.0;
+    }
+    else
+    {
+        return distance_sums[design] / static_cast<double>(episode_counts[design]);
+    }
+}
+
+void EvaluationSchedule::update_track_caps()
+{
+    // Find the lowest mean distance of the designs evaluated on each number of tracks
+    std::vector<double> lowest_means(num_tracks + 1, std::numeric_limits<double>::max());
+    for (size_t i = 0; i < distance_sums.size(); ++i)
+    {
+        lowest_means[episode_counts[i]] = std::min(lowest_means[episode_counts[i]], mean_distance(i));
+    }
+
+    // Cap the designs cut after each track at the lowest capped fitness of the designs
+    // that advanced, so that a design cut early never outranks one that advanced
+    track_caps[num_tracks] = std::numeric_limits<double>::max();
+    for (size_t k = num_tracks; k > 0; --k)
+    {
+        track_caps[k - 1] = std::min(track_caps[k], lowest_means[k]);
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef __IO_OPTIM_EVALUATION_SCHEDULE__
+#define __IO_OPTIM_EVALUATION_SCHEDULE__
+
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// EvaluationSchedule orders the episodes of a generation by successive halving
+/// across tracks. Every design is first evaluated on the first track, then the
+/// better half of the designs advances to the next track, and so on, so that the
+/// number of episodes per generation stays below twice the number of designs for
+/// any number of tracks. The fitness of each design is its mean distance over the
+/// tracks it was evaluated on, capped so that every design cut after a track ranks
+/// below every design that advanced past it
+/// </summary>
+class EvaluationSchedule
+{
+public:
+    /// <summary>
+    /// Constructs the evaluation schedule and starts the first generation
+    /// </summary>
+    /// <param name="num_designs">the number of designs in each generation</param>
+    /// <param name="num_tracks">the number of tracks to evaluate on</param>
+    EvaluationSchedule(
+        const size_t num_designs,
+        const size_t num_tracks);
+
+    /// <summary>
+    /// Starts a new generation, with every design evaluated on the first track
+    /// </summary>
+    void start_generation();
+
+    /// <summary>
+    /// Provides the design of the current episode
+    /// </summary>
+    /// <returns>the design index</returns>
+    size_t current_design() const;
+
+    /// <summary>
+    /// Provides the track of the current episode
+    /// </summary>
+    /// <returns>the track index</returns>
+    size_t current_track() const;
+
+    /// <summary>
+    /// Records the distance of the current episode
+    /// </summary>
+    /// <param name="distance">the distance traveled</param>
+    void report(const double distance);
+
+    /// <summary>
+    /// Moves to the next episode, halving the designs once each track is complete
+    /// </summary>
+    /// <returns>false if the generation is complete</returns>
+    bool advance();
+
+    /// <summary>
+    /// Provides the fitness of a design once the generation is complete, as the mean
+    /// distance over the tracks it was evaluated on, capped at the lowest fitness of
+    /// the designs evaluated on more tracks
+    /// </summary>
+    /// <param name="design">the design index</param>
+    /// <returns>the fitness</returns>
+    double get_fitness(const size_t design) const;
+
+    /// <summary>
+    /// Provides the number of episodes in the last complete generation
+    /// </summary>
+    /// <returns>the episode count</returns>
+    size_t get_episode_count() const;
+
+private:
+    /// <summary>
+    /// Provides the mean distance of a design over the tracks it was evaluated on
+    /// </summary>
+    /// <param name="design">the design index</param>
+    /// <returns>the mean distance, or zero if the design has not been evaluated</returns>
+    double mean_distance(const size_t design) const;
+
+    /// <summary>
+    /// Sets the fitness cap for each number of tracks evaluated, from the designs that
+    /// advanced furthest down to those cut after the first track
+    /// </summary>
+    void update_track_caps();
+
+private:
+    /// <summary>
+    /// The number of tracks to evaluate on
+    /// </summary>
+    size_t num_tracks;
+
+    /// <summary>
+    /// The designs evaluated on the current track, ordered by fitness once the track is complete
+    /// </summary>
+    std::vector<size_t> active_designs;
+
+    /// <summary>
+    /// The position of the current episode in the active designs
+    /// </summary>
+    size_t active_index = 0;
+
+    /// <summary>
+    /// The current track
+    /// </summary>
+    size_t track = 0;
+
+    /// <summary>
+    /// The summed distance of each design
+    /// </summary>
+    std::vector<double> distance_sums;
+
+    /// <summary>
+    /// The number of tracks each design has been evaluated on
+    /// </summary>
+    std::vector<size_t> episode_counts;
+
+    /// <summary>
+    /// The highest fitness of a design by the number of tracks it was evaluated on
+    /// </summary>
+    std::vector<double> track_caps;
+
+    /// <summary>
+    /// The episode counts of the current and last complete generations
+    /// </summary>
+    size_t generation_episodes = 0;
+    size_t last_generation_episodes = 0;
+};
+
+#endif
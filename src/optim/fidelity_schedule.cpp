@@ -0,0 +1,154 @@
+#include "optim/fidelity_schedule.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+FidelitySchedule::FidelitySchedule(
+    const size_t num_designs,
+    const double promote_fraction) :
+    num_promoted(0),
+    screening_scores(num_designs, 0.0),
+    full_scores(num_designs, 0.0),
+    promoted(num_designs, false)
+{
+    // Check for valid inputs
+    if (num_designs == 0)
+    {
+        throw std::invalid_argument("designs must be positive for the fidelity schedule");
+    }
+    else if (!(promote_fraction > 0.0 && promote_fraction <= 1.0))
+    {
+        throw std::invalid_argument("promoted fraction must be in (0, 1]");
+    }
+
+    // Promote at least one design
+    num_promoted = std::min(num_designs, std::max<size_t>(1, static_cast<size_t>(std::ceil(promote_fraction * static_cast<double>(num_designs)))));
+
+    start_generation();
+}
+
+void FidelitySchedule::start_generation()
+{
+    active_designs.resize(screening_scores.size());
+    std::iota(active_designs.begin(), active_designs.end(), 0);
+    std::fill(screening_scores.begin(), screening_scores.end(), 0.0);
+    std::fill(full_scores.begin(), full_scores.end(), 0.0);
+    std::fill(promoted.begin(), promoted.end(), false);
+
+    active_index = 0;
+    screening = true;
+    min_promoted_score = 0.0;
+}
+
+size_t FidelitySchedule::current_design() const
+{
+    return active_designs[active_index];
+}
+
+bool FidelitySchedule::is_screening() const
+{
+    return screening;
+}
+
+void FidelitySchedule::report(const double score)
+{
+    if (screening)
+    {
+        screening_scores[current_design()] = score;
+    }
+    else
+    {
+        full_scores[current_design()] = score;
+    }
+}
+
+bool FidelitySchedule::advance()
+{
+    active_index += 1;
+    if (active_index < active_designs.size())
+    {
+        return true;
+    }
+
+    // Promote the best screened designs to full fidelity
+    if (screening)
+    {
+        std::stable_sort(active_designs.begin(), active_designs.end(), [this](const size_t i1, const size_t i2)
+        {
+            return screening_scores[i1] > screening_scores[i2];
+        });
+
+        active_designs.resize(num_promoted);
+        for (const size_t design : active_designs)
+        {
+            promoted[design] = true;
+        }
+
+        active_index = 0;
+        screening = false;
+
+        return true;
+    }
+
+    // Complete the generation, comparing the fidelities of the promoted designs
+    min_promoted_score = full_scores[active_designs.front()];
+
+    double mean_screening = 0.0;
+    double mean_full = 0.0;
+
+    for (const size_t design : active_designs)
+    {
+        min_promoted_score = std::min(min_promoted_score, full_scores[design]);
+        mean_screening += screening_scores[design];
+        mean_full += full_scores[design];
+    }
+
+    mean_screening /= static_cast<double>(active_designs.size());
+    mean_full /= static_cast<double>(active_designs.size());
+
+    double cov = 0.0;
+    double var_screening = 0.0;
+    double var_full = 0.0;
+
+    for (const size_t design : active_designs)
+    {
+        const double d_screening = screening_scores[design] - mean_screening;
+        const double d_full = full_scores[design] - mean_full;
+        cov += d_screening * d_full;
+        var_screening += d_screening * d_screening;
+        var_full += d_full * d_full;
+    }
+
+    correlation = (var_screening > 0.0 && var_full > 0.0) ? cov / std::sqrt(var_screening * var_full) : 0.0;
+
+    return false;
+}
+
+double FidelitySchedule::get_fitness(const size_t design) const
+{
+    if (promoted.at(design))
+    {
+        return full_scores[design];
+    }
+    else
+    {
+        return std::min(screening_scores[design], min_promoted_score);
+    }
+}
+
+size_t FidelitySchedule::get_promoted_count() const
+{
+    return num_promoted;
+}
+
+size_t FidelitySchedule::get_episode_count() const
+{
+    return screening_scores.size() + num_promoted;
+}
+
+double FidelitySchedule::get_correlation() const
+{
+    return correlation;
+}
@@ -0,0 +1,126 @@
+#ifndef __IO_OPTIM_FIDELITY_SCHEDULE__
+#define __IO_OPTIM_FIDELITY_SCHEDULE__
+
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// FidelitySchedule orders the episodes of a generation across two simulation
+/// fidelities. Every design is first screened at low fidelity, and then the fraction
+/// of the designs with the best screening scores is promoted and simulated again at
+/// full fidelity. Promoted designs take their full fidelity score as the fitness, and
+/// the other designs keep their screening score, limited to the lowest promoted score
+/// so that no screened-out design ranks above a finalist
+/// </summary>
+class FidelitySchedule
+{
+public:
+    /// <summary>
+    /// Constructs the fidelity schedule and starts the first generation
+    /// </summary>
+    /// <param name="num_designs">the number of designs in each generation</param>
+    /// <param name="promote_fraction">the fraction of the designs promoted to full fidelity, in (0, 1]</param>
+    FidelitySchedule(
+        const size_t num_designs,
+        const double promote_fraction);
+
+    /// <summary>
+    /// Starts a new generation, with every design screened at low fidelity
+    /// </summary>
+    void start_generation();
+
+    /// <summary>
+    /// Provides the design of the current episode
+    /// </summary>
+    /// <returns>the design index</returns>
+    size_t current_design() const;
+
+    /// <summary>
+    /// Determines whether the current episode is screened at low fidelity
+    /// </summary>
+    /// <returns>true for screening episodes, false for full fidelity episodes</returns>
+    bool is_screening() const;
+
+    /// <summary>
+    /// Records the score of the current episode
+    /// </summary>
+    /// <param name="score">the distance traveled</param>
+    void report(const double score);
+
+    /// <summary>
+    /// Moves to the next episode, promoting the best screened designs once every
+    /// design has been screened
+    /// </summary>
+    /// <returns>false if the generation is complete</returns>
+    bool advance();
+
+    /// <summary>
+    /// Provides the fitness of a design in the current generation
+    /// </summary>
+    /// <param name="design">the design index</param>
+    /// <returns>the fitness</returns>
+    double get_fitness(const size_t design) const;
+
+    /// <summary>
+    /// Provides the number of designs promoted to full fidelity each generation
+    /// </summary>
+    /// <returns>the promoted design count</returns>
+    size_t get_promoted_count() const;
+
+    /// <summary>
+    /// Provides the number of episodes in each generation
+    /// </summary>
+    /// <returns>the episode count, at both fidelities</returns>
+    size_t get_episode_count() const;
+
+    /// <summary>
+    /// Provides the correlation between the screening and full fidelity scores of the
+    /// promoted designs in the last complete generation
+    /// </summary>
+    /// <returns>the Pearson correlation, or zero if it is not defined</returns>
+    double get_correlation() const;
+
+private:
+    /// <summary>
+    /// The number of designs promoted to full fidelity
+    /// </summary>
+    size_t num_promoted;
+
+    /// <summary>
+    /// The designs simulated at the current fidelity
+    /// </summary>
+    std::vector<size_t> active_designs;
+
+    /// <summary>
+    /// The position of the current episode in the active designs
+    /// </summary>
+    size_t active_index = 0;
+
+    /// <summary>
+    /// Defines whether the current episodes are screened at low fidelity
+    /// </summary>
+    bool screening = true;
+
+    /// <summary>
+    /// The screening and full fidelity scores of each design
+    /// </summary>
+    std::vector<double> screening_scores;
+    std::vector<double> full_scores;
+
+    /// <summary>
+    /// Defines whether each design was promoted in the current generation
+    /// </summary>
+    std::vector<bool> promoted;
+
+    /// <summary>
+    /// The lowest full fidelity score of the promoted designs
+    /// </summary>
+    double min_promoted_score = 0.0;
+
+    /// <summary>
+    /// The correlation of the last complete generation
+    /// </summary>
+    double correlation = 0.0;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "optim/fitness_cache.h"
+
+#include <cstring>
+
+// Defines the FNV-1a parameters used to hash the design bits
+static const uint64_t fnv_offset = 14695981039346656037ULL;
+static const uint64_t fnv_prime = 1099511628211ULL;
+
+// Adds the bytes of the given value into the FNV-1a hash
+static void hash_value(
+    uint64_t& hash,
+    const uint64_t val)
+{
+    for (size_t b = 0; b < sizeof(val); ++b)
+    {
+        hash ^= (val >> (8 * b)) & 0xFF;
+        hash *= fnv_prime;
+    }
+}
+
+FitnessCache::FitnessCache(const size_t max_entries) :
+    max_entries(max_entries)
+{
+    // Empty Constructor
+}
+
+uint64_t FitnessCache::design_key(
+    const double* design,
+    const size_t count,
+    const size_t track_id)
+{
+    uint64_t hash = fnv_offset;
+    hash_value(hash, static_cast<uint64_t>(track_id));
+    hash_value(hash, static_cast<uint64_t>(count));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Treat negative zero as zero, as both produce the same network
+        const double val = (design[i] == 0.0) ? 0.0 : design[i];
+
+        uint64_t bits;
+        std::memcpy(&bits, &val, sizeof(bits));
+        hash_value(hash, bits);
+    }
+
+    return hash;
+}
+
+bool FitnessCache::lookup(
+    const uint64_t key,
+    double& fitness)
+{
+    lookups += 1;
+
+    const auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        return false;
+    }
+    else
+    {
+        hits += 1;
+        fitness = it->second;
+        return true;
+    }
+}
+
+void FitnessCache::insert(
+    const uint64_t key,
+    const double fitness)
+{
+    if (entries.size() >= max_entries)
+    {
+        entries.clear();
+    }
+
+    entries[key] = fitness;
+}
+
+void FitnessCache::end_generation()
+{
+    last_lookups = lookups;
+    last_hits = hits;
+    lookups = 0;
+    hits = 0;
+}
+
+double FitnessCache::get_last_hit_rate() const
+{
+    if (last_lookups == 0)
+    {
+        return 0.0;
+    }
+    else
+    {
+        return static_cast<double>(last_hits) / static_cast<double>(last_lookups);
+    }
+}
+
+size_t FitnessCache::size() const
+{
+    return entries.size();
+}
@@ -0,0 +1,97 @@
+#ifndef __IO_OPTIM_FITNESS_CACHE__
+#define __IO_OPTIM_FITNESS_CACHE__
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+/// <summary>
+/// FitnessCache stores the fitness of evaluated designs, keyed by a hash of the
+/// design variable bits and the track, so that a design which has already been
+/// simulated on a track does not need to be simulated again. Lookups are counted
+/// for each generation to report the hit rate
+/// </summary>
+class FitnessCache
+{
+public:
+    /// <summary>
+    /// Constructs the fitness cache
+    /// </summary>
+    /// <param name="max_entries">the number of entries to hold before the cache is cleared</param>
+    FitnessCache(const size_t max_entries);
+
+    /// <summary>
+    /// Provides the cache key for a design on a track, hashing the bits of each
+    /// design variable so that only identical designs share a key
+    /// </summary>
+    /// <param name="design">the design variables</param>
+    /// <param name="count">the number of design variables</param>
+    /// <param name="track_id">the track the design is evaluated on</param>
+    /// <returns>the cache key</returns>
+    static uint64_t design_key(
+        const double* design,
+        const size_t count,
+        const size_t track_id);
+
+    /// <summary>
+    /// Looks up the fitness for a key, counting the lookup for the current generation
+    /// </summary>
+    /// <param name="key">the cache key</param>
+    /// <param name="fitness">set to the cached fitness if found</param>
+    /// <returns>true if the key was found</returns>
+    bool lookup(
+        const uint64_t key,
+        double& fitness);
+
+    /// <summary>
+    /// Adds the fitness for a key, clearing the cache first if it is full
+    /// </summary>
+    /// <param name="key">the cache key</param>
+    /// <param name="fitness">the fitness value</param>
+    void insert(
+        const uint64_t key,
+        const double fitness);
+
+    /// <summary>
+    /// Ends the current generation, keeping its lookup counts for the hit rate
+    /// report and resetting the counts for the next generation
+    /// </summary>
+    void end_generation();
+
+    /// <summary>
+    /// Provides the fraction of lookups found in the cache during the last generation
+    /// </summary>
+    /// <returns>the hit rate, or zero if there were no lookups</returns>
+    double get_last_hit_rate() const;
+
+    /// <summary>
+    /// Provides the number of entries in the cache
+    /// </summary>
+    /// <returns>the entry count</returns>
+    size_t size() const;
+
+private:
+    /// <summary>
+    /// The number of entries to hold before the cache is cleared
+    /// </summary>
+    size_t max_entries;
+
+    /// <summary>
+    /// The fitness for each cache key
+    /// </summary>
+    std::unordered_map<uint64_t, double> entries;
+
+    /// <summary>
+    /// The lookup and hit counts for the current generation
+    /// </summary>
+    size_t lookups = 0;
+    size_t hits = 0;
+
+    /// <summary>
+    /// The lookup and hit counts for the last generation
+    /// </summary>
+    size_t last_lookups = 0;
+    size_t last_hits = 0;
+};
+
+#endif
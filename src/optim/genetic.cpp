@@ -1,32 +1,48 @@
 #include "optim/genetic.h"
+#include "optim/genome_distance.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
 #include <stdexcept>
 
-static const double bound_value = 10.0;
+const double GeneticOptim::min_step_size = 1e-4;
+const double GeneticOptim::max_step_size = 0.5;
 
-const double GeneticOptim::lower_bound = -bound_value;
-const double GeneticOptim::upper_bound = bound_value;
-
-GeneticOptim::OptimStatus::OptimStatus(const size_t num_vars) :
-    design_variables(num_vars, 0.0),
-    fitness(0.0)
-{
-    // Empty Constructor
-}
-
-void GeneticOptim::OptimStatus::reset()
+// Provides the quantile of sorted values, interpolating linearly between ranks
+static double sorted_quantile(
+    const std::vector<double>& values,
+    const double q)
 {
-    fitness = 0.0;
+    const double pos = q * static_cast<double>(values.size() - 1);
+    const size_t lower = static_cast<size_t>(pos);
+    const size_t upper = std::min(lower + 1, values.size() - 1);
+    const double frac = pos - static_cast<double>(lower);
+    return (1.0 - frac) * values[lower] + frac * values[upper];
 }
 
 GeneticOptim::GeneticOptim(
     const size_t num_designs,
-    const size_t num_des_var) :
-    designs(num_designs, OptimStatus(num_des_var)),
-    generator(0),
-    distribution(lower_bound, upper_bound),
-    mutation_distribution(-1.0, 1.0),
-    index_distribution(0, num_designs - 1),
+    const size_t num_des_var,
+    std::unique_ptr<RandomSource> random_source) :
+    designs(num_designs, num_des_var),
+    next_designs(num_designs, num_des_var),
+    parent_indices(num_designs * 2, 0),
+    random(std::move(random_source)),
+    random_values(num_des_var * 2, 0.0),
+    mutation_rate(1.0),
+    mutation_distribution(MutationDistribution::UNIFORM),
+    mutation_scale(0.05),
+    self_adaptive(false),
+    step_learning_rate(1.0 / std::sqrt(static_cast<double>(num_des_var))),
+    elite_count(0),
+    elite_order(num_designs, 0),
+    sharing_radius(0.0),
+    selection_fitness(num_designs, 0.0),
+    stats_values(num_designs, 0.0),
+    stats_sums(num_des_var, 0.0),
+    stats_square_sums(num_des_var, 0.0),
     num_des_var(num_des_var),
     current_generation(0)
 {
@@ -36,21 +52,87 @@ GeneticOptim::GeneticOptim(
         throw std::invalid_argument("population and design variables must be positive");
     }
 
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
     // Define the random initial population values
     init_population();
 }
 
+void GeneticOptim::set_mutation(
+    const double rate,
+    const MutationDistribution distribution,
+    const double scale)
+{
+    if (!(rate > 0.0 && rate <= 1.0))
+    {
+        throw std::invalid_argument("mutation rate must be in (0, 1]");
+    }
+    else if (scale < 0.0)
+    {
+        throw std::invalid_argument("mutation scale must not be negative");
+    }
+
+    mutation_rate = rate;
+    mutation_distribution = distribution;
+    mutation_scale = scale;
+    reset_step_sizes();
+}
+
+void GeneticOptim::set_elite_count(const size_t count)
+{
+    if (count > designs.size())
+    {
+        throw std::invalid_argument("elite count must not be larger than the population");
+    }
+
+    elite_count = count;
+}
+
+void GeneticOptim::set_sharing_radius(const double radius)
+{
+    if (radius < 0.0)
+    {
+        throw std::invalid_argument("sharing radius must not be negative");
+    }
+
+    sharing_radius = radius;
+}
+
+void GeneticOptim::set_self_adaptation(const bool enabled)
+{
+    self_adaptive = enabled;
+    reset_step_sizes();
+}
+
+const GeneticOptim::GenerationStats& GeneticOptim::get_generation_stats() const
+{
+    return generation_stats;
+}
+
+void GeneticOptim::reset_step_sizes()
+{
+    // Reset both populations, as the steady-state variant keeps its unevaluated
+    // children in the next population
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        designs.step_size(i) = mutation_scale;
+        next_designs.step_size(i) = mutation_scale;
+    }
+}
+
 void GeneticOptim::init_population()
 {
     // Loop through each design
     for (size_t i = 0; i < designs.size(); ++i)
     {
         // Define a new random variable for each design variable
-        for (size_t j = 0; j < designs[i].design_variables.size(); ++j)
-        {
-            designs[i].design_variables[j] = get_random();
-        }
+        random->fill_uniform(designs.design(i), num_des_var, lower_bound, upper_bound);
     }
+
+    reset_step_sizes();
 }
 
 void GeneticOptim::init_population(const std::vector<double>& other)
@@ -64,14 +146,85 @@ void GeneticOptim::init_population(const std::vector<double>& other)
     for (size_t i = 0; i < designs.size(); ++i)
     {
         // Define a new design variable within 25% of the previous value, limiting the results
-        for (size_t j = 0; j < designs[i].design_variables.size(); ++j)
+        double* desvars = designs.design(i);
+        random->fill_uniform(desvars, num_des_var, -1.0, 1.0);
+
+        for (size_t j = 0; j < num_des_var; ++j)
         {
-            designs[i].design_variables[j] = constrain_value(other[j] + 0.25 * get_mutation_random() * (upper_bound - lower_bound));
+            desvars[j] = constrain_value(other[j] + 0.25 * desvars[j] * (upper_bound - lower_bound));
         }
     }
+
+    reset_step_sizes();
 }
 
-const std::vector<double>& GeneticOptim::get_design(const size_t i)
+void GeneticOptim::seed_population(
+    const std::vector<std::vector<double>>& seeds,
+    const double spread,
+    const double interpolation_rate)
+{
+    if (seeds.empty())
+    {
+        throw std::invalid_argument("at least one seed design must be provided");
+    }
+    else if (spread < 0.0 || !(interpolation_rate >= 0.0 && interpolation_rate <= 1.0))
+    {
+        throw std::invalid_argument("seed spread must not be negative and interpolation rate must be in [0, 1]");
+    }
+
+    for (const std::vector<double>& seed : seeds)
+    {
+        if (seed.size() != num_des_var)
+        {
+            throw std::invalid_argument("seed design variable size does not match the optimizer");
+        }
+    }
+
+    const double offset = spread * (upper_bound - lower_bound);
+
+    // Loop through each design
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        double* desvars = designs.design(i);
+
+        // Keep each seed unchanged while there is space
+        if (i < seeds.size())
+        {
+            std::copy(seeds[i].begin(), seeds[i].end(), desvars);
+            continue;
+        }
+
+        // Take a random seed, or interpolate between two random seeds
+        const std::vector<double>& first = seeds[random->next_index(seeds.size())];
+
+        if (seeds.size() > 1 && random->uniform(0.0, 1.0) < interpolation_rate)
+        {
+            const std::vector<double>& second = seeds[random->next_index(seeds.size())];
+            const double t = random->uniform(0.0, 1.0);
+
+            for (size_t j = 0; j < num_des_var; ++j)
+            {
+                desvars[j] = first[j] + t * (second[j] - first[j]);
+            }
+        }
+        else
+        {
+            std::copy(first.begin(), first.end(), desvars);
+        }
+
+        // Offset the design, limiting the results
+        random->fill_uniform(random_values.data(), num_des_var, -offset, offset);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            desvars[j] = constrain_value(desvars[j] + random_values[j]);
+        }
+    }
+
+    reset_step_sizes();
+}
+
+const double* GeneticOptim::get_design(const size_t i) const
 {
     if (i >= designs.size())
     {
@@ -79,11 +232,11 @@ const std::vector<double>& GeneticOptim::get_design(const size_t i)
     }
     else
     {
-        return designs[i].design_variables;
+        return designs.design(i);
     }
 }
 
-const size_t GeneticOptim::design_count() const
+size_t GeneticOptim::design_count() const
 {
     return designs.size();
 }
@@ -96,36 +249,13 @@ void GeneticOptim::set_design_fitness(const size_t ind, const double val)
     }
     else
     {
-        designs[ind].fitness = val;
+        designs.fitness(ind) = val;
     }
 }
 
-void GeneticOptim::update_designs()
+void GeneticOptim::select_parents()
 {
-    std::vector<size_t> combination_group(designs.size() * 2, 0);
-    std::vector<OptimStatus> new_population(designs.size(), OptimStatus(num_des_var));
-
-    double min_val = 0.0;
-    double max_val = 0.0;
-
-    for (size_t i = 0; i < designs.size(); ++i)
-    {
-        const double fv = designs[i].fitness;
-        if (i == 0)
-        {
-            min_val = fv;
-            max_val = fv;
-        }
-        else
-        {
-            min_val = std::min(fv, min_val);
-            max_val = std::max(fv, max_val);
-        }
-    }
-
     // Determine the indices to add to the combination group
-    std::uniform_int_distribution<size_t> index_dist;
-
     for (size_t i = 0; i < designs.size(); ++i)
     {
         for (size_t j = 0; j < 2; ++j)
@@ -134,77 +264,265 @@ void GeneticOptim::update_designs()
 
             while (i == i2)
             {
-                i2 = index_distribution(generator);
+                i2 = random->next_index(designs.size());
             }
 
-            combination_group[2 * i + j] = (designs[i].fitness > designs[i2].fitness) ? i : i2;
+            parent_indices[2 * i + j] = (selection_fitness[i] > selection_fitness[i2]) ? i : i2;
         }
     }
+}
 
-    // Perform the sample combinations
+void GeneticOptim::update_selection_fitness()
+{
     for (size_t i = 0; i < designs.size(); ++i)
     {
-        // Define the two value indices
-        const size_t ind1 = combination_group[2 * i];
-        const size_t ind2 = combination_group[2 * i + 1];
+        selection_fitness[i] = designs.fitness(i);
+    }
 
-        // Extract the two designs
-        const OptimStatus& o1 = designs[ind1];
-        const OptimStatus& o2 = designs[ind2];
+    // Divide the fitness by the niche count, so that designs in crowded regions are
+    // selected less often than equally fit designs in sparse regions. The fitness is
+    // first shifted to be positive, as dividing a negative fitness would raise it
+    if (sharing_radius > 0.0)
+    {
+        GenomeDistance::niche_counts(designs, sharing_radius, niche_counts);
 
-        // Determine the min and max value
-        const OptimStatus& val_max = (o1.fitness > o2.fitness) ? o1 : o2;
-        const OptimStatus& val_min = (o1.fitness > o2.fitness) ? o2 : o1;
+        const double min_fitness = *std::min_element(selection_fitness.begin(), selection_fitness.end());
 
-        // Define weights
-        const double w1 = val_max.fitness / std::max(val_max.fitness + val_min.fitness, 0.01);
-        const double w2 = 1.0 - w1;
+        for (size_t i = 0; i < designs.size(); ++i)
+        {
+            selection_fitness[i] = (selection_fitness[i] - min_fitness + 1e-3) / niche_counts[i];
+        }
+    }
+}
 
-        // Obtain the child to set into the new population result
-        OptimStatus& child = new_population[i];
+void GeneticOptim::record_generation_stats()
+{
+    const size_t num_designs = designs.size();
+    GenerationStats& stats = generation_stats;
+    stats.generation = current_generation;
 
-        // Update each design variable
-        for (size_t j = 0; j < designs[i].design_variables.size(); ++j)
+    // Sort the fitness values for the quantiles
+    for (size_t i = 0; i < num_designs; ++i)
+    {
+        stats_values[i] = designs.fitness(i);
+    }
+
+    std::sort(stats_values.begin(), stats_values.end());
+
+    stats.fitness_min = stats_values.front();
+    stats.fitness_lower_quartile = sorted_quantile(stats_values, 0.25);
+    stats.fitness_median = sorted_quantile(stats_values, 0.5);
+    stats.fitness_upper_quartile = sorted_quantile(stats_values, 0.75);
+    stats.fitness_max = stats_values.back();
+
+    // Accumulate the per-variable sums row by row, following the population layout
+    std::fill(stats_sums.begin(), stats_sums.end(), 0.0);
+    std::fill(stats_square_sums.begin(), stats_square_sums.end(), 0.0);
+
+    stats.step_size_min = designs.step_size(0);
+    stats.step_size_max = designs.step_size(0);
+    double step_sum = 0.0;
+
+    for (size_t i = 0; i < num_designs; ++i)
+    {
+        const double* desvars = designs.design(i);
+        for (size_t j = 0; j < num_des_var; ++j)
         {
-            // Extract and update the design variable
-            double& desvar = child.design_variables[j];
-            desvar = w1 * val_max.design_variables[j] + w2 * val_min.design_variables[j];
+            stats_sums[j] += desvars[j];
+            stats_square_sums[j] += desvars[j] * desvars[j];
+        }
+
+        const double step = designs.step_size(i);
+        stats.step_size_min = std::min(stats.step_size_min, step);
+        stats.step_size_max = std::max(stats.step_size_max, step);
+        step_sum += step;
+    }
 
-            // Provide some mutation into the design variable
-            const double mutation = get_mutation_random() * 0.05 * (upper_bound - lower_bound);
-            desvar += mutation;
+    const double inv_count = 1.0 / static_cast<double>(num_designs);
+    double spread = 0.0;
 
-            // Limit the design variable to the upper and lower bounds
-            desvar = constrain_value(desvar);
+    for (size_t j = 0; j < num_des_var; ++j)
+    {
+        const double mean = stats_sums[j] * inv_count;
+        const double variance = stats_square_sums[j] * inv_count - mean * mean;
+        spread += std::sqrt(std::max(variance, 0.0));
+    }
+
+    stats.spread = spread / static_cast<double>(num_des_var);
+    stats.step_size_mean = step_sum * inv_count;
+}
+
+void GeneticOptim::swap_populations()
+{
+    // Carry the fittest designs into the next population unchanged
+    if (elite_count > 0)
+    {
+        std::iota(elite_order.begin(), elite_order.end(), 0);
+        std::partial_sort(elite_order.begin(), elite_order.begin() + elite_count, elite_order.end(), [this](const size_t i1, const size_t i2)
+        {
+            return designs.fitness(i1) > designs.fitness(i2);
+        });
+
+        for (size_t i = 0; i < elite_count; ++i)
+        {
+            std::memcpy(next_designs.design(i), designs.design(elite_order[i]), num_des_var * sizeof(double));
+            next_designs.step_size(i) = designs.step_size(elite_order[i]);
         }
     }
 
-    // Reset the status values
-    designs = new_population;
+    designs.swap(next_designs);
+    designs.reset_fitness();
     current_generation += 1;
 }
 
-double GeneticOptim::constrain_value(const double val) const
+void GeneticOptim::update_designs()
 {
-    return std::min(upper_bound, std::max(lower_bound, val));
+    record_generation_stats();
+    update_selection_fitness();
+    select_parents();
+
+    // Perform the sample combinations
+    for (size_t i = 0; i < designs.size(); ++i)
+    {
+        next_designs.step_size(i) = breed_child(parent_indices[2 * i], parent_indices[2 * i + 1], next_designs.design(i));
+    }
+
+    // Swap to the new population
+    swap_populations();
 }
 
-size_t GeneticOptim::design_variable_count() const
+double GeneticOptim::breed_child(
+    const size_t ind1,
+    const size_t ind2,
+    double* child)
 {
-    return num_des_var;
+    // Order the two parents, with the first as the fitter design
+    const bool first_max = designs.fitness(ind1) > designs.fitness(ind2);
+    const size_t ind_max = first_max ? ind1 : ind2;
+    const size_t ind_min = first_max ? ind2 : ind1;
+
+    // Define weights
+    const double fit_max = designs.fitness(ind_max);
+    const double fit_min = designs.fitness(ind_min);
+
+    const double w1 = fit_max / std::max(fit_max + fit_min, 0.01);
+    const double w2 = 1.0 - w1;
+
+    // Obtain the parents
+    const double* val_max = designs.design(ind_max);
+    const double* val_min = designs.design(ind_min);
+
+    // Combine the parent design variables
+    for (size_t j = 0; j < num_des_var; ++j)
+    {
+        child[j] = w1 * val_max[j] + w2 * val_min[j];
+    }
+
+    // Inherit the geometric mean of the parent step sizes with a log-normal
+    // perturbation, so that no random values are drawn unless adapting
+    double step_size = mutation_scale;
+    if (self_adaptive)
+    {
+        step_size = std::sqrt(designs.step_size(ind_max) * designs.step_size(ind_min)) * std::exp(step_learning_rate * random->normal(0.0, 1.0));
+        step_size = std::min(std::max(step_size, min_step_size), max_step_size);
+    }
+
+    // Provide some mutation into the design variables
+    mutate_design(child, step_size);
+
+    return step_size;
 }
 
-size_t GeneticOptim::get_generation() const
+void GeneticOptim::fill_mutations(
+    double* values,
+    const size_t count,
+    const double step_size)
 {
-    return current_generation;
+    const double scale = step_size * (upper_bound - lower_bound);
+
+    switch (mutation_distribution)
+    {
+    case MutationDistribution::GAUSSIAN:
+        random->fill_normal(values, count, 0.0, scale);
+        break;
+    case MutationDistribution::CAUCHY:
+    {
+        // Transform uniform values by the inverse Cauchy distribution function
+        const double half_pi = 1.5707963267948966;
+        random->fill_uniform(values, count, -half_pi, half_pi);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = scale * std::tan(values[i]);
+        }
+        break;
+    }
+    default:
+        random->fill_uniform(values, count, -scale, scale);
+        break;
+    }
 }
 
-double GeneticOptim::get_random()
+void GeneticOptim::mutate_design(
+    double* child,
+    const double step_size)
 {
-    return distribution(generator);
+    if (mutation_rate >= 1.0)
+    {
+        // Draw a mutation for every design variable
+        fill_mutations(random_values.data(), num_des_var, step_size);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            child[j] = constrain_value(child[j] + random_values[j]);
+        }
+    }
+    else
+    {
+        // Find the design variables to mutate, with the number of design variables
+        // skipped between mutations following a geometric distribution
+        const double log_keep = std::log(1.0 - mutation_rate);
+        mutation_indices.clear();
+
+        size_t j = 0;
+        while (true)
+        {
+            const double u = random->uniform(0.0, 1.0);
+            const double skip = std::floor(std::log(1.0 - u) / log_keep);
+
+            if (skip >= static_cast<double>(num_des_var - j))
+            {
+                break;
+            }
+
+            j += static_cast<size_t>(skip);
+            mutation_indices.push_back(j);
+            j += 1;
+        }
+
+        // Draw and add the mutations for the selected design variables
+        fill_mutations(random_values.data(), mutation_indices.size(), step_size);
+
+        for (size_t k = 0; k < mutation_indices.size(); ++k)
+        {
+            double& desvar = child[mutation_indices[k]];
+            desvar = constrain_value(desvar + random_values[k]);
+        }
+
+        // Limit the remaining design variables, which may be outside of the
+        // bounds where negative fitness values extrapolate past the parents
+        for (size_t k = 0; k < num_des_var; ++k)
+        {
+            child[k] = constrain_value(child[k]);
+        }
+    }
 }
 
-double GeneticOptim::get_mutation_random()
+size_t GeneticOptim::design_variable_count() const
 {
-    return mutation_distribution(generator);
+    return num_des_var;
+}
+
+size_t GeneticOptim::get_generation() const
+{
+    return current_generation;
 }
@@ -1,43 +1,64 @@
 #ifndef __IO_GENETIC_OPTIM__
 #define __IO_GENETIC_OPTIM__
 
+#include <memory>
 #include <vector>
-#include <random>
+
+#include "optim/optimizer.h"
+#include "optim/population.h"
+#include "optim/random.h"
 
 /// <summary>
 /// GeneticOptim provides a basic genetic optimization algorithm
 /// for the provided design variables to maximize the fitness of the
 /// objective function
 /// </summary>
-class GeneticOptim
+class GeneticOptim : public Optimizer
 {
-protected:
+public:
     /// <summary>
-    /// OptimStatus is a structure to contain information regarding the
-    /// current fitness and design variables for a given design
+    /// Provides options for the distribution of mutation values
     /// </summary>
-    struct OptimStatus
+    enum class MutationDistribution
+    {
+        UNIFORM = 0,
+        GAUSSIAN = 1,
+        CAUCHY = 2
+    };
+
+public:
+    /// <summary>
+    /// Provides the convergence statistics of a generation, measured on the
+    /// evaluated population before the next population is bred
+    /// </summary>
+    struct GenerationStats
     {
         /// <summary>
-        /// Initializes the OptimStatus
+        /// The generation the statistics were measured on
         /// </summary>
-        /// <param name="num_vars">the number of design variables to use</param>
-        OptimStatus(const size_t num_vars);
+        size_t generation = 0;
 
         /// <summary>
-        /// Resets the fitness score of the design
+        /// The minimum, lower quartile, median, upper quartile and maximum fitness
         /// </summary>
-        void reset();
+        double fitness_min = 0.0;
+        double fitness_lower_quartile = 0.0;
+        double fitness_median = 0.0;
+        double fitness_upper_quartile = 0.0;
+        double fitness_max = 0.0;
 
         /// <summary>
-        /// Provides the design variable values
+        /// The standard deviation of each design variable over the population,
+        /// averaged over the design variables
         /// </summary>
-        std::vector<double> design_variables;
+        double spread = 0.0;
 
         /// <summary>
-        /// Provides the fitness score of the design
+        /// The mean, minimum and maximum mutation step size, as fractions of the design range
         /// </summary>
-        double fitness;
+        double step_size_mean = 0.0;
+        double step_size_min = 0.0;
+        double step_size_max = 0.0;
     };
 
 public:
@@ -46,126 +67,307 @@ public:
     /// </summary>
     /// <param name="num_population">the size of the population to use</param>
     /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
     GeneticOptim(
         const size_t num_designs,
-        const size_t num_des_var);
+        const size_t num_des_var,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Destructs the Genetic Optimization algorithm
+    /// </summary>
+    virtual ~GeneticOptim() = default;
 
     /// <summary>
     /// Obtain the design variables for a given design
     /// </summary>
     /// <param name="i">the design index</param>
-    /// <returns>the design variables</returns>
-    const std::vector<double>& get_design(const size_t i);
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
 
     /// <summary>
     /// Provides the count of the current designs
     /// </summary>
     /// <returns>the number of designs in the optimization algorithm</returns>
-    const size_t design_count() const;
+    virtual size_t design_count() const override;
 
     /// <summary>
     /// Sets the fitness score for a given design
     /// </summary>
     /// <param name="ind">the design index to check</param>
     /// <param name="val">the fitness value to assign</param>
-    void set_design_fitness(const size_t ind, const double val);
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
 
     /// <summary>
     /// Updates the designs and steps the genetic algorithm once all new fitness
     /// values are assigned, resetting the fitness scores to zero for each new design
     /// </summary>
-    void update_designs();
+    virtual void update_designs() override;
 
     /// <summary>
     /// Provides the count of the design variables
     /// </summary>
     /// <returns>the number of design variables in the optimization</returns>
-    size_t design_variable_count() const;
+    virtual size_t design_variable_count() const override;
 
     /// <summary>
     /// Provides the current generation count for the optimization steps
     /// </summary>
     /// <returns>the number of times update_population has been called</returns>
-    size_t get_generation() const;
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Sets the mutation applied to each child design. With a rate of one, every
+    /// design variable is mutated. With a lower rate, the design variables to mutate
+    /// are found by geometric skip sampling, so that random values are only drawn for
+    /// the design variables mutated. Will throw an std::invalid_argument if the rate
+    /// is not in (0, 1] or the scale is negative
+    /// </summary>
+    /// <param name="rate">the probability that each design variable is mutated</param>
+    /// <param name="distribution">the distribution of the mutation values</param>
+    /// <param name="scale">the mutation scale as a fraction of the design range; the
+    /// half-width for uniform, standard deviation for Gaussian and half-width at half
+    /// maximum for Cauchy mutations</param>
+    void set_mutation(
+        const double rate,
+        const MutationDistribution distribution,
+        const double scale);
+
+    /// <summary>
+    /// Sets the number of the fittest designs carried into each new population
+    /// unchanged. Will throw an std::invalid_argument if the count is larger than
+    /// the population
+    /// </summary>
+    /// <param name="count">the number of elite designs</param>
+    void set_elite_count(const size_t count);
+
+    /// <summary>
+    /// Sets the fitness sharing radius. Parents are selected on their fitness divided by
+    /// their niche count, the number of designs within the radius weighted by closeness,
+    /// so that crowded regions of the design space are selected less often. Will throw
+    /// an std::invalid_argument if the radius is negative
+    /// </summary>
+    /// <param name="radius">the genome distance within which designs share fitness, or zero to disable</param>
+    void set_sharing_radius(const double radius);
+
+    /// <summary>
+    /// Sets whether each design carries its own mutation step size. The step size of
+    /// a child is the geometric mean of its parents' step sizes with a log-normal
+    /// perturbation, so that step sizes which breed fitter children spread through
+    /// the population. The initial step size is the mutation scale
+    /// </summary>
+    /// <param name="enabled">true to adapt the step sizes, false to use the mutation scale for every child</param>
+    void set_self_adaptation(const bool enabled);
+
+    /// <summary>
+    /// Provides the convergence statistics of the last generation
+    /// </summary>
+    /// <returns>the statistics measured by the last call to update_designs</returns>
+    const GenerationStats& get_generation_stats() const;
 
     /// <summary>
     /// Initializes the population to random values within the upper and lower bound values
     /// </summary>
-    void init_population();
+    virtual void init_population() override;
 
     /// <summary>
     /// Innitializes the population to random values roughtly surrounding
     /// the given design varaibles
     /// </summary>
     /// <param name="other">the design variables to target around</param>
-    void init_population(const std::vector<double>& other);
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Initializes the designs from several seed designs. The first designs are the
+    /// seeds unchanged, and each remaining design is a random seed, or with the given
+    /// probability a random interpolation between two seeds, with a uniform random
+    /// offset of up to the spread added to each design variable
+    /// </summary>
+    /// <param name="seeds">the seed design variables, ordered from the most preferred</param>
+    /// <param name="spread">the largest random offset, as a fraction of the design range</param>
+    /// <param name="interpolation_rate">the probability that a design is interpolated between two seeds</param>
+    virtual void seed_population(
+        const std::vector<std::vector<double>>& seeds,
+        const double spread,
+        const double interpolation_rate) override;
 
 protected:
     /// <summary>
-    /// Obtains a random number to assign to a design variable between the
-    /// provided lower and upper bounds
+    /// Selects two parents for each design in the next population by binary
+    /// tournament on the selection fitness, storing the parents of design i in
+    /// parent_indices at indices 2 * i and 2 * i + 1
+    /// </summary>
+    void select_parents();
+
+    /// <summary>
+    /// Sets the fitness used to select parents from the fitness of each design. If fitness
+    /// sharing is enabled, the fitness is shifted above the lowest fitness of the population,
+    /// so that it is positive, and divided by the niche count of each design
+    /// </summary>
+    void update_selection_fitness();
+
+    /// <summary>
+    /// Measures the convergence statistics of the evaluated population, to be called
+    /// at the start of update_designs before the next population is bred
+    /// </summary>
+    void record_generation_stats();
+
+    /// <summary>
+    /// Copies the elite designs over the first designs of the next population, and
+    /// then makes the next population the current population, resetting the
+    /// fitness values and incrementing the generation
+    /// </summary>
+    void swap_populations();
+
+    /// <summary>
+    /// Breeds a child from two designs in the current population, weighting each
+    /// parent by its share of the combined fitness, and then mutates the child
+    /// with its step size
+    /// </summary>
+    /// <param name="ind1">the index of the first parent</param>
+    /// <param name="ind2">the index of the second parent</param>
+    /// <param name="child">the design variables to set</param>
+    /// <returns>the mutation step size of the child, to be stored with the child</returns>
+    double breed_child(
+        const size_t ind1,
+        const size_t ind2,
+        double* child);
+
+    /// <summary>
+    /// Fills the buffer with mutation values from the mutation distribution
     /// </summary>
-    /// <returns>uniform random number between the upper and lower bounds</returns>
-    double get_random();
+    /// <param name="values">the buffer to fill</param>
+    /// <param name="count">the number of values to fill</param>
+    /// <param name="step_size">the mutation scale, as a fraction of the design range</param>
+    void fill_mutations(
+        double* values,
+        const size_t count,
+        const double step_size);
 
     /// <summary>
-    /// Obtains a random number to be used for the mutation values
+    /// Adds mutations to the given child design, either to every design variable or
+    /// to those selected by geometric skip sampling, limiting the results to the bounds
     /// </summary>
-    /// <returns>Mutation random number</returns>
-    double get_mutation_random();
+    /// <param name="child">the design variables to mutate</param>
+    /// <param name="step_size">the mutation scale, as a fraction of the design range</param>
+    void mutate_design(
+        double* child,
+        const double step_size);
 
     /// <summary>
-    /// Constrains the input value between the upper and lower bound
+    /// Sets the step size of every design in both populations to the mutation scale
     /// </summary>
-    /// <param name="val">value to constrain</param>
-    /// <returns>constrained value</returns>
-    double constrain_value(const double val) const;
+    void reset_step_sizes();
 
 protected:
     /// <summary>
-    /// A vector to store the optimization status for each design
+    /// The design variables and fitness of the current population
+    /// </summary>
+    Population designs;
+
+    /// <summary>
+    /// The population to write the next generation into, swapped with the
+    /// current population after each update
     /// </summary>
-    std::vector<OptimStatus> designs;
+    Population next_designs;
+
+    /// <summary>
+    /// The parent design indices from the last parent selection
+    /// </summary>
+    std::vector<size_t> parent_indices;
 
     /// <summary>
     /// The random number generator
     /// </summary>
-    std::default_random_engine generator;
+    std::unique_ptr<RandomSource> random;
 
     /// <summary>
-    /// The real distribution between 0 and 1 to use for generating random numbers
+    /// Storage for random values drawn in bulk, with space for two values
+    /// for each design variable
     /// </summary>
-    std::uniform_real_distribution<double> distribution;
+    std::vector<double> random_values;
 
     /// <summary>
-    /// The real distribution to use for generating mutation values
+    /// Storage for the design variable indices selected for mutation
     /// </summary>
-    std::uniform_real_distribution<double> mutation_distribution;
+    std::vector<size_t> mutation_indices;
 
     /// <summary>
-    /// The integer distribution to use to find a random index value
+    /// The probability that each design variable is mutated
     /// </summary>
-    std::uniform_int_distribution<size_t> index_distribution;
+    double mutation_rate;
 
     /// <summary>
-    /// Storage for the number of design variables in a solution
+    /// The distribution of the mutation values
     /// </summary>
-    size_t num_des_var;
+    MutationDistribution mutation_distribution;
 
     /// <summary>
-    /// Storage for the current generation value for the solution
+    /// The mutation scale, as a fraction of the design range
     /// </summary>
-    size_t current_generation;
+    double mutation_scale;
+
+    /// <summary>
+    /// The limits of the self-adaptive step sizes, as fractions of the design range
+    /// </summary>
+    static const double min_step_size;
+    static const double max_step_size;
 
     /// <summary>
-    /// The lower-bound of the design space
+    /// Defines whether each design carries its own mutation step size
     /// </summary>
-    static const double lower_bound;
+    bool self_adaptive;
 
     /// <summary>
-    /// The upper-bound of the design space
+    /// The learning rate of the log-normal step size perturbation
     /// </summary>
-    static const double upper_bound;
+    double step_learning_rate;
+
+    /// <summary>
+    /// The number of the fittest designs carried into each new population unchanged
+    /// </summary>
+    size_t elite_count;
+
+    /// <summary>
+    /// Storage for the design indices ordered by fitness when selecting the elite designs
+    /// </summary>
+    std::vector<size_t> elite_order;
+
+    /// <summary>
+    /// The fitness sharing radius, or zero if fitness sharing is disabled
+    /// </summary>
+    double sharing_radius;
+
+    /// <summary>
+    /// Storage for the fitness used to select parents, and the niche count of each design
+    /// </summary>
+    std::vector<double> selection_fitness;
+    std::vector<double> niche_counts;
+
+    /// <summary>
+    /// The convergence statistics of the last generation
+    /// </summary>
+    GenerationStats generation_stats;
+
+    /// <summary>
+    /// Storage for the sorted fitness values and the per-variable sums used by the statistics
+    /// </summary>
+    std::vector<double> stats_values;
+    std::vector<double> stats_sums;
+    std::vector<double> stats_square_sums;
+
+    /// <summary>
+    /// Storage for the number of design variables in a solution
+    /// </summary>
+    size_t num_des_var;
+
+    /// <summary>
+    /// Storage for the current generation value for the solution
+    /// </summary>
+    size_t current_generation;
 };
 
 #endif
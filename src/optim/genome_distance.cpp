@@ -0,0 +1,98 @@
+#include "optim/genome_distance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+const size_t GenomeDistance::block_size = 64;
+
+// Calls the function for every pair of distinct designs with their distance, visiting
+// the pairs in blocks of designs so that the second block of each pair stays in cache
+template <typename PairFunction>
+static void for_each_pair(
+    const Population& designs,
+    const size_t block_size,
+    PairFunction function)
+{
+    const size_t num_designs = designs.size();
+    const size_t num_des_var = designs.variable_count();
+
+    for (size_t block_i = 0; block_i < num_designs; block_i += block_size)
+    {
+        const size_t end_i = std::min(num_designs, block_i + block_size);
+
+        for (size_t block_j = block_i; block_j < num_designs; block_j += block_size)
+        {
+            const size_t end_j = std::min(num_designs, block_j + block_size);
+
+            for (size_t i = block_i; i < end_i; ++i)
+            {
+                const double* a = designs.design(i);
+
+                for (size_t j = std::max(block_j, i + 1); j < end_j; ++j)
+                {
+                    function(i, j, std::sqrt(GenomeDistance::squared_distance(a, designs.design(j), num_des_var)));
+                }
+            }
+        }
+    }
+}
+
+double GenomeDistance::squared_distance(
+    const double* a,
+    const double* b,
+    const size_t count)
+{
+    // Accumulate in four independent sums so that the compiler may vectorize the
+    // loop without reordering a single floating-point reduction
+    double sum_0 = 0.0;
+    double sum_1 = 0.0;
+    double sum_2 = 0.0;
+    double sum_3 = 0.0;
+
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4)
+    {
+        const double d_0 = a[j] - b[j];
+        const double d_1 = a[j + 1] - b[j + 1];
+        const double d_2 = a[j + 2] - b[j + 2];
+        const double d_3 = a[j + 3] - b[j + 3];
+
+        sum_0 += d_0 * d_0;
+        sum_1 += d_1 * d_1;
+        sum_2 += d_2 * d_2;
+        sum_3 += d_3 * d_3;
+    }
+
+    for (; j < count; ++j)
+    {
+        const double d = a[j] - b[j];
+        sum_0 += d * d;
+    }
+
+    return (sum_0 + sum_1) + (sum_2 + sum_3);
+}
+
+void GenomeDistance::niche_counts(
+    const Population& designs,
+    const double radius,
+    std::vector<double>& counts)
+{
+    if (!(radius > 0.0))
+    {
+        throw std::invalid_argument("sharing radius must be positive");
+    }
+
+    // Each design shares fully with itself
+    counts.assign(designs.size(), 1.0);
+
+    for_each_pair(designs, block_size, [&counts, radius](const size_t i, const size_t j, const double distance)
+    {
+        if (distance < radius)
+        {
+            const double share = 1.0 - distance / radius;
+            counts[i] += share;
+            counts[j] += share;
+        }
+    });
+}
@@ -0,0 +1,51 @@
+#ifndef __IO_OPTIM_GENOME_DISTANCE__
+#define __IO_OPTIM_GENOME_DISTANCE__
+
+#include <cstddef>
+#include <vector>
+
+#include "optim/population.h"
+
+/// <summary>
+/// GenomeDistance provides distance kernels over the contiguous designs of a
+/// population. The all-pairs kernels visit the designs in blocks, so that the
+/// designs of a block stay in cache while the other blocks are compared against
+/// them, and accumulate their results without storing the distance matrix, so
+/// that the memory needed grows with the population size rather than its square
+/// </summary>
+class GenomeDistance
+{
+public:
+    /// <summary>
+    /// Provides the squared Euclidean distance between two designs
+    /// </summary>
+    /// <param name="a">the first design variables</param>
+    /// <param name="b">the second design variables</param>
+    /// <param name="count">the number of design variables</param>
+    /// <returns>the squared distance</returns>
+    static double squared_distance(
+        const double* a,
+        const double* b,
+        const size_t count);
+
+    /// <summary>
+    /// Sets the niche count of each design for fitness sharing, as the sum over the
+    /// population of the triangular sharing function 1 - d / radius for designs
+    /// within the radius, including the design itself
+    /// </summary>
+    /// <param name="designs">the population to compare</param>
+    /// <param name="radius">the sharing radius</param>
+    /// <param name="counts">the niche count of each design</param>
+    static void niche_counts(
+        const Population& designs,
+        const double radius,
+        std::vector<double>& counts);
+
+private:
+    /// <summary>
+    /// The number of designs in each block of the all-pairs kernels
+    /// </summary>
+    static const size_t block_size;
+};
+
+#endif
@@ -0,0 +1,284 @@
+#include "optim/map_elites.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+const double MapElitesOptim::iso_sigma = 0.02;
+const double MapElitesOptim::line_sigma = 0.2;
+
+MapElitesOptim::MapElitesOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    const std::vector<size_t>& grid_sizes,
+    const std::vector<double>& behavior_lower,
+    const std::vector<double>& behavior_upper,
+    std::unique_ptr<RandomSource> random_source) :
+    num_des_var(num_des_var),
+    current_generation(0),
+    grid_sizes(grid_sizes),
+    behavior_lower(behavior_lower),
+    behavior_upper(behavior_upper),
+    offspring(num_designs, num_des_var),
+    offspring_fitness(num_designs, 0.0),
+    offspring_behaviors(num_designs * grid_sizes.size(), 0.0),
+    random_values(num_des_var, 0.0),
+    random(std::move(random_source))
+{
+    // Check for valid inputs
+    if (num_designs == 0 || num_des_var == 0)
+    {
+        throw std::invalid_argument("designs and design variables must be positive");
+    }
+    else if (grid_sizes.empty() || behavior_lower.size() != grid_sizes.size() || behavior_upper.size() != grid_sizes.size())
+    {
+        throw std::invalid_argument("grid sizes and behavior bounds must be provided for each behavior dimension");
+    }
+
+    size_t num_cells = 1;
+    for (size_t d = 0; d < grid_sizes.size(); ++d)
+    {
+        if (grid_sizes[d] == 0 || !(behavior_upper[d] > behavior_lower[d]))
+        {
+            throw std::invalid_argument("grid sizes must be positive and behavior bounds must be increasing");
+        }
+
+        num_cells *= grid_sizes[d];
+    }
+
+    cell_slots.assign(num_cells, SIZE_MAX);
+
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
+    // Define the random initial population values
+    init_population();
+}
+
+void MapElitesOptim::init_population()
+{
+    // Loop through each design
+    for (size_t i = 0; i < offspring.size(); ++i)
+    {
+        // Define a new random variable for each design variable
+        random->fill_uniform(offspring.design(i), num_des_var, lower_bound, upper_bound);
+    }
+
+    clear_grid();
+}
+
+void MapElitesOptim::init_population(const std::vector<double>& other)
+{
+    if (other.size() != design_variable_count())
+    {
+        throw std::invalid_argument("input design variable size does not match between init vector and optimizer");
+    }
+
+    // Loop through each design
+    for (size_t i = 0; i < offspring.size(); ++i)
+    {
+        // Define a new design variable within 25% of the previous value, limiting the results
+        double* desvars = offspring.design(i);
+        random->fill_uniform(desvars, num_des_var, -1.0, 1.0);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            desvars[j] = constrain_value(other[j] + 0.25 * desvars[j] * (upper_bound - lower_bound));
+        }
+    }
+
+    clear_grid();
+}
+
+void MapElitesOptim::clear_grid()
+{
+    std::fill(cell_slots.begin(), cell_slots.end(), SIZE_MAX);
+    elite_designs.clear();
+    elite_fitness.clear();
+    elite_behaviors.clear();
+
+    std::fill(offspring_fitness.begin(), offspring_fitness.end(), 0.0);
+    std::fill(offspring_behaviors.begin(), offspring_behaviors.end(), 0.0);
+}
+
+size_t MapElitesOptim::cell_index(const double* behavior) const
+{
+    size_t cell = 0;
+    for (size_t d = 0; d < grid_sizes.size(); ++d)
+    {
+        const double fraction = (behavior[d] - behavior_lower[d]) / (behavior_upper[d] - behavior_lower[d]);
+        const double position = std::max(0.0, fraction * static_cast<double>(grid_sizes[d]));
+        const size_t ind = std::min(grid_sizes[d] - 1, static_cast<size_t>(position));
+
+        cell = cell * grid_sizes[d] + ind;
+    }
+
+    return cell;
+}
+
+void MapElitesOptim::insert_offspring(const size_t ind)
+{
+    const size_t num_behaviors = grid_sizes.size();
+    const double* behavior = &offspring_behaviors[ind * num_behaviors];
+    const size_t cell = cell_index(behavior);
+
+    size_t slot = cell_slots[cell];
+
+    if (slot == SIZE_MAX)
+    {
+        // Occupy the cell with a new slot
+        slot = elite_fitness.size();
+        cell_slots[cell] = slot;
+
+        elite_designs.resize(elite_designs.size() + num_des_var);
+        elite_fitness.push_back(0.0);
+        elite_behaviors.resize(elite_behaviors.size() + num_behaviors);
+    }
+    else if (offspring_fitness[ind] <= elite_fitness[slot])
+    {
+        return;
+    }
+
+    // Replace the elite of the cell
+    std::memcpy(&elite_designs[slot * num_des_var], offspring.design(ind), num_des_var * sizeof(double));
+    std::memcpy(&elite_behaviors[slot * num_behaviors], behavior, num_behaviors * sizeof(double));
+    elite_fitness[slot] = offspring_fitness[ind];
+}
+
+void MapElitesOptim::breed_offspring()
+{
+    const double iso_std = iso_sigma * (upper_bound - lower_bound);
+
+    for (size_t i = 0; i < offspring.size(); ++i)
+    {
+        const double* x1 = get_elite_design(random->next_index(elite_count()));
+        const double* x2 = get_elite_design(random->next_index(elite_count()));
+        double* child = offspring.design(i);
+
+        // Mutate the first elite isotropically and along the line towards the second elite
+        const double line_step = random->normal(0.0, line_sigma);
+        random->fill_normal(random_values.data(), num_des_var, 0.0, iso_std);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            child[j] = constrain_value(x1[j] + random_values[j] + line_step * (x2[j] - x1[j]));
+        }
+    }
+
+    std::fill(offspring_fitness.begin(), offspring_fitness.end(), 0.0);
+    std::fill(offspring_behaviors.begin(), offspring_behaviors.end(), 0.0);
+}
+
+void MapElitesOptim::update_designs()
+{
+    // Place each offspring into the grid
+    for (size_t i = 0; i < offspring.size(); ++i)
+    {
+        insert_offspring(i);
+    }
+
+    // Breed the next offspring from the elites
+    breed_offspring();
+
+    current_generation += 1;
+}
+
+const double* MapElitesOptim::get_design(const size_t i) const
+{
+    if (i >= offspring.size())
+    {
+        throw std::out_of_range("design index out of range for getting variables");
+    }
+    else
+    {
+        return offspring.design(i);
+    }
+}
+
+size_t MapElitesOptim::design_count() const
+{
+    return offspring.size();
+}
+
+size_t MapElitesOptim::design_variable_count() const
+{
+    return num_des_var;
+}
+
+void MapElitesOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (ind >= offspring.size())
+    {
+        throw std::out_of_range("design index out of range for setting fitness");
+    }
+
+    offspring_fitness[ind] = val;
+}
+
+size_t MapElitesOptim::behavior_count() const
+{
+    return grid_sizes.size();
+}
+
+void MapElitesOptim::set_design_behavior(
+    const size_t ind,
+    const double* values)
+{
+    if (ind >= offspring.size())
+    {
+        throw std::out_of_range("design index out of range for setting behavior");
+    }
+
+    std::copy(values, values + grid_sizes.size(), &offspring_behaviors[ind * grid_sizes.size()]);
+}
+
+size_t MapElitesOptim::get_generation() const
+{
+    return current_generation;
+}
+
+size_t MapElitesOptim::elite_count() const
+{
+    return elite_fitness.size();
+}
+
+const double* MapElitesOptim::get_elite_design(const size_t i) const
+{
+    if (i >= elite_count())
+    {
+        throw std::out_of_range("elite index out of range for getting variables");
+    }
+    else
+    {
+        return &elite_designs[i * num_des_var];
+    }
+}
+
+double MapElitesOptim::get_elite_fitness(const size_t i) const
+{
+    if (i >= elite_count())
+    {
+        throw std::out_of_range("elite index out of range for getting fitness");
+    }
+    else
+    {
+        return elite_fitness[i];
+    }
+}
+
+const double* MapElitesOptim::get_elite_behavior(const size_t i) const
+{
+    if (i >= elite_count())
+    {
+        throw std::out_of_range("elite index out of range for getting behavior");
+    }
+    else
+    {
+        return &elite_behaviors[i * grid_sizes.size()];
+    }
+}
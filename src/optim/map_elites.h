@@ -0,0 +1,218 @@
+#ifndef __IO_OPTIM_MAP_ELITES__
+#define __IO_OPTIM_MAP_ELITES__
+
+#include <memory>
+#include <vector>
+
+#include "optim/optimizer.h"
+#include "optim/population.h"
+#include "optim/random.h"
+
+/// <summary>
+/// MapElitesOptim provides the MAP-Elites quality-diversity algorithm. The behavior
+/// space is divided into a grid of cells, each holding the fittest design found with
+/// a behavior in the cell. Each generation the offspring are placed into the grid,
+/// replacing less fit elites, and the next offspring are bred from parents sampled
+/// uniformly from the occupied cells, so that the result is a library of designs
+/// with diverse behaviors
+/// </summary>
+class MapElitesOptim : public Optimizer
+{
+public:
+    /// <summary>
+    /// Constructs the MAP-Elites optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the number of offspring in each generation</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="grid_sizes">the number of cells along each behavior dimension</param>
+    /// <param name="behavior_lower">the lower bound of each behavior dimension</param>
+    /// <param name="behavior_upper">the upper bound of each behavior dimension</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    MapElitesOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        const std::vector<size_t>& grid_sizes,
+        const std::vector<double>& behavior_lower,
+        const std::vector<double>& behavior_upper,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for a given offspring design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Provides the count of the current designs
+    /// </summary>
+    /// <returns>the number of designs in the optimization algorithm</returns>
+    virtual size_t design_count() const override;
+
+    /// <summary>
+    /// Provides the count of the design variables
+    /// </summary>
+    /// <returns>the number of design variables in the optimization</returns>
+    virtual size_t design_variable_count() const override;
+
+    /// <summary>
+    /// Sets the fitness for a given design
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Provides the number of behavior dimensions of the grid
+    /// </summary>
+    /// <returns>the behavior count</returns>
+    virtual size_t behavior_count() const override;
+
+    /// <summary>
+    /// Sets the behavior values for a given design
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="values">the behavior_count() behavior values to assign</param>
+    virtual void set_design_behavior(
+        const size_t ind,
+        const double* values) override;
+
+    /// <summary>
+    /// Places the offspring into the grid and breeds the next offspring
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the current generation count for the optimization steps
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Initializes the designs to random values within the upper and lower bound
+    /// values, clearing the grid
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes the designs to random values roughly surrounding the given
+    /// design variables, clearing the grid
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Provides the number of occupied cells in the grid
+    /// </summary>
+    /// <returns>the elite count</returns>
+    size_t elite_count() const;
+
+    /// <summary>
+    /// Provides the design variables of an elite
+    /// </summary>
+    /// <param name="i">the elite index, in the order the cells were first occupied</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    const double* get_elite_design(const size_t i) const;
+
+    /// <summary>
+    /// Provides the fitness of an elite
+    /// </summary>
+    /// <param name="i">the elite index, in the order the cells were first occupied</param>
+    /// <returns>the fitness</returns>
+    double get_elite_fitness(const size_t i) const;
+
+    /// <summary>
+    /// Provides the behavior values of an elite
+    /// </summary>
+    /// <param name="i">the elite index, in the order the cells were first occupied</param>
+    /// <returns>a pointer to the behavior_count() behavior values</returns>
+    const double* get_elite_behavior(const size_t i) const;
+
+private:
+    /// <summary>
+    /// Determines the grid cell for the given behavior values, clamping values
+    /// outside of the behavior bounds to the edge cells
+    /// </summary>
+    /// <param name="behavior">the behavior values</param>
+    /// <returns>the flat cell index</returns>
+    size_t cell_index(const double* behavior) const;
+
+    /// <summary>
+    /// Places an offspring into its cell if the cell is empty or the offspring is fitter
+    /// </summary>
+    /// <param name="ind">the offspring index</param>
+    void insert_offspring(const size_t ind);
+
+    /// <summary>
+    /// Breeds the offspring from elites of uniformly sampled occupied cells
+    /// </summary>
+    void breed_offspring();
+
+    /// <summary>
+    /// Removes every elite from the grid
+    /// </summary>
+    void clear_grid();
+
+private:
+    /// <summary>
+    /// The standard deviation of the isotropic mutation, as a fraction of the design range
+    /// </summary>
+    static const double iso_sigma;
+
+    /// <summary>
+    /// The standard deviation of the mutation along the line between two elites
+    /// </summary>
+    static const double line_sigma;
+
+    /// <summary>
+    /// Storage for the number of design variables in a solution
+    /// </summary>
+    size_t num_des_var;
+
+    /// <summary>
+    /// Storage for the current generation value for the solution
+    /// </summary>
+    size_t current_generation;
+
+    /// <summary>
+    /// The number of cells along each behavior dimension, and the bounds of each dimension
+    /// </summary>
+    std::vector<size_t> grid_sizes;
+    std::vector<double> behavior_lower;
+    std::vector<double> behavior_upper;
+
+    /// <summary>
+    /// The offspring designs with their fitness and behaviors, stored row-major by design
+    /// </summary>
+    Population offspring;
+    std::vector<double> offspring_fitness;
+    std::vector<double> offspring_behaviors;
+
+    /// <summary>
+    /// The position of each cell's elite in the elite slots, or SIZE_MAX if the cell is empty
+    /// </summary>
+    std::vector<size_t> cell_slots;
+
+    /// <summary>
+    /// The elite slots, in the order their cells were first occupied, with the design
+    /// variables and behaviors stored row-major by slot
+    /// </summary>
+    std::vector<double> elite_designs;
+    std::vector<double> elite_fitness;
+    std::vector<double> elite_behaviors;
+
+    /// <summary>
+    /// Storage for random values drawn in bulk
+    /// </summary>
+    std::vector<double> random_values;
+
+    /// <summary>
+    /// The random number generator
+    /// </summary>
+    std::unique_ptr<RandomSource> random;
+};
+
+#endif
@@ -0,0 +1,680 @@
+#include "optim/neat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+const double NeatOptim::gain_mutation_rate = 0.8;
+const double NeatOptim::gain_replace_rate = 0.1;
+const double NeatOptim::add_link_rate = 0.05;
+const double NeatOptim::add_node_rate = 0.03;
+const double NeatOptim::gain_sigma = 0.05;
+const double NeatOptim::crossover_rate = 0.75;
+const double NeatOptim::disable_rate = 0.75;
+const double NeatOptim::unmatched_coefficient = 1.0;
+const double NeatOptim::gain_coefficient = 0.4;
+const size_t NeatOptim::target_species = 10;
+const double NeatOptim::threshold_step = 0.3;
+const double NeatOptim::survival_fraction = 0.2;
+const size_t NeatOptim::stagnation_limit = 15;
+const size_t NeatOptim::champion_species_size = 5;
+
+// Defines the compatibility threshold of a new population
+static const double initial_compatibility_threshold = 3.0;
+
+// Determines whether the genes, enabled or not, link the first node to the second,
+// so that adding a link back would form a cycle
+static bool has_path(
+    const std::vector<NeatOptim::LinkGene>& genes,
+    const size_t from_node_id,
+    const size_t to_node_id)
+{
+    std::vector<size_t> stack = { from_node_id };
+    std::vector<size_t> visited;
+
+    while (!stack.empty())
+    {
+        const size_t node = stack.back();
+        stack.pop_back();
+
+        if (node == to_node_id)
+        {
+            return true;
+        }
+        else if (std::find(visited.begin(), visited.end(), node) != visited.end())
+        {
+            continue;
+        }
+
+        visited.push_back(node);
+
+        for (const NeatOptim::LinkGene& gene : genes)
+        {
+            if (gene.from_node_id == node)
+            {
+                stack.push_back(gene.to_node_id);
+            }
+        }
+    }
+
+    return false;
+}
+
+NeatOptim::NeatOptim(
+    const size_t num_designs,
+    const size_t num_inputs,
+    const size_t num_outputs,
+    std::unique_ptr<RandomSource> random_source) :
+    num_inputs(num_inputs),
+    num_outputs(num_outputs),
+    current_generation(0),
+    genomes(num_designs),
+    next_genomes(num_designs),
+    next_node_id(num_inputs + 1 + num_outputs),
+    compatibility_threshold(initial_compatibility_threshold),
+    random(std::move(random_source))
+{
+    // Check for valid inputs
+    if (num_designs == 0 || num_inputs == 0 || num_outputs == 0)
+    {
+        throw std::invalid_argument("designs, inputs and outputs must be positive");
+    }
+
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
+    // Define the random initial population values
+    init_population();
+}
+
+size_t NeatOptim::get_innovation(
+    const size_t from_node_id,
+    const size_t to_node_id)
+{
+    const std::pair<size_t, size_t> key(from_node_id, to_node_id);
+
+    const auto it = link_innovations.find(key);
+    if (it != link_innovations.end())
+    {
+        return it->second;
+    }
+
+    const size_t innovation = link_innovations.size();
+    link_innovations[key] = innovation;
+    return innovation;
+}
+
+void NeatOptim::add_gene(
+    Genome& genome,
+    const size_t from_node_id,
+    const size_t to_node_id,
+    const double gain)
+{
+    const LinkGene gene = { get_innovation(from_node_id, to_node_id), from_node_id, to_node_id, gain, true };
+
+    const auto it = std::lower_bound(genome.genes.begin(), genome.genes.end(), gene, [](const LinkGene& g1, const LinkGene& g2)
+    {
+        return g1.innovation < g2.innovation;
+    });
+
+    genome.genes.insert(it, gene);
+}
+
+void NeatOptim::set_minimal_genome(Genome& genome)
+{
+    genome.genes.clear();
+    genome.fitness = 0.0;
+
+    // Link each input and the bias node to each output
+    for (size_t j = 0; j < num_outputs; ++j)
+    {
+        for (size_t i = 0; i <= num_inputs; ++i)
+        {
+            add_gene(genome, i, num_inputs + 1 + j, 0.0);
+        }
+    }
+}
+
+void NeatOptim::init_population()
+{
+    for (Genome& genome : genomes)
+    {
+        set_minimal_genome(genome);
+
+        for (LinkGene& gene : genome.genes)
+        {
+            gene.gain = random->uniform(lower_bound, upper_bound);
+        }
+    }
+
+    species.clear();
+    compatibility_threshold = initial_compatibility_threshold;
+    update_design_variables();
+}
+
+void NeatOptim::init_population(const std::vector<double>& other)
+{
+    if (other.size() != design_variable_count())
+    {
+        throw std::invalid_argument("input design variable size does not match between init vector and optimizer");
+    }
+
+    for (Genome& genome : genomes)
+    {
+        set_minimal_genome(genome);
+
+        // Define a new gain within 25% of the previous value, limiting the results
+        for (LinkGene& gene : genome.genes)
+        {
+            gene.gain = constrain_value(other[gene.innovation] + 0.25 * random->uniform(-1.0, 1.0) * (upper_bound - lower_bound));
+        }
+    }
+
+    species.clear();
+    compatibility_threshold = initial_compatibility_threshold;
+    update_design_variables();
+}
+
+const double* NeatOptim::get_design(const size_t i) const
+{
+    if (i >= genomes.size())
+    {
+        throw std::out_of_range("design index out of range for getting variables");
+    }
+    else
+    {
+        return &design_values[i * design_variable_count()];
+    }
+}
+
+size_t NeatOptim::design_count() const
+{
+    return genomes.size();
+}
+
+size_t NeatOptim::design_variable_count() const
+{
+    return link_innovations.size();
+}
+
+void NeatOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (ind >= genomes.size())
+    {
+        throw std::out_of_range("design index out of range for setting fitness");
+    }
+    else
+    {
+        genomes[ind].fitness = val;
+    }
+}
+
+double NeatOptim::compatibility(
+    const std::vector<LinkGene>& a,
+    const std::vector<LinkGene>& b)
+{
+    size_t num_matching = 0;
+    size_t num_unmatched = 0;
+    double gain_difference = 0.0;
+
+    // Walk both genomes in innovation order
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < a.size() && j < b.size())
+    {
+        if (a[i].innovation == b[j].innovation)
+        {
+            num_matching += 1;
+            gain_difference += std::abs(a[i].gain - b[j].gain);
+            i += 1;
+            j += 1;
+        }
+        else if (a[i].innovation < b[j].innovation)
+        {
+            num_unmatched += 1;
+            i += 1;
+        }
+        else
+        {
+            num_unmatched += 1;
+            j += 1;
+        }
+    }
+
+    num_unmatched += (a.size() - i) + (b.size() - j);
+
+    const double num_genes = static_cast<double>(std::max<size_t>(1, std::max(a.size(), b.size())));
+    const double mean_difference = (num_matching > 0) ? gain_difference / static_cast<double>(num_matching) : 0.0;
+
+    return unmatched_coefficient * static_cast<double>(num_unmatched) / num_genes + gain_coefficient * mean_difference;
+}
+
+void NeatOptim::crossover(
+    const Genome& fitter,
+    const Genome& other,
+    Genome& child)
+{
+    child.genes.clear();
+    child.fitness = 0.0;
+
+    // Take every gene of the fitter parent, so that the child keeps its acyclic topology,
+    // choosing the matching genes from either parent
+    size_t j = 0;
+
+    for (const LinkGene& gene : fitter.genes)
+    {
+        while (j < other.genes.size() && other.genes[j].innovation < gene.innovation)
+        {
+            j += 1;
+        }
+
+        if (j < other.genes.size() && other.genes[j].innovation == gene.innovation)
+        {
+            const LinkGene& match = other.genes[j];
+            LinkGene child_gene = (random->uniform(0.0, 1.0) < 0.5) ? gene : match;
+
+            if (!gene.enabled || !match.enabled)
+            {
+                child_gene.enabled = random->uniform(0.0, 1.0) >= disable_rate;
+            }
+
+            child.genes.push_back(child_gene);
+        }
+        else
+        {
+            child.genes.push_back(gene);
+        }
+    }
+}
+
+void NeatOptim::mutate(Genome& genome)
+{
+    const double range = upper_bound - lower_bound;
+
+    // Perturb the gains, replacing some with new random gains
+    if (random->uniform(0.0, 1.0) < gain_mutation_rate)
+    {
+        for (LinkGene& gene : genome.genes)
+        {
+            if (random->uniform(0.0, 1.0) < gain_replace_rate)
+            {
+                gene.gain = random->uniform(lower_bound, upper_bound);
+            }
+            else
+            {
+                gene.gain = constrain_value(gene.gain + random->normal(0.0, gain_sigma * range));
+            }
+        }
+    }
+
+    // Grow the topology
+    if (random->uniform(0.0, 1.0) < add_link_rate)
+    {
+        mutate_add_link(genome);
+    }
+
+    if (random->uniform(0.0, 1.0) < add_node_rate)
+    {
+        mutate_add_node(genome);
+    }
+}
+
+void NeatOptim::mutate_add_link(Genome& genome)
+{
+    const size_t first_hidden = num_inputs + 1 + num_outputs;
+
+    // Find the hidden nodes of the genome
+    std::vector<size_t> hidden_nodes;
+    for (const LinkGene& gene : genome.genes)
+    {
+        if (gene.from_node_id >= first_hidden)
+        {
+            hidden_nodes.push_back(gene.from_node_id);
+        }
+
+        if (gene.to_node_id >= first_hidden)
+        {
+            hidden_nodes.push_back(gene.to_node_id);
+        }
+    }
+
+    std::sort(hidden_nodes.begin(), hidden_nodes.end());
+    hidden_nodes.erase(std::unique(hidden_nodes.begin(), hidden_nodes.end()), hidden_nodes.end());
+
+    // Links come from the inputs, the bias or a hidden node, and go to an output or a
+    // hidden node, with a limited number of attempts to find a new acyclic link
+    const size_t num_sources = num_inputs + 1 + hidden_nodes.size();
+    const size_t num_targets = num_outputs + hidden_nodes.size();
+    const size_t max_attempts = 20;
+
+    for (size_t attempt = 0; attempt < max_attempts; ++attempt)
+    {
+        const size_t s = random->next_index(num_sources);
+        const size_t t = random->next_index(num_targets);
+
+        const size_t from_node_id = (s <= num_inputs) ? s : hidden_nodes[s - num_inputs - 1];
+        const size_t to_node_id = (t < num_outputs) ? num_inputs + 1 + t : hidden_nodes[t - num_outputs];
+
+        if (from_node_id == to_node_id)
+        {
+            continue;
+        }
+
+        const bool exists = std::any_of(genome.genes.begin(), genome.genes.end(), [from_node_id, to_node_id](const LinkGene& gene)
+        {
+            return gene.from_node_id == from_node_id && gene.to_node_id == to_node_id;
+        });
+
+        if (exists || has_path(genome.genes, to_node_id, from_node_id))
+        {
+            continue;
+        }
+
+        add_gene(genome, from_node_id, to_node_id, random->normal(0.0, gain_sigma * (upper_bound - lower_bound)));
+        return;
+    }
+}
+
+void NeatOptim::mutate_add_node(Genome& genome)
+{
+    // Choose an enabled link to split
+    std::vector<size_t> enabled_genes;
+    for (size_t i = 0; i < genome.genes.size(); ++i)
+    {
+        if (genome.genes[i].enabled)
+        {
+            enabled_genes.push_back(i);
+        }
+    }
+
+    if (enabled_genes.empty())
+    {
+        return;
+    }
+
+    const size_t split_index = enabled_genes[random->next_index(enabled_genes.size())];
+    const LinkGene split = genome.genes[split_index];
+    genome.genes[split_index].enabled = false;
+
+    // Reuse the node from an earlier split of the same innovation, so that the new
+    // genes share their innovation numbers, unless the genome already has the node
+    size_t node_id = next_node_id;
+    const auto it = split_nodes.find(split.innovation);
+
+    if (it == split_nodes.end())
+    {
+        split_nodes[split.innovation] = node_id;
+        next_node_id += 1;
+    }
+    else
+    {
+        const size_t split_node = it->second;
+        const bool has_node = std::any_of(genome.genes.begin(), genome.genes.end(), [split_node](const LinkGene& gene)
+        {
+            return gene.from_node_id == split_node || gene.to_node_id == split_node;
+        });
+
+        if (has_node)
+        {
+            next_node_id += 1;
+        }
+        else
+        {
+            node_id = split_node;
+        }
+    }
+
+    add_gene(genome, split.from_node_id, node_id, 1.0);
+    add_gene(genome, node_id, split.to_node_id, split.gain);
+}
+
+void NeatOptim::speciate()
+{
+    // Place each genome into the first compatible species
+    for (Species& s : species)
+    {
+        s.members.clear();
+    }
+
+    for (size_t i = 0; i < genomes.size(); ++i)
+    {
+        bool placed = false;
+
+        for (Species& s : species)
+        {
+            if (compatibility(genomes[i].genes, s.representative) < compatibility_threshold)
+            {
+                s.members.push_back(i);
+                placed = true;
+                break;
+            }
+        }
+
+        if (!placed)
+        {
+            Species s;
+            s.representative = genomes[i].genes;
+            s.members.push_back(i);
+            s.best_fitness = std::numeric_limits<double>::lowest();
+            s.best_generation = current_generation;
+            species.push_back(s);
+        }
+    }
+
+    species.erase(std::remove_if(species.begin(), species.end(), [](const Species& s)
+    {
+        return s.members.empty();
+    }), species.end());
+
+    // Track the improvement of each species
+    size_t best_species = 0;
+
+    for (size_t k = 0; k < species.size(); ++k)
+    {
+        Species& s = species[k];
+
+        for (const size_t i : s.members)
+        {
+            if (genomes[i].fitness > s.best_fitness)
+            {
+                s.best_fitness = genomes[i].fitness;
+                s.best_generation = current_generation;
+            }
+        }
+
+        if (s.best_fitness > species[best_species].best_fitness)
+        {
+            best_species = k;
+        }
+    }
+
+    // Remove the species that have stopped improving, keeping the best species
+    std::vector<Species> kept;
+    for (size_t k = 0; k < species.size(); ++k)
+    {
+        if (k == best_species || current_generation - species[k].best_generation < stagnation_limit)
+        {
+            kept.push_back(species[k]);
+        }
+    }
+
+    species.swap(kept);
+
+    // Adjust the threshold towards the target number of species
+    if (species.size() < target_species)
+    {
+        compatibility_threshold = std::max(threshold_step, compatibility_threshold - threshold_step);
+    }
+    else if (species.size() > target_species)
+    {
+        compatibility_threshold += threshold_step;
+    }
+}
+
+void NeatOptim::update_designs()
+{
+    speciate();
+
+    // Share the fitness within each species, shifting the fitness to be positive
+    double min_fitness = genomes.front().fitness;
+    for (const Genome& genome : genomes)
+    {
+        min_fitness = std::min(min_fitness, genome.fitness);
+    }
+
+    std::vector<double> species_scores(species.size(), 0.0);
+    double total_score = 0.0;
+
+    for (size_t k = 0; k < species.size(); ++k)
+    {
+        for (const size_t i : species[k].members)
+        {
+            species_scores[k] += genomes[i].fitness - min_fitness + 1e-3;
+        }
+
+        species_scores[k] /= static_cast<double>(species[k].members.size());
+        total_score += species_scores[k];
+    }
+
+    // Allocate the offspring in proportion to the shared fitness, giving the
+    // remaining offspring to the largest remainders
+    const size_t num_designs = genomes.size();
+    std::vector<size_t> offspring(species.size(), 0);
+    std::vector<double> remainders(species.size(), 0.0);
+    size_t num_allocated = 0;
+
+    for (size_t k = 0; k < species.size(); ++k)
+    {
+        const double exact = static_cast<double>(num_designs) * species_scores[k] / total_score;
+        offspring[k] = static_cast<size_t>(std::floor(exact));
+        remainders[k] = exact - static_cast<double>(offspring[k]);
+        num_allocated += offspring[k];
+    }
+
+    std::vector<size_t> remainder_order(species.size(), 0);
+    for (size_t k = 0; k < species.size(); ++k)
+    {
+        remainder_order[k] = k;
+    }
+
+    std::sort(remainder_order.begin(), remainder_order.end(), [&remainders](const size_t k1, const size_t k2)
+    {
+        return remainders[k1] > remainders[k2];
+    });
+
+    for (size_t r = 0; num_allocated < num_designs; r = (r + 1) % species.size())
+    {
+        offspring[remainder_order[r]] += 1;
+        num_allocated += 1;
+    }
+
+    // Breed each species from its fittest members
+    size_t child_index = 0;
+
+    for (size_t k = 0; k < species.size(); ++k)
+    {
+        std::vector<size_t>& members = species[k].members;
+        std::sort(members.begin(), members.end(), [this](const size_t i1, const size_t i2)
+        {
+            return genomes[i1].fitness > genomes[i2].fitness;
+        });
+
+        species[k].representative = genomes[members.front()].genes;
+
+        size_t count = offspring[k];
+        if (count == 0)
+        {
+            continue;
+        }
+
+        // Carry the champion of larger species unchanged
+        if (members.size() >= champion_species_size)
+        {
+            next_genomes[child_index].genes = genomes[members.front()].genes;
+            next_genomes[child_index].fitness = 0.0;
+            child_index += 1;
+            count -= 1;
+        }
+
+        const size_t pool_size = std::max<size_t>(1, static_cast<size_t>(std::ceil(survival_fraction * static_cast<double>(members.size()))));
+
+        for (size_t c = 0; c < count; ++c)
+        {
+            const Genome& parent = genomes[members[random->next_index(pool_size)]];
+            Genome& child = next_genomes[child_index];
+            child_index += 1;
+
+            if (pool_size > 1 && random->uniform(0.0, 1.0) < crossover_rate)
+            {
+                const Genome& mate = genomes[members[random->next_index(pool_size)]];
+                const bool parent_fitter = parent.fitness >= mate.fitness;
+                crossover(parent_fitter ? parent : mate, parent_fitter ? mate : parent, child);
+            }
+            else
+            {
+                child.genes = parent.genes;
+                child.fitness = 0.0;
+            }
+
+            mutate(child);
+        }
+    }
+
+    // Swap to the new generation
+    genomes.swap(next_genomes);
+    current_generation += 1;
+    update_design_variables();
+}
+
+void NeatOptim::update_design_variables()
+{
+    const size_t num_des_var = design_variable_count();
+    design_values.assign(genomes.size() * num_des_var, 0.0);
+
+    for (size_t i = 0; i < genomes.size(); ++i)
+    {
+        for (const LinkGene& gene : genomes[i].genes)
+        {
+            if (gene.enabled)
+            {
+                design_values[i * num_des_var + gene.innovation] = gene.gain;
+            }
+        }
+    }
+}
+
+size_t NeatOptim::get_generation() const
+{
+    return current_generation;
+}
+
+const std::vector<NeatOptim::LinkGene>& NeatOptim::get_genome(const size_t i) const
+{
+    if (i >= genomes.size())
+    {
+        throw std::out_of_range("design index out of range for getting the genome");
+    }
+
+    return genomes[i].genes;
+}
+
+size_t NeatOptim::input_count() const
+{
+    return num_inputs;
+}
+
+size_t NeatOptim::output_count() const
+{
+    return num_outputs;
+}
+
+size_t NeatOptim::species_count() const
+{
+    return species.size();
+}
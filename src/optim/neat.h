@@ -0,0 +1,380 @@
+#ifndef __IO_OPTIM_NEAT__
+#define __IO_OPTIM_NEAT__
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "optim/optimizer.h"
+#include "optim/random.h"
+
+/// <summary>
+/// NeatOptim provides NeuroEvolution of Augmenting Topologies, evolving the link graph
+/// of each network together with its gains. Every genome starts with the minimal
+/// topology, linking each input and the bias to each output, and grows by adding links
+/// and by splitting links with new hidden nodes. Each link gene carries an innovation
+/// number, shared by every genome that makes the same structural change, so that
+/// crossover aligns the genes of two different topologies. Genomes are grouped into
+/// species by their compatibility distance and share the fitness of their species,
+/// so that new topologies are protected while their gains are tuned.
+///
+/// Nodes are numbered with the inputs first, followed by the bias node and then the
+/// outputs, with hidden node IDs following the outputs. The design variables of each
+/// genome are its gains indexed by innovation number, with zero for links the genome
+/// does not have or has disabled, so that identical networks have identical designs
+/// </summary>
+class NeatOptim : public Optimizer
+{
+public:
+    /// <summary>
+    /// Defines a link gene of a genome
+    /// </summary>
+    struct LinkGene
+    {
+        /// <summary>
+        /// The innovation number of the structural change that added the link
+        /// </summary>
+        size_t innovation;
+
+        /// <summary>
+        /// The node the link comes from
+        /// </summary>
+        size_t from_node_id;
+
+        /// <summary>
+        /// The node the link goes to
+        /// </summary>
+        size_t to_node_id;
+
+        /// <summary>
+        /// The gain of the link
+        /// </summary>
+        double gain;
+
+        /// <summary>
+        /// Defines whether the link is expressed in the network
+        /// </summary>
+        bool enabled;
+    };
+
+public:
+    /// <summary>
+    /// Constructs the NEAT optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the number of genomes in each generation</param>
+    /// <param name="num_inputs">the number of non-bias network inputs</param>
+    /// <param name="num_outputs">the number of non-bias network outputs</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    NeatOptim(
+        const size_t num_designs,
+        const size_t num_inputs,
+        const size_t num_outputs,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for a given genome
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() gains, indexed by innovation number</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Provides the count of the current designs
+    /// </summary>
+    /// <returns>the number of genomes in the optimization algorithm</returns>
+    virtual size_t design_count() const override;
+
+    /// <summary>
+    /// Provides the count of the design variables, which grows as innovations are added
+    /// </summary>
+    /// <returns>the number of innovations so far</returns>
+    virtual size_t design_variable_count() const override;
+
+    /// <summary>
+    /// Sets the fitness for a given genome
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Divides the genomes into species and breeds the next generation
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the current generation count for the optimization steps
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Initializes every genome to the minimal topology with random gains within
+    /// the upper and lower bound values, clearing the species
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes every genome to the minimal topology with gains roughly surrounding
+    /// the given design variables of the minimal links, clearing the species
+    /// </summary>
+    /// <param name="other">the design variables to target around, indexed by innovation number</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Provides the link genes of a genome, ordered by innovation number
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>the link genes</returns>
+    const std::vector<LinkGene>& get_genome(const size_t i) const;
+
+    /// <summary>
+    /// Provides the number of non-bias network inputs
+    /// </summary>
+    /// <returns>the input count</returns>
+    size_t input_count() const;
+
+    /// <summary>
+    /// Provides the number of non-bias network outputs
+    /// </summary>
+    /// <returns>the output count</returns>
+    size_t output_count() const;
+
+    /// <summary>
+    /// Provides the number of species in the last generation
+    /// </summary>
+    /// <returns>the species count</returns>
+    size_t species_count() const;
+
+private:
+    /// <summary>
+    /// Defines a genome with its link genes and fitness
+    /// </summary>
+    struct Genome
+    {
+        /// <summary>
+        /// The link genes, ordered by innovation number
+        /// </summary>
+        std::vector<LinkGene> genes;
+
+        /// <summary>
+        /// The fitness of the genome
+        /// </summary>
+        double fitness = 0.0;
+    };
+
+    /// <summary>
+    /// Defines a species of compatible genomes
+    /// </summary>
+    struct Species
+    {
+        /// <summary>
+        /// The genome that new genomes are compared against
+        /// </summary>
+        std::vector<LinkGene> representative;
+
+        /// <summary>
+        /// The genomes in the species in the current generation
+        /// </summary>
+        std::vector<size_t> members;
+
+        /// <summary>
+        /// The best fitness of the species, and the generation it was reached
+        /// </summary>
+        double best_fitness = 0.0;
+        size_t best_generation = 0;
+    };
+
+    /// <summary>
+    /// Provides the innovation number for a link between two nodes, adding a new
+    /// innovation if the link has not been added before
+    /// </summary>
+    /// <param name="from_node_id">the node the link comes from</param>
+    /// <param name="to_node_id">the node the link goes to</param>
+    /// <returns>the innovation number</returns>
+    size_t get_innovation(
+        const size_t from_node_id,
+        const size_t to_node_id);
+
+    /// <summary>
+    /// Adds a link gene to the genome, keeping the genes ordered by innovation number
+    /// </summary>
+    /// <param name="genome">the genome to add to</param>
+    /// <param name="from_node_id">the node the link comes from</param>
+    /// <param name="to_node_id">the node the link goes to</param>
+    /// <param name="gain">the gain of the link</param>
+    void add_gene(
+        Genome& genome,
+        const size_t from_node_id,
+        const size_t to_node_id,
+        const double gain);
+
+    /// <summary>
+    /// Sets the genome to the minimal topology with zero gains
+    /// </summary>
+    /// <param name="genome">the genome to set</param>
+    void set_minimal_genome(Genome& genome);
+
+    /// <summary>
+    /// Provides the compatibility distance between two genomes, from the fraction of
+    /// unmatched genes and the mean gain difference of the matching genes
+    /// </summary>
+    /// <param name="a">the genes of the first genome</param>
+    /// <param name="b">the genes of the second genome</param>
+    /// <returns>the compatibility distance</returns>
+    static double compatibility(
+        const std::vector<LinkGene>& a,
+        const std::vector<LinkGene>& b);
+
+    /// <summary>
+    /// Breeds a child by crossover, taking matching genes from either parent and the
+    /// unmatched genes from the fitter parent
+    /// </summary>
+    /// <param name="fitter">the fitter parent</param>
+    /// <param name="other">the other parent</param>
+    /// <param name="child">the child genome to set</param>
+    void crossover(
+        const Genome& fitter,
+        const Genome& other,
+        Genome& child);
+
+    /// <summary>
+    /// Mutates the gains and the topology of a genome
+    /// </summary>
+    /// <param name="genome">the genome to mutate</param>
+    void mutate(Genome& genome);
+
+    /// <summary>
+    /// Adds a link between two unlinked nodes of the genome, where the link would
+    /// not form a cycle
+    /// </summary>
+    /// <param name="genome">the genome to mutate</param>
+    void mutate_add_link(Genome& genome);
+
+    /// <summary>
+    /// Splits an enabled link of the genome with a new hidden node, disabling the link
+    /// and adding a link into the node with unit gain and a link out of the node with
+    /// the gain of the split link
+    /// </summary>
+    /// <param name="genome">the genome to mutate</param>
+    void mutate_add_node(Genome& genome);
+
+    /// <summary>
+    /// Places each genome into the first species it is compatible with, creating new
+    /// species as needed, and removes empty and stagnant species
+    /// </summary>
+    void speciate();
+
+    /// <summary>
+    /// Sets the design variables of each genome from its enabled genes
+    /// </summary>
+    void update_design_variables();
+
+private:
+    /// <summary>
+    /// The probabilities of each mutation for a child genome
+    /// </summary>
+    static const double gain_mutation_rate;
+    static const double gain_replace_rate;
+    static const double add_link_rate;
+    static const double add_node_rate;
+
+    /// <summary>
+    /// The standard deviation of the gain perturbations, as a fraction of the design range
+    /// </summary>
+    static const double gain_sigma;
+
+    /// <summary>
+    /// The probability that a child is bred by crossover rather than cloned, and the
+    /// probability that a gene disabled in either parent is disabled in the child
+    /// </summary>
+    static const double crossover_rate;
+    static const double disable_rate;
+
+    /// <summary>
+    /// The weights of the unmatched gene fraction and the mean gain difference in
+    /// the compatibility distance
+    /// </summary>
+    static const double unmatched_coefficient;
+    static const double gain_coefficient;
+
+    /// <summary>
+    /// The number of species the compatibility threshold is adjusted towards, and the
+    /// size of each adjustment
+    /// </summary>
+    static const size_t target_species;
+    static const double threshold_step;
+
+    /// <summary>
+    /// The fraction of each species eligible to breed
+    /// </summary>
+    static const double survival_fraction;
+
+    /// <summary>
+    /// The number of generations a species may go without improving before it is removed
+    /// </summary>
+    static const size_t stagnation_limit;
+
+    /// <summary>
+    /// The species size from which the fittest genome is carried into the next generation unchanged
+    /// </summary>
+    static const size_t champion_species_size;
+
+    /// <summary>
+    /// The number of non-bias network inputs and outputs
+    /// </summary>
+    size_t num_inputs;
+    size_t num_outputs;
+
+    /// <summary>
+    /// Storage for the current generation value for the solution
+    /// </summary>
+    size_t current_generation;
+
+    /// <summary>
+    /// The current genomes, and the genomes of the next generation
+    /// </summary>
+    std::vector<Genome> genomes;
+    std::vector<Genome> next_genomes;
+
+    /// <summary>
+    /// The innovation number of each link added so far, keyed by its nodes
+    /// </summary>
+    std::map<std::pair<size_t, size_t>, size_t> link_innovations;
+
+    /// <summary>
+    /// The hidden node added by splitting each innovation so far, keyed by the innovation
+    /// </summary>
+    std::map<size_t, size_t> split_nodes;
+
+    /// <summary>
+    /// The ID of the next new hidden node
+    /// </summary>
+    size_t next_node_id;
+
+    /// <summary>
+    /// The species of the current generation
+    /// </summary>
+    std::vector<Species> species;
+
+    /// <summary>
+    /// The compatibility distance below which a genome joins a species
+    /// </summary>
+    double compatibility_threshold;
+
+    /// <summary>
+    /// The design variables of each genome, stored row-major by design
+    /// </summary>
+    std::vector<double> design_values;
+
+    /// <summary>
+    /// The random number generator
+    /// </summary>
+    std::unique_ptr<RandomSource> random;
+};
+
+#endif
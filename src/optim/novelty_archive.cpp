@@ -0,0 +1,210 @@
+#include "optim/novelty_archive.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+const size_t NoveltyArchive::leaf_size = 8;
+
+NoveltyArchive::NoveltyArchive(
+    const size_t descriptor_size,
+    const size_t num_neighbors,
+    const size_t max_entries) :
+    num_values(descriptor_size),
+    num_neighbors(num_neighbors),
+    max_entries(max_entries)
+{
+    // Check for valid inputs
+    if (descriptor_size == 0 || num_neighbors == 0 || max_entries == 0)
+    {
+        throw std::invalid_argument("descriptor size, neighbors and archive size must be positive");
+    }
+
+    nearest.reserve(num_neighbors + 1);
+}
+
+double NoveltyArchive::novelty(const double* descriptor)
+{
+    const size_t count = size();
+    if (count == 0)
+    {
+        return 0.0;
+    }
+
+    nearest.clear();
+    search(descriptor, 0, count);
+
+    double sum = 0.0;
+    for (const double dist_sq : nearest)
+    {
+        sum += std::sqrt(dist_sq);
+    }
+
+    return sum / static_cast<double>(nearest.size());
+}
+
+void NoveltyArchive::insert(
+    const double* descriptors,
+    const size_t count)
+{
+    entries.insert(entries.end(), descriptors, descriptors + count * num_values);
+
+    // Remove the oldest descriptors past the archive limit
+    if (size() > max_entries)
+    {
+        entries.erase(entries.begin(), entries.begin() + (size() - max_entries) * num_values);
+    }
+
+    // Rebuild the tree over every descriptor
+    const size_t num_entries = size();
+
+    tree_order.resize(num_entries);
+    std::iota(tree_order.begin(), tree_order.end(), 0);
+    split_dims.assign(num_entries, 0);
+
+    build(0, num_entries);
+
+    tree_points.resize(entries.size());
+    for (size_t i = 0; i < num_entries; ++i)
+    {
+        std::copy(&entries[tree_order[i] * num_values], &entries[(tree_order[i] + 1) * num_values], &tree_points[i * num_values]);
+    }
+}
+
+void NoveltyArchive::clear()
+{
+    entries.clear();
+    tree_order.clear();
+    tree_points.clear();
+    split_dims.clear();
+}
+
+size_t NoveltyArchive::size() const
+{
+    return entries.size() / num_values;
+}
+
+size_t NoveltyArchive::descriptor_size() const
+{
+    return num_values;
+}
+
+void NoveltyArchive::build(
+    const size_t begin,
+    const size_t end)
+{
+    if (end - begin <= leaf_size)
+    {
+        return;
+    }
+
+    // Split on the dimension with the largest spread
+    size_t dim = 0;
+    double max_spread = -1.0;
+
+    for (size_t d = 0; d < num_values; ++d)
+    {
+        double lower = entries[tree_order[begin] * num_values + d];
+        double upper = lower;
+
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+            const double value = entries[tree_order[i] * num_values + d];
+            lower = std::min(lower, value);
+            upper = std::max(upper, value);
+        }
+
+        if (upper - lower > max_spread)
+        {
+            max_spread = upper - lower;
+            dim = d;
+        }
+    }
+
+    // Place the median of the split dimension in the middle of the range
+    const size_t mid = begin + (end - begin) / 2;
+    std::nth_element(tree_order.begin() + begin, tree_order.begin() + mid, tree_order.begin() + end, [this, dim](const size_t i1, const size_t i2)
+    {
+        return entries[i1 * num_values + dim] < entries[i2 * num_values + dim];
+    });
+
+    split_dims[mid] = dim;
+
+    build(begin, mid);
+    build(mid + 1, end);
+}
+
+void NoveltyArchive::search(
+    const double* descriptor,
+    const size_t begin,
+    const size_t end)
+{
+    // Scan small ranges directly
+    if (end - begin <= leaf_size)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const double* point = &tree_points[i * num_values];
+
+            double dist_sq = 0.0;
+            for (size_t d = 0; d < num_values; ++d)
+            {
+                const double diff = descriptor[d] - point[d];
+                dist_sq += diff * diff;
+            }
+
+            add_neighbor(dist_sq);
+        }
+
+        return;
+    }
+
+    // Check the median of the range
+    const size_t mid = begin + (end - begin) / 2;
+    const double* point = &tree_points[mid * num_values];
+
+    double dist_sq = 0.0;
+    for (size_t d = 0; d < num_values; ++d)
+    {
+        const double diff = descriptor[d] - point[d];
+        dist_sq += diff * diff;
+    }
+
+    add_neighbor(dist_sq);
+
+    // Search the side of the split containing the descriptor first, and the other
+    // side only if it may contain a nearer neighbor
+    const size_t dim = split_dims[mid];
+    const double split_diff = descriptor[dim] - point[dim];
+
+    if (split_diff < 0.0)
+    {
+        search(descriptor, begin, mid);
+        if (nearest.size() < num_neighbors || split_diff * split_diff < nearest.back())
+        {
+            search(descriptor, mid + 1, end);
+        }
+    }
+    else
+    {
+        search(descriptor, mid + 1, end);
+        if (nearest.size() < num_neighbors || split_diff * split_diff < nearest.back())
+        {
+            search(descriptor, begin, mid);
+        }
+    }
+}
+
+void NoveltyArchive::add_neighbor(const double dist_sq)
+{
+    if (nearest.size() < num_neighbors)
+    {
+        nearest.insert(std::upper_bound(nearest.begin(), nearest.end(), dist_sq), dist_sq);
+    }
+    else if (dist_sq < nearest.back())
+    {
+        nearest.pop_back();
+        nearest.insert(std::upper_bound(nearest.begin(), nearest.end(), dist_sq), dist_sq);
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef __IO_OPTIM_NOVELTY_ARCHIVE__
+#define __IO_OPTIM_NOVELTY_ARCHIVE__
+
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// NoveltyArchive stores the behavior descriptors of past designs for novelty
+/// search, where the novelty of a behavior is its mean distance to the nearest
+/// archived behaviors. The descriptors are indexed by a KD-tree, rebuilt after each
+/// insertion, so that the nearest neighbor queries avoid a scan of the full archive.
+/// Once the archive is full the oldest descriptors are removed first
+/// </summary>
+class NoveltyArchive
+{
+public:
+    /// <summary>
+    /// Constructs an empty novelty archive
+    /// </summary>
+    /// <param name="descriptor_size">the number of values in each behavior descriptor</param>
+    /// <param name="num_neighbors">the number of nearest neighbors averaged for the novelty</param>
+    /// <param name="max_entries">the largest number of descriptors kept in the archive</param>
+    NoveltyArchive(
+        const size_t descriptor_size,
+        const size_t num_neighbors,
+        const size_t max_entries);
+
+    /// <summary>
+    /// Provides the novelty of a behavior, as the mean distance to the nearest
+    /// archived descriptors
+    /// </summary>
+    /// <param name="descriptor">the descriptor_size() behavior values</param>
+    /// <returns>the novelty, or zero if the archive is empty</returns>
+    double novelty(const double* descriptor);
+
+    /// <summary>
+    /// Adds behavior descriptors to the archive and rebuilds the tree
+    /// </summary>
+    /// <param name="descriptors">the descriptors, stored row-major by behavior</param>
+    /// <param name="count">the number of descriptors to add</param>
+    void insert(
+        const double* descriptors,
+        const size_t count);
+
+    /// <summary>
+    /// Removes every descriptor from the archive
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Provides the number of descriptors in the archive
+    /// </summary>
+    /// <returns>the archive size</returns>
+    size_t size() const;
+
+    /// <summary>
+    /// Provides the number of values in each behavior descriptor
+    /// </summary>
+    /// <returns>the descriptor size</returns>
+    size_t descriptor_size() const;
+
+private:
+    /// <summary>
+    /// Builds the tree over a range of the tree order, splitting at the median of
+    /// the dimension with the largest spread
+    /// </summary>
+    /// <param name="begin">the start of the range</param>
+    /// <param name="end">the end of the range</param>
+    void build(
+        const size_t begin,
+        const size_t end);
+
+    /// <summary>
+    /// Searches a range of the tree for the nearest neighbors of the descriptor,
+    /// updating the nearest squared distances found so far
+    /// </summary>
+    /// <param name="descriptor">the behavior to search for</param>
+    /// <param name="begin">the start of the range</param>
+    /// <param name="end">the end of the range</param>
+    void search(
+        const double* descriptor,
+        const size_t begin,
+        const size_t end);
+
+    /// <summary>
+    /// Adds a squared distance to the nearest distances if it is among the nearest
+    /// </summary>
+    /// <param name="dist_sq">the squared distance</param>
+    void add_neighbor(const double dist_sq);
+
+private:
+    /// <summary>
+    /// The largest range of the tree searched by a linear scan
+    /// </summary>
+    static const size_t leaf_size;
+
+    /// <summary>
+    /// The number of values in each descriptor
+    /// </summary>
+    size_t num_values;
+
+    /// <summary>
+    /// The number of nearest neighbors for the novelty
+    /// </summary>
+    size_t num_neighbors;
+
+    /// <summary>
+    /// The largest number of descriptors kept
+    /// </summary>
+    size_t max_entries;
+
+    /// <summary>
+    /// The descriptors in insertion order, stored row-major by behavior
+    /// </summary>
+    std::vector<double> entries;
+
+    /// <summary>
+    /// The entry indices in tree order, where the median of each range splits it
+    /// </summary>
+    std::vector<size_t> tree_order;
+
+    /// <summary>
+    /// The descriptors in tree order, stored row-major so that the ranges searched
+    /// together are contiguous
+    /// </summary>
+    std::vector<double> tree_points;
+
+    /// <summary>
+    /// The split dimension of the median of each range in tree order
+    /// </summary>
+    std::vector<size_t> split_dims;
+
+    /// <summary>
+    /// The nearest squared distances of the current query, sorted ascending
+    /// </summary>
+    std::vector<double> nearest;
+};
+
+#endif
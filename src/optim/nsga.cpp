@@ -0,0 +1,524 @@
+#include "optim/nsga.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+const double NsgaOptim::mutation_scale = 0.05;
+const size_t NsgaOptim::archive_limit = 100;
+
+// Sets the crowding distance of each member, as the sum over the objectives of the
+// normalized gap between the neighbors of the member, with the extremes of each
+// objective given an infinite distance so that the ends of the front are kept
+static void crowding_distances(
+    const double* objectives,
+    const size_t num_objectives,
+    const std::vector<size_t>& members,
+    std::vector<double>& distances)
+{
+    const size_t count = members.size();
+    distances.assign(count, 0.0);
+
+    if (count <= 2)
+    {
+        std::fill(distances.begin(), distances.end(), std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    std::vector<size_t> order(count, 0);
+
+    for (size_t m = 0; m < num_objectives; ++m)
+    {
+        for (size_t k = 0; k < count; ++k)
+        {
+            order[k] = k;
+        }
+
+        std::sort(order.begin(), order.end(), [&](const size_t k1, const size_t k2)
+        {
+            return objectives[members[k1] * num_objectives + m] < objectives[members[k2] * num_objectives + m];
+        });
+
+        const double lower = objectives[members[order.front()] * num_objectives + m];
+        const double upper = objectives[members[order.back()] * num_objectives + m];
+
+        distances[order.front()] = std::numeric_limits<double>::infinity();
+        distances[order.back()] = std::numeric_limits<double>::infinity();
+
+        if (upper <= lower)
+        {
+            continue;
+        }
+
+        for (size_t k = 1; k + 1 < count; ++k)
+        {
+            const double next = objectives[members[order[k + 1]] * num_objectives + m];
+            const double prev = objectives[members[order[k - 1]] * num_objectives + m];
+            distances[order[k]] += (next - prev) / (upper - lower);
+        }
+    }
+}
+
+NsgaOptim::NsgaOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    const size_t num_objectives,
+    std::unique_ptr<RandomSource> random_source) :
+    num_des_var(num_des_var),
+    num_objectives(num_objectives),
+    current_generation(0),
+    parents_evaluated(false),
+    parents(num_designs, num_des_var),
+    next_parents(num_designs, num_des_var),
+    offspring(num_designs, num_des_var),
+    parent_objectives(num_designs * num_objectives, 0.0),
+    offspring_objectives(num_designs * num_objectives, 0.0),
+    combined_objectives(2 * num_designs * num_objectives, 0.0),
+    ranks(2 * num_designs, 0),
+    crowding(2 * num_designs, 0.0),
+    parent_ranks(num_designs, 0),
+    parent_crowding(num_designs, 0.0),
+    domination_counts(2 * num_designs, 0),
+    dominated_designs(4 * num_designs * num_designs, 0),
+    dominated_sizes(2 * num_designs, 0),
+    random_values(num_des_var, 0.0),
+    random(std::move(random_source))
+{
+    // Check for valid inputs
+    if (num_designs < 2 || num_des_var == 0 || num_objectives == 0)
+    {
+        throw std::invalid_argument("population must have at least two designs, and design variables and objectives must be positive");
+    }
+
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
+    // Define the random initial population values
+    init_population();
+}
+
+void NsgaOptim::init_population()
+{
+    // Loop through each design
+    for (size_t i = 0; i < offspring.size(); ++i)
+    {
+        // Define a new random variable for each design variable
+        random->fill_uniform(offspring.design(i), num_des_var, lower_bound, upper_bound);
+    }
+
+    std::fill(offspring_objectives.begin(), offspring_objectives.end(), 0.0);
+    archive_designs.clear();
+    archive_objectives.clear();
+    parents_evaluated = false;
+}
+
+void NsgaOptim::init_population(const std::vector<double>& other)
+{
+    if (other.size() != design_variable_count())
+    {
+        throw std::invalid_argument("input design variable size does not match between init vector and optimizer");
+    }
+
+    // Loop through each design
+    for (size_t i = 0; i < offspring.size(); ++i)
+    {
+        // Define a new design variable within 25% of the previous value, limiting the results
+        double* desvars = offspring.design(i);
+        random->fill_uniform(desvars, num_des_var, -1.0, 1.0);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            desvars[j] = constrain_value(other[j] + 0.25 * desvars[j] * (upper_bound - lower_bound));
+        }
+    }
+
+    std::fill(offspring_objectives.begin(), offspring_objectives.end(), 0.0);
+    archive_designs.clear();
+    archive_objectives.clear();
+    parents_evaluated = false;
+}
+
+bool NsgaOptim::dominates(
+    const double* a,
+    const double* b) const
+{
+    bool better = false;
+    for (size_t m = 0; m < num_objectives; ++m)
+    {
+        if (a[m] < b[m])
+        {
+            return false;
+        }
+        else if (a[m] > b[m])
+        {
+            better = true;
+        }
+    }
+
+    return better;
+}
+
+const double* NsgaOptim::combined_design(const size_t i) const
+{
+    return (i < parents.size()) ? parents.design(i) : offspring.design(i - parents.size());
+}
+
+void NsgaOptim::sort_fronts(const size_t count)
+{
+    const size_t stride = ranks.size();
+
+    // Compare each pair of designs once, recording which designs each dominates
+    std::fill(domination_counts.begin(), domination_counts.begin() + count, 0);
+    std::fill(dominated_sizes.begin(), dominated_sizes.begin() + count, 0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double* obj_i = &combined_objectives[i * num_objectives];
+
+        for (size_t j = i + 1; j < count; ++j)
+        {
+            const double* obj_j = &combined_objectives[j * num_objectives];
+
+            if (dominates(obj_i, obj_j))
+            {
+                dominated_designs[i * stride + dominated_sizes[i]++] = j;
+                domination_counts[j] += 1;
+            }
+            else if (dominates(obj_j, obj_i))
+            {
+                dominated_designs[j * stride + dominated_sizes[j]++] = i;
+                domination_counts[i] += 1;
+            }
+        }
+    }
+
+    // Peel off each front, starting with the designs that no design dominates
+    front_order.clear();
+    front_starts.clear();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (domination_counts[i] == 0)
+        {
+            ranks[i] = 0;
+            front_order.push_back(i);
+        }
+    }
+
+    size_t begin = 0;
+    size_t rank = 0;
+    front_starts.push_back(0);
+
+    while (begin < front_order.size())
+    {
+        const size_t end = front_order.size();
+
+        for (size_t k = begin; k < end; ++k)
+        {
+            const size_t i = front_order[k];
+
+            for (size_t d = 0; d < dominated_sizes[i]; ++d)
+            {
+                const size_t j = dominated_designs[i * stride + d];
+                domination_counts[j] -= 1;
+
+                if (domination_counts[j] == 0)
+                {
+                    ranks[j] = rank + 1;
+                    front_order.push_back(j);
+                }
+            }
+        }
+
+        front_starts.push_back(end);
+        begin = end;
+        rank += 1;
+    }
+
+    // Determine the crowding distance within each front
+    std::vector<size_t> members;
+    std::vector<double> distances;
+
+    for (size_t f = 0; f + 1 < front_starts.size(); ++f)
+    {
+        members.assign(front_order.begin() + front_starts[f], front_order.begin() + front_starts[f + 1]);
+        crowding_distances(combined_objectives.data(), num_objectives, members, distances);
+
+        for (size_t k = 0; k < members.size(); ++k)
+        {
+            crowding[members[k]] = distances[k];
+        }
+    }
+}
+
+size_t NsgaOptim::tournament()
+{
+    const size_t i1 = random->next_index(parents.size());
+    size_t i2 = i1;
+
+    while (i1 == i2)
+    {
+        i2 = random->next_index(parents.size());
+    }
+
+    if (parent_ranks[i1] != parent_ranks[i2])
+    {
+        return (parent_ranks[i1] < parent_ranks[i2]) ? i1 : i2;
+    }
+    else
+    {
+        return (parent_crowding[i1] >= parent_crowding[i2]) ? i1 : i2;
+    }
+}
+
+void NsgaOptim::breed_offspring()
+{
+    const double scale = mutation_scale * (upper_bound - lower_bound);
+
+    for (size_t i = 0; i < offspring.size(); ++i)
+    {
+        const double* x1 = parents.design(tournament());
+        const double* x2 = parents.design(tournament());
+        double* child = offspring.design(i);
+
+        // Blend the parents with a random weight and add a uniform mutation
+        const double w = random->uniform(0.0, 1.0);
+        random->fill_uniform(random_values.data(), num_des_var, -scale, scale);
+
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            child[j] = constrain_value(w * x1[j] + (1.0 - w) * x2[j] + random_values[j]);
+        }
+    }
+
+    std::fill(offspring_objectives.begin(), offspring_objectives.end(), 0.0);
+}
+
+void NsgaOptim::update_archive()
+{
+    // Gather the archived designs and the non-dominated parents as candidates
+    std::vector<double> candidate_designs = archive_designs;
+    std::vector<double> candidate_objectives = archive_objectives;
+
+    for (size_t i = 0; i < parents.size(); ++i)
+    {
+        if (parent_ranks[i] == 0)
+        {
+            candidate_designs.insert(candidate_designs.end(), parents.design(i), parents.design(i) + num_des_var);
+            candidate_objectives.insert(candidate_objectives.end(), &parent_objectives[i * num_objectives], &parent_objectives[(i + 1) * num_objectives]);
+        }
+    }
+
+    // Keep the candidates that no other candidate dominates, removing repeated objectives
+    const size_t num_candidates = candidate_objectives.size() / num_objectives;
+    std::vector<size_t> members;
+
+    for (size_t i = 0; i < num_candidates; ++i)
+    {
+        const double* obj_i = &candidate_objectives[i * num_objectives];
+        bool keep = true;
+
+        for (size_t j = 0; j < num_candidates && keep; ++j)
+        {
+            const double* obj_j = &candidate_objectives[j * num_objectives];
+            const bool repeated = j < i && std::equal(obj_i, obj_i + num_objectives, obj_j);
+            keep = !repeated && !dominates(obj_j, obj_i);
+        }
+
+        if (keep)
+        {
+            members.push_back(i);
+        }
+    }
+
+    // Keep the least crowded members past the archive limit
+    if (members.size() > archive_limit)
+    {
+        std::vector<double> distances;
+        crowding_distances(candidate_objectives.data(), num_objectives, members, distances);
+
+        std::vector<size_t> order(members.size(), 0);
+        for (size_t k = 0; k < order.size(); ++k)
+        {
+            order[k] = k;
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&](const size_t k1, const size_t k2)
+        {
+            return distances[k1] > distances[k2];
+        });
+
+        std::vector<size_t> kept(archive_limit, 0);
+        for (size_t k = 0; k < archive_limit; ++k)
+        {
+            kept[k] = members[order[k]];
+        }
+
+        std::sort(kept.begin(), kept.end());
+        members = kept;
+    }
+
+    // Store the new archive
+    archive_designs.resize(members.size() * num_des_var);
+    archive_objectives.resize(members.size() * num_objectives);
+
+    for (size_t k = 0; k < members.size(); ++k)
+    {
+        std::memcpy(&archive_designs[k * num_des_var], &candidate_designs[members[k] * num_des_var], num_des_var * sizeof(double));
+        std::memcpy(&archive_objectives[k * num_objectives], &candidate_objectives[members[k] * num_objectives], num_objectives * sizeof(double));
+    }
+}
+
+void NsgaOptim::update_designs()
+{
+    const size_t num_designs = parents.size();
+
+    if (!parents_evaluated)
+    {
+        // The initial offspring become the first parents
+        parents.swap(offspring);
+        parent_objectives = offspring_objectives;
+
+        std::copy(parent_objectives.begin(), parent_objectives.end(), combined_objectives.begin());
+        sort_fronts(num_designs);
+
+        std::copy(ranks.begin(), ranks.begin() + num_designs, parent_ranks.begin());
+        std::copy(crowding.begin(), crowding.begin() + num_designs, parent_crowding.begin());
+
+        parents_evaluated = true;
+    }
+    else
+    {
+        // Rank the parents and offspring together
+        std::copy(parent_objectives.begin(), parent_objectives.end(), combined_objectives.begin());
+        std::copy(offspring_objectives.begin(), offspring_objectives.end(), combined_objectives.begin() + parent_objectives.size());
+        sort_fronts(2 * num_designs);
+
+        // Take whole fronts while they fit, and then the least crowded designs of the next front
+        size_t selected = 0;
+
+        for (size_t f = 0; f + 1 < front_starts.size() && selected < num_designs; ++f)
+        {
+            const auto begin = front_order.begin() + front_starts[f];
+            const auto end = front_order.begin() + front_starts[f + 1];
+
+            if (selected + static_cast<size_t>(end - begin) > num_designs)
+            {
+                std::stable_sort(begin, end, [this](const size_t i1, const size_t i2)
+                {
+                    return crowding[i1] > crowding[i2];
+                });
+            }
+
+            for (auto it = begin; it != end && selected < num_designs; ++it)
+            {
+                const size_t c = *it;
+
+                std::memcpy(next_parents.design(selected), combined_design(c), num_des_var * sizeof(double));
+                std::memcpy(&parent_objectives[selected * num_objectives], &combined_objectives[c * num_objectives], num_objectives * sizeof(double));
+                parent_ranks[selected] = ranks[c];
+                parent_crowding[selected] = crowding[c];
+
+                selected += 1;
+            }
+        }
+
+        parents.swap(next_parents);
+    }
+
+    // Keep the non-dominated designs and breed the next offspring
+    update_archive();
+    breed_offspring();
+
+    current_generation += 1;
+}
+
+const double* NsgaOptim::get_design(const size_t i) const
+{
+    if (i >= offspring.size())
+    {
+        throw std::out_of_range("design index out of range for getting variables");
+    }
+    else
+    {
+        return offspring.design(i);
+    }
+}
+
+size_t NsgaOptim::design_count() const
+{
+    return offspring.size();
+}
+
+size_t NsgaOptim::design_variable_count() const
+{
+    return num_des_var;
+}
+
+void NsgaOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (ind >= offspring.size())
+    {
+        throw std::out_of_range("design index out of range for setting fitness");
+    }
+
+    double* objectives = &offspring_objectives[ind * num_objectives];
+    std::fill(objectives, objectives + num_objectives, 0.0);
+    objectives[0] = val;
+}
+
+size_t NsgaOptim::objective_count() const
+{
+    return num_objectives;
+}
+
+void NsgaOptim::set_design_objectives(
+    const size_t ind,
+    const double* values)
+{
+    if (ind >= offspring.size())
+    {
+        throw std::out_of_range("design index out of range for setting objectives");
+    }
+
+    std::copy(values, values + num_objectives, &offspring_objectives[ind * num_objectives]);
+}
+
+size_t NsgaOptim::get_generation() const
+{
+    return current_generation;
+}
+
+size_t NsgaOptim::archive_size() const
+{
+    return archive_objectives.size() / num_objectives;
+}
+
+const double* NsgaOptim::get_archive_design(const size_t i) const
+{
+    if (i >= archive_size())
+    {
+        throw std::out_of_range("archive index out of range for getting variables");
+    }
+    else
+    {
+        return &archive_designs[i * num_des_var];
+    }
+}
+
+const double* NsgaOptim::get_archive_objectives(const size_t i) const
+{
+    if (i >= archive_size())
+    {
+        throw std::out_of_range("archive index out of range for getting objectives");
+    }
+    else
+    {
+        return &archive_objectives[i * num_objectives];
+    }
+}
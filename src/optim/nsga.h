@@ -0,0 +1,260 @@
+#ifndef __IO_OPTIM_NSGA__
+#define __IO_OPTIM_NSGA__
+
+#include <memory>
+#include <vector>
+
+#include "optim/optimizer.h"
+#include "optim/population.h"
+#include "optim/random.h"
+
+/// <summary>
+/// NsgaOptim provides the NSGA-II multi-objective genetic algorithm, maximizing each
+/// objective. The parents and offspring are ranked together by fast non-dominated
+/// sorting, with ties within a front broken by crowding distance, and the best ranked
+/// designs become the next parents. An archive of the non-dominated designs found
+/// over all generations is kept so that the trade-off between objectives can be
+/// chosen after the optimization
+/// </summary>
+class NsgaOptim : public Optimizer
+{
+public:
+    /// <summary>
+    /// Constructs the NSGA-II optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the number of designs in each generation, at least two</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="num_objectives">the number of objectives to maximize, at least one</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    NsgaOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        const size_t num_objectives,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for a given offspring design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Provides the count of the current designs
+    /// </summary>
+    /// <returns>the number of designs in the optimization algorithm</returns>
+    virtual size_t design_count() const override;
+
+    /// <summary>
+    /// Provides the count of the design variables
+    /// </summary>
+    /// <returns>the number of design variables in the optimization</returns>
+    virtual size_t design_variable_count() const override;
+
+    /// <summary>
+    /// Sets the first objective for a given design, with the other objectives set to zero
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Provides the number of objectives maximized for each design
+    /// </summary>
+    /// <returns>the objective count</returns>
+    virtual size_t objective_count() const override;
+
+    /// <summary>
+    /// Sets the objective values for a given design
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="values">the objective_count() objective values to assign</param>
+    virtual void set_design_objectives(
+        const size_t ind,
+        const double* values) override;
+
+    /// <summary>
+    /// Selects the next parents from the parents and offspring, updates the
+    /// archive and breeds the next offspring
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the current generation count for the optimization steps
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Initializes the designs to random values within the upper and lower bound
+    /// values, clearing the parents and the archive
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes the designs to random values roughly surrounding the given
+    /// design variables, clearing the parents and the archive
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Provides the number of designs in the archive of non-dominated designs
+    /// </summary>
+    /// <returns>the archive size</returns>
+    size_t archive_size() const;
+
+    /// <summary>
+    /// Provides the design variables of an archived design
+    /// </summary>
+    /// <param name="i">the archive index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    const double* get_archive_design(const size_t i) const;
+
+    /// <summary>
+    /// Provides the objective values of an archived design
+    /// </summary>
+    /// <param name="i">the archive index</param>
+    /// <returns>a pointer to the objective_count() objective values</returns>
+    const double* get_archive_objectives(const size_t i) const;
+
+private:
+    /// <summary>
+    /// Provides the design variables of a design in the combined parents and offspring
+    /// </summary>
+    /// <param name="i">the combined index, with offspring after the parents</param>
+    /// <returns>the design variables</returns>
+    const double* combined_design(const size_t i) const;
+
+    /// <summary>
+    /// Sorts the first count designs of the combined objectives into non-dominated
+    /// fronts, setting front_order, front_starts and the rank of each design
+    /// </summary>
+    /// <param name="count">the number of designs to sort</param>
+    void sort_fronts(const size_t count);
+
+    /// <summary>
+    /// Selects a parent by binary tournament on rank and then crowding distance
+    /// </summary>
+    /// <returns>the parent index</returns>
+    size_t tournament();
+
+    /// <summary>
+    /// Breeds the offspring from the parents
+    /// </summary>
+    void breed_offspring();
+
+    /// <summary>
+    /// Adds the non-dominated parents to the archive, removing archived designs
+    /// that become dominated and the most crowded designs past the archive limit
+    /// </summary>
+    void update_archive();
+
+    /// <summary>
+    /// Determines whether the first objective vector dominates the second
+    /// </summary>
+    /// <param name="a">the first objective values</param>
+    /// <param name="b">the second objective values</param>
+    /// <returns>true if a is no worse in every objective and better in at least one</returns>
+    bool dominates(
+        const double* a,
+        const double* b) const;
+
+private:
+    /// <summary>
+    /// The mutation half-width, as a fraction of the design range
+    /// </summary>
+    static const double mutation_scale;
+
+    /// <summary>
+    /// The largest number of designs kept in the archive
+    /// </summary>
+    static const size_t archive_limit;
+
+    /// <summary>
+    /// Storage for the number of design variables in a solution
+    /// </summary>
+    size_t num_des_var;
+
+    /// <summary>
+    /// Storage for the number of objectives
+    /// </summary>
+    size_t num_objectives;
+
+    /// <summary>
+    /// Storage for the current generation value for the solution
+    /// </summary>
+    size_t current_generation;
+
+    /// <summary>
+    /// Defines whether the parents have objective values. Until they do, the
+    /// offspring are the initial designs and become the first parents
+    /// </summary>
+    bool parents_evaluated;
+
+    /// <summary>
+    /// The parent designs, the next parent designs and the offspring designs
+    /// </summary>
+    Population parents;
+    Population next_parents;
+    Population offspring;
+
+    /// <summary>
+    /// The objectives of the parents and the offspring, stored row-major by design
+    /// </summary>
+    std::vector<double> parent_objectives;
+    std::vector<double> offspring_objectives;
+
+    /// <summary>
+    /// The objectives of the parents followed by the offspring, stored row-major by design
+    /// </summary>
+    std::vector<double> combined_objectives;
+
+    /// <summary>
+    /// The combined design indices ordered by front, with the start of each front
+    /// in front_starts and a final entry for the end of the last front
+    /// </summary>
+    std::vector<size_t> front_order;
+    std::vector<size_t> front_starts;
+
+    /// <summary>
+    /// The front rank and crowding distance of each combined design
+    /// </summary>
+    std::vector<size_t> ranks;
+    std::vector<double> crowding;
+
+    /// <summary>
+    /// The front rank and crowding distance of each parent
+    /// </summary>
+    std::vector<size_t> parent_ranks;
+    std::vector<double> parent_crowding;
+
+    /// <summary>
+    /// The number of designs that dominate each combined design, and the designs
+    /// each combined design dominates, stored with a row of the combined size per design
+    /// </summary>
+    std::vector<size_t> domination_counts;
+    std::vector<size_t> dominated_designs;
+    std::vector<size_t> dominated_sizes;
+
+    /// <summary>
+    /// The design variables and objectives of the archived designs, stored row-major by design
+    /// </summary>
+    std::vector<double> archive_designs;
+    std::vector<double> archive_objectives;
+
+    /// <summary>
+    /// Storage for random values drawn in bulk
+    /// </summary>
+    std::vector<double> random_values;
+
+    /// <summary>
+    /// The random number generator
+    /// </summary>
+    std::unique_ptr<RandomSource> random;
+};
+
+#endif
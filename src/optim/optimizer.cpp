@@ -0,0 +1,51 @@
+#include "optim/optimizer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+static const double bound_value = 10.0;
+
+const double Optimizer::lower_bound = -bound_value;
+const double Optimizer::upper_bound = bound_value;
+
+double Optimizer::constrain_value(const double val)
+{
+    return std::min(upper_bound, std::max(lower_bound, val));
+}
+
+size_t Optimizer::objective_count() const
+{
+    return 1;
+}
+
+void Optimizer::set_design_objectives(
+    const size_t ind,
+    const double* values)
+{
+    set_design_fitness(ind, values[0]);
+}
+
+void Optimizer::seed_population(
+    const std::vector<std::vector<double>>& seeds,
+    const double,
+    const double)
+{
+    if (seeds.empty())
+    {
+        throw std::invalid_argument("at least one seed design must be provided");
+    }
+
+    init_population(seeds.front());
+}
+
+size_t Optimizer::behavior_count() const
+{
+    return 0;
+}
+
+void Optimizer::set_design_behavior(
+    const size_t,
+    const double*)
+{
+    // Behaviors are not used by default
+}
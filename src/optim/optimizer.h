@@ -0,0 +1,138 @@
+#ifndef __IO_OPTIM_OPTIMIZER__
+#define __IO_OPTIM_OPTIMIZER__
+
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// Optimizer defines the ask/tell interface for the optimization algorithms. The
+/// current designs are requested with get_design, each is given a fitness score to
+/// maximize with set_design_fitness, and update_designs then forms the next designs
+/// </summary>
+class Optimizer
+{
+public:
+    /// <summary>
+    /// Destructs the optimizer
+    /// </summary>
+    virtual ~Optimizer() = default;
+
+    /// <summary>
+    /// Obtain the design variables for a given design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const = 0;
+
+    /// <summary>
+    /// Provides the count of the current designs
+    /// </summary>
+    /// <returns>the number of designs in the optimization algorithm</returns>
+    virtual size_t design_count() const = 0;
+
+    /// <summary>
+    /// Provides the count of the design variables
+    /// </summary>
+    /// <returns>the number of design variables in the optimization</returns>
+    virtual size_t design_variable_count() const = 0;
+
+    /// <summary>
+    /// Sets the fitness score for a given design
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) = 0;
+
+    /// <summary>
+    /// Provides the number of objectives maximized for each design
+    /// </summary>
+    /// <returns>the objective count, which is one unless overridden</returns>
+    virtual size_t objective_count() const;
+
+    /// <summary>
+    /// Sets the objective values for a given design. Single-objective optimizers
+    /// take the first value as the fitness
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="values">the objective_count() objective values to assign</param>
+    virtual void set_design_objectives(
+        const size_t ind,
+        const double* values);
+
+    /// <summary>
+    /// Provides the number of behavior values used to place each design
+    /// </summary>
+    /// <returns>the behavior count, which is zero unless overridden</returns>
+    virtual size_t behavior_count() const;
+
+    /// <summary>
+    /// Sets the behavior values for a given design, which are ignored by
+    /// optimizers that do not use behaviors
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="values">the behavior_count() behavior values to assign</param>
+    virtual void set_design_behavior(
+        const size_t ind,
+        const double* values);
+
+    /// <summary>
+    /// Updates the designs once all new fitness values are assigned
+    /// </summary>
+    virtual void update_designs() = 0;
+
+    /// <summary>
+    /// Provides the current generation count for the optimization steps
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const = 0;
+
+    /// <summary>
+    /// Initializes the designs to random values within the upper and lower bound values
+    /// </summary>
+    virtual void init_population() = 0;
+
+    /// <summary>
+    /// Initializes the designs to random values roughly surrounding
+    /// the given design variables
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) = 0;
+
+    /// <summary>
+    /// Initializes the designs from several seed designs, such as previously saved
+    /// networks. Optimizers without a population to fill search around the first seed
+    /// unless overridden
+    /// </summary>
+    /// <param name="seeds">the seed design variables, ordered from the most preferred</param>
+    /// <param name="spread">the scale of the random offsets added to the seeded designs,
+    /// as a fraction of the design range</param>
+    /// <param name="interpolation_rate">the probability that a seeded design is
+    /// interpolated between two seeds rather than taken from one</param>
+    virtual void seed_population(
+        const std::vector<std::vector<double>>& seeds,
+        const double spread,
+        const double interpolation_rate);
+
+protected:
+    /// <summary>
+    /// Constrains the input value between the upper and lower bound
+    /// </summary>
+    /// <param name="val">value to constrain</param>
+    /// <returns>constrained value</returns>
+    static double constrain_value(const double val);
+
+protected:
+    /// <summary>
+    /// The lower-bound of the design space
+    /// </summary>
+    static const double lower_bound;
+
+    /// <summary>
+    /// The upper-bound of the design space
+    /// </summary>
+    static const double upper_bound;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include "optim/population.h"
+
+#include <algorithm>
+
+Population::Population(
+    const size_t num_designs,
+    const size_t num_des_var) :
+    num_designs(num_designs),
+    num_des_var(num_des_var)
+{
+    // Pad each row to a whole number of aligned blocks
+    const size_t block_size = row_alignment / sizeof(double);
+    row_stride = ((num_des_var + block_size - 1) / block_size) * block_size;
+
+    values.assign(num_designs * row_stride, 0.0);
+    fitness_values.assign(num_designs, 0.0);
+    step_sizes.assign(num_designs, 0.0);
+}
+
+double* Population::design(const size_t i)
+{
+    return &values[i * row_stride];
+}
+
+const double* Population::design(const size_t i) const
+{
+    return &values[i * row_stride];
+}
+
+double& Population::fitness(const size_t i)
+{
+    return fitness_values[i];
+}
+
+double Population::fitness(const size_t i) const
+{
+    return fitness_values[i];
+}
+
+void Population::reset_fitness()
+{
+    std::fill(fitness_values.begin(), fitness_values.end(), 0.0);
+}
+
+double& Population::step_size(const size_t i)
+{
+    return step_sizes[i];
+}
+
+double Population::step_size(const size_t i) const
+{
+    return step_sizes[i];
+}
+
+size_t Population::size() const
+{
+    return num_designs;
+}
+
+size_t Population::variable_count() const
+{
+    return num_des_var;
+}
+
+void Population::swap(Population& other)
+{
+    std::swap(num_designs, other.num_designs);
+    std::swap(num_des_var, other.num_des_var);
+    std::swap(row_stride, other.row_stride);
+    values.swap(other.values);
+    fitness_values.swap(other.fitness_values);
+    step_sizes.swap(other.step_sizes);
+}
@@ -0,0 +1,211 @@
+#ifndef __IO_OPTIM_POPULATION__
+#define __IO_OPTIM_POPULATION__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/// <summary>
+/// Provides an allocator that aligns each allocation to the given byte alignment, a
+/// power of two. The storage is over-allocated and the aligned block is preceded by
+/// the pointer returned by operator new, so that no aligned operator new is required
+/// </summary>
+template <typename T, size_t Alignment>
+class AlignedAllocator
+{
+public:
+    /// <summary>
+    /// The type of value allocated
+    /// </summary>
+    typedef T value_type;
+
+    /// <summary>
+    /// Provides the allocator type for another value type
+    /// </summary>
+    template <typename U>
+    struct rebind
+    {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+public:
+    /// <summary>
+    /// Constructs the allocator
+    /// </summary>
+    AlignedAllocator() = default;
+
+    /// <summary>
+    /// Constructs the allocator from an allocator for another value type
+    /// </summary>
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+        // Empty Constructor
+    }
+
+    /// <summary>
+    /// Allocates aligned storage for the given number of values
+    /// </summary>
+    /// <param name="n">the number of values</param>
+    /// <returns>a pointer to the storage</returns>
+    T* allocate(const size_t n)
+    {
+        void* raw = ::operator new(n * sizeof(T) + Alignment + sizeof(void*));
+        const uintptr_t address = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1);
+
+        void** aligned = reinterpret_cast<void**>(address);
+        aligned[-1] = raw;
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    /// <summary>
+    /// Releases storage provided by allocate
+    /// </summary>
+    /// <param name="ptr">the pointer to release</param>
+    void deallocate(T* ptr, const size_t)
+    {
+        ::operator delete(reinterpret_cast<void**>(ptr)[-1]);
+    }
+
+    /// <summary>
+    /// Provides true, as any instance may release storage from another
+    /// </summary>
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const
+    {
+        return true;
+    }
+
+    /// <summary>
+    /// Provides false, as any instance may release storage from another
+    /// </summary>
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const
+    {
+        return false;
+    }
+};
+
+/// <summary>
+/// Population stores the design variables of each design as the rows of a single
+/// contiguous matrix, with each row aligned to a cache line, along with separate
+/// arrays of the fitness and the mutation step size of each design
+/// </summary>
+class Population
+{
+public:
+    /// <summary>
+    /// Constructs the population with all design variables, fitness values and step sizes set to zero
+    /// </summary>
+    /// <param name="num_designs">the number of designs</param>
+    /// <param name="num_des_var">the number of design variables in each design</param>
+    Population(
+        const size_t num_designs,
+        const size_t num_des_var);
+
+    /// <summary>
+    /// Provides the design variables for the given design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design variable_count() design variables</returns>
+    double* design(const size_t i);
+
+    /// <summary>
+    /// Provides the design variables for the given design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design variable_count() design variables</returns>
+    const double* design(const size_t i) const;
+
+    /// <summary>
+    /// Provides the fitness of the given design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a reference to the fitness value</returns>
+    double& fitness(const size_t i);
+
+    /// <summary>
+    /// Provides the fitness of the given design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>the fitness value</returns>
+    double fitness(const size_t i) const;
+
+    /// <summary>
+    /// Sets the fitness of every design to zero
+    /// </summary>
+    void reset_fitness();
+
+    /// <summary>
+    /// Provides a reference to the mutation step size of the given design, used by
+    /// optimizers that adapt the step size of each design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a reference to the step size</returns>
+    double& step_size(const size_t i);
+
+    /// <summary>
+    /// Provides the mutation step size of the given design
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>the step size</returns>
+    double step_size(const size_t i) const;
+
+    /// <summary>
+    /// Provides the number of designs
+    /// </summary>
+    /// <returns>the design count</returns>
+    size_t size() const;
+
+    /// <summary>
+    /// Provides the number of design variables in each design
+    /// </summary>
+    /// <returns>the design variable count</returns>
+    size_t variable_count() const;
+
+    /// <summary>
+    /// Exchanges the contents of the two populations without copying
+    /// </summary>
+    /// <param name="other">the population to swap with</param>
+    void swap(Population& other);
+
+private:
+    /// <summary>
+    /// The byte alignment of each design row
+    /// </summary>
+    static const size_t row_alignment = 64;
+
+    /// <summary>
+    /// The number of designs
+    /// </summary>
+    size_t num_designs;
+
+    /// <summary>
+    /// The number of design variables in each design
+    /// </summary>
+    size_t num_des_var;
+
+    /// <summary>
+    /// The number of values between the start of each design row, padded
+    /// so that each row starts on the row alignment
+    /// </summary>
+    size_t row_stride;
+
+    /// <summary>
+    /// The row-major design variable matrix
+    /// </summary>
+    std::vector<double, AlignedAllocator<double, row_alignment>> values;
+
+    /// <summary>
+    /// The fitness of each design
+    /// </summary>
+    std::vector<double> fitness_values;
+
+    /// <summary>
+    /// The mutation step size of each design
+    /// </summary>
+    std::vector<double> step_sizes;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "optim/racing.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+RacingMonitor::RacingMonitor(
+    const Mode mode,
+    const uint64_t checkpoint_steps,
+    const double percentile) :
+    mode(mode),
+    checkpoint_steps(checkpoint_steps),
+    percentile(percentile)
+{
+    // Check for valid inputs
+    if (checkpoint_steps == 0)
+    {
+        throw std::invalid_argument("racing checkpoint steps must be positive");
+    }
+    else if (!(percentile >= 0.0 && percentile < 1.0))
+    {
+        throw std::invalid_argument("racing percentile must be in [0, 1)");
+    }
+}
+
+void RacingMonitor::start_episode()
+{
+    current_trace.clear();
+    current_aborted = false;
+    abort_step = 0;
+    abort_distance = 0.0;
+}
+
+bool RacingMonitor::check_episode(
+    const uint64_t step_count,
+    const double distance)
+{
+    if (mode == Mode::OFF || step_count == 0 || step_count % checkpoint_steps != 0)
+    {
+        return false;
+    }
+
+    // Record the distance at the checkpoint
+    const size_t checkpoint = current_trace.size();
+    current_trace.push_back(distance);
+
+    // Compare against the previous generation at the same checkpoint
+    if (current_aborted || checkpoint >= thresholds.size() || distance >= thresholds[checkpoint])
+    {
+        return false;
+    }
+
+    current_aborted = true;
+    abort_step = step_count;
+    abort_distance = distance;
+
+    return mode == Mode::ACTIVE;
+}
+
+void RacingMonitor::end_episode(
+    const uint64_t step_count,
+    const double distance)
+{
+    if (mode == Mode::OFF)
+    {
+        return;
+    }
+
+    current_trace.push_back(distance);
+    traces.push_back(current_trace);
+
+    current_stats.simulated_steps += step_count;
+
+    if (current_aborted)
+    {
+        current_stats.aborted += 1;
+
+        // In shadow mode the episode ran to completion, so the cost of aborting is known
+        if (mode == Mode::SHADOW)
+        {
+            current_stats.saved_steps += step_count - abort_step;
+            current_stats.fitness_loss += distance - abort_distance;
+        }
+    }
+
+    start_episode();
+}
+
+void RacingMonitor::end_generation()
+{
+    // Determine the number of checkpoints reached by any episode
+    size_t num_checkpoints = 0;
+    for (const std::vector<double>& trace : traces)
+    {
+        num_checkpoints = std::max(num_checkpoints, trace.size() - 1);
+    }
+
+    // Set each threshold to the percentile of the distances at the checkpoint, where
+    // episodes that ended before the checkpoint are counted at their final distance
+    thresholds.assign(num_checkpoints, 0.0);
+
+    for (size_t k = 0; k < num_checkpoints; ++k)
+    {
+        checkpoint_values.clear();
+        for (const std::vector<double>& trace : traces)
+        {
+            checkpoint_values.push_back(trace[std::min(k, trace.size() - 1)]);
+        }
+
+        const size_t ind = static_cast<size_t>(percentile * static_cast<double>(checkpoint_values.size()));
+        std::nth_element(checkpoint_values.begin(), checkpoint_values.begin() + ind, checkpoint_values.end());
+        thresholds[k] = checkpoint_values[ind];
+    }
+
+    traces.clear();
+
+    last_stats = current_stats;
+    current_stats = GenerationStats();
+}
+
+RacingMonitor::Mode RacingMonitor::get_mode() const
+{
+    return mode;
+}
+
+bool RacingMonitor::was_aborted() const
+{
+    return mode == Mode::ACTIVE && current_aborted;
+}
+
+size_t RacingMonitor::get_aborted_count() const
+{
+    return last_stats.aborted;
+}
+
+uint64_t RacingMonitor::get_simulated_steps() const
+{
+    return last_stats.simulated_steps;
+}
+
+uint64_t RacingMonitor::get_saved_steps() const
+{
+    return last_stats.saved_steps;
+}
+
+double RacingMonitor::get_fitness_loss() const
+{
+    return last_stats.fitness_loss;
+}
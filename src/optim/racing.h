@@ -0,0 +1,178 @@
+#ifndef __IO_OPTIM_RACING__
+#define __IO_OPTIM_RACING__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// RacingMonitor ends episodes early once they fall behind the designs of the
+/// previous generation. The distance of each episode is recorded at fixed step
+/// checkpoints, and an episode is aborted when its distance at a checkpoint is below
+/// the given percentile of the previous generation's distances at that checkpoint,
+/// as such designs rarely win a tournament. In shadow mode, episodes are never
+/// aborted, but the steps that would have been saved and the fitness that would have
+/// been lost are measured
+/// </summary>
+class RacingMonitor
+{
+public:
+    /// <summary>
+    /// Provides the options for how episodes are raced
+    /// </summary>
+    enum class Mode
+    {
+        OFF = 0,
+        SHADOW = 1,
+        ACTIVE = 2
+    };
+
+public:
+    /// <summary>
+    /// Constructs the racing monitor
+    /// </summary>
+    /// <param name="mode">how episodes are raced</param>
+    /// <param name="checkpoint_steps">the number of simulation steps between checkpoints</param>
+    /// <param name="percentile">the fraction of the previous generation an episode must stay ahead of, in [0, 1)</param>
+    RacingMonitor(
+        const Mode mode,
+        const uint64_t checkpoint_steps,
+        const double percentile);
+
+    /// <summary>
+    /// Starts recording a new episode
+    /// </summary>
+    void start_episode();
+
+    /// <summary>
+    /// Checks the episode at the given step, recording its distance at each checkpoint
+    /// </summary>
+    /// <param name="step_count">the number of simulation steps so far</param>
+    /// <param name="distance">the distance traveled so far</param>
+    /// <returns>true if the episode should be aborted</returns>
+    bool check_episode(
+        const uint64_t step_count,
+        const double distance);
+
+    /// <summary>
+    /// Ends the current episode, adding its checkpoint distances to the generation
+    /// </summary>
+    /// <param name="step_count">the number of simulation steps in the episode</param>
+    /// <param name="distance">the final distance traveled</param>
+    void end_episode(
+        const uint64_t step_count,
+        const double distance);
+
+    /// <summary>
+    /// Ends the current generation, setting the checkpoint thresholds from its episodes
+    /// and keeping its statistics for the report
+    /// </summary>
+    void end_generation();
+
+    /// <summary>
+    /// Provides how episodes are raced
+    /// </summary>
+    /// <returns>the racing mode</returns>
+    Mode get_mode() const;
+
+    /// <summary>
+    /// Determines whether the current episode was aborted before it completed, which
+    /// only happens in active mode, and is reset when the episode ends
+    /// </summary>
+    /// <returns>true if the current episode was aborted</returns>
+    bool was_aborted() const;
+
+    /// <summary>
+    /// Provides the number of episodes aborted, or that would have been aborted in
+    /// shadow mode, in the last generation
+    /// </summary>
+    /// <returns>the aborted episode count</returns>
+    size_t get_aborted_count() const;
+
+    /// <summary>
+    /// Provides the number of simulation steps in the last generation
+    /// </summary>
+    /// <returns>the simulated step count</returns>
+    uint64_t get_simulated_steps() const;
+
+    /// <summary>
+    /// Provides the number of simulation steps that aborting would have saved in the
+    /// last generation, which is only measured in shadow mode
+    /// </summary>
+    /// <returns>the saved step count</returns>
+    uint64_t get_saved_steps() const;
+
+    /// <summary>
+    /// Provides the total fitness that aborting would have removed in the last
+    /// generation, which is only measured in shadow mode
+    /// </summary>
+    /// <returns>the summed difference between the final and aborted distances</returns>
+    double get_fitness_loss() const;
+
+private:
+    /// <summary>
+    /// Provides the statistics of the episodes in a generation
+    /// </summary>
+    struct GenerationStats
+    {
+        size_t aborted = 0;
+        uint64_t simulated_steps = 0;
+        uint64_t saved_steps = 0;
+        double fitness_loss = 0.0;
+    };
+
+    /// <summary>
+    /// Defines how episodes are raced
+    /// </summary>
+    Mode mode;
+
+    /// <summary>
+    /// The number of simulation steps between checkpoints
+    /// </summary>
+    uint64_t checkpoint_steps;
+
+    /// <summary>
+    /// The fraction of the previous generation an episode must stay ahead of
+    /// </summary>
+    double percentile;
+
+    /// <summary>
+    /// The minimum distance at each checkpoint, from the previous generation
+    /// </summary>
+    std::vector<double> thresholds;
+
+    /// <summary>
+    /// The checkpoint distances of each episode in the current generation, with
+    /// the final distance appended to each
+    /// </summary>
+    std::vector<std::vector<double>> traces;
+
+    /// <summary>
+    /// The checkpoint distances of the current episode
+    /// </summary>
+    std::vector<double> current_trace;
+
+    /// <summary>
+    /// Defines whether the current episode has fallen below a threshold
+    /// </summary>
+    bool current_aborted = false;
+
+    /// <summary>
+    /// The step count and distance where the current episode fell below a threshold
+    /// </summary>
+    uint64_t abort_step = 0;
+    double abort_distance = 0.0;
+
+    /// <summary>
+    /// The statistics of the current and last generations
+    /// </summary>
+    GenerationStats current_stats;
+    GenerationStats last_stats;
+
+    /// <summary>
+    /// Storage for the distances at a checkpoint when setting the thresholds
+    /// </summary>
+    std::vector<double> checkpoint_values;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "optim/random.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Defines the number of values converted at a time when filling buffers
+static const size_t fill_chunk_size = 256;
+
+// Defines the scale converting the upper 53 bits of a value into [0, 1)
+static const double unit_scale = 1.0 / 9007199254740992.0;
+
+// Rotates the bits of the given value left
+static inline uint64_t rotate_left(
+    const uint64_t val,
+    const int shift)
+{
+    return (val << shift) | (val >> (64 - shift));
+}
+
+// Provides the next value of the splitmix64 sequence used to seed the lanes
+static uint64_t splitmix64(uint64_t& state)
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+double RandomSource::uniform(
+    const double lower,
+    const double upper)
+{
+    double val;
+    fill_uniform(&val, 1, lower, upper);
+    return val;
+}
+
+double RandomSource::normal(
+    const double mean,
+    const double stddev)
+{
+    double val;
+    fill_normal(&val, 1, mean, stddev);
+    return val;
+}
+
+Xoshiro256Random::Xoshiro256Random(const uint64_t seed) :
+    block_index(lane_count)
+{
+    uint64_t seed_state = seed;
+    for (size_t l = 0; l < lane_count; ++l)
+    {
+        for (size_t k = 0; k < 4; ++k)
+        {
+            state[k][l] = splitmix64(seed_state);
+        }
+    }
+
+    std::fill(block, block + lane_count, 0);
+}
+
+void Xoshiro256Random::step_lanes(uint64_t* values)
+{
+    for (size_t l = 0; l < lane_count; ++l)
+    {
+        values[l] = rotate_left(state[0][l] + state[3][l], 23) + state[0][l];
+
+        const uint64_t t = state[1][l] << 17;
+
+        state[2][l] ^= state[0][l];
+        state[3][l] ^= state[1][l];
+        state[1][l] ^= state[2][l];
+        state[0][l] ^= state[3][l];
+
+        state[2][l] ^= t;
+        state[3][l] = rotate_left(state[3][l], 45);
+    }
+}
+
+void Xoshiro256Random::fill_bits(
+    uint64_t* values,
+    const size_t count)
+{
+    size_t i = 0;
+
+    // Use any values remaining from the last block
+    while (i < count && block_index < lane_count)
+    {
+        values[i++] = block[block_index++];
+    }
+
+    // Generate whole blocks directly into the output
+    while (count - i >= lane_count)
+    {
+        step_lanes(&values[i]);
+        i += lane_count;
+    }
+
+    // Generate a new block for any remaining values
+    if (i < count)
+    {
+        step_lanes(block);
+        block_index = 0;
+
+        while (i < count)
+        {
+            values[i++] = block[block_index++];
+        }
+    }
+}
+
+void Xoshiro256Random::fill_uniform(
+    double* values,
+    const size_t count,
+    const double lower,
+    const double upper)
+{
+    uint64_t bits[fill_chunk_size];
+    const double scale = (upper - lower) * unit_scale;
+
+    for (size_t start = 0; start < count; start += fill_chunk_size)
+    {
+        const size_t n = std::min(fill_chunk_size, count - start);
+        fill_bits(bits, n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            values[start + i] = lower + static_cast<double>(bits[i] >> 11) * scale;
+        }
+    }
+}
+
+void Xoshiro256Random::fill_normal(
+    double* values,
+    const size_t count,
+    const double mean,
+    const double stddev)
+{
+    const double two_pi = 6.283185307179586;
+    double uniforms[fill_chunk_size];
+
+    for (size_t start = 0; start < count; start += fill_chunk_size)
+    {
+        const size_t n = std::min(fill_chunk_size, count - start);
+        const size_t num_pairs = (n + 1) / 2;
+
+        fill_uniform(uniforms, 2 * num_pairs, 0.0, 1.0);
+
+        // Transform each pair, using 1 - u so that the logarithm input is never zero
+        for (size_t p = 0; p < num_pairs; ++p)
+        {
+            const double radius = stddev * std::sqrt(-2.0 * std::log(1.0 - uniforms[2 * p]));
+            const double angle = two_pi * uniforms[2 * p + 1];
+
+            values[start + 2 * p] = mean + radius * std::cos(angle);
+            if (2 * p + 1 < n)
+            {
+                values[start + 2 * p + 1] = mean + radius * std::sin(angle);
+            }
+        }
+    }
+}
+
+size_t Xoshiro256Random::next_index(const size_t count)
+{
+    uint64_t bits;
+    fill_bits(&bits, 1);
+
+    const size_t index = static_cast<size_t>(static_cast<double>(bits >> 11) * unit_scale * static_cast<double>(count));
+    return std::min(index, count - 1);
+}
@@ -0,0 +1,161 @@
+#ifndef __IO_OPTIM_RANDOM__
+#define __IO_OPTIM_RANDOM__
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// RandomSource defines the interface for the random number generators used by
+/// the optimizers, providing values in bulk so that whole design vectors may be
+/// filled at once
+/// </summary>
+class RandomSource
+{
+public:
+    /// <summary>
+    /// Destructs the random source
+    /// </summary>
+    virtual ~RandomSource() = default;
+
+    /// <summary>
+    /// Fills the buffer with uniform random values in [lower, upper)
+    /// </summary>
+    /// <param name="values">the buffer to fill</param>
+    /// <param name="count">the number of values to fill</param>
+    /// <param name="lower">the lower bound</param>
+    /// <param name="upper">the upper bound</param>
+    virtual void fill_uniform(
+        double* values,
+        const size_t count,
+        const double lower,
+        const double upper) = 0;
+
+    /// <summary>
+    /// Fills the buffer with normally-distributed random values
+    /// </summary>
+    /// <param name="values">the buffer to fill</param>
+    /// <param name="count">the number of values to fill</param>
+    /// <param name="mean">the mean of the distribution</param>
+    /// <param name="stddev">the standard deviation of the distribution</param>
+    virtual void fill_normal(
+        double* values,
+        const size_t count,
+        const double mean,
+        const double stddev) = 0;
+
+    /// <summary>
+    /// Provides a uniform random index in [0, count)
+    /// </summary>
+    /// <param name="count">the number of indices, at least one</param>
+    /// <returns>the random index</returns>
+    virtual size_t next_index(const size_t count) = 0;
+
+    /// <summary>
+    /// Provides a single uniform random value in [lower, upper)
+    /// </summary>
+    /// <param name="lower">the lower bound</param>
+    /// <param name="upper">the upper bound</param>
+    /// <returns>the random value</returns>
+    double uniform(
+        const double lower,
+        const double upper);
+
+    /// <summary>
+    /// Provides a single normally-distributed random value
+    /// </summary>
+    /// <param name="mean">the mean of the distribution</param>
+    /// <param name="stddev">the standard deviation of the distribution</param>
+    /// <returns>the random value</returns>
+    double normal(
+        const double mean,
+        const double stddev);
+};
+
+/// <summary>
+/// Xoshiro256Random runs four independent xoshiro256++ generators side by side,
+/// with the state stored by word across the lanes so that the compiler may step
+/// all lanes with vector instructions. Values are produced in blocks of one value
+/// per lane, with any unused values of a block kept for the next request
+/// </summary>
+class Xoshiro256Random : public RandomSource
+{
+public:
+    /// <summary>
+    /// Constructs the generator, seeding each lane from the given seed
+    /// </summary>
+    /// <param name="seed">the seed value</param>
+    Xoshiro256Random(const uint64_t seed);
+
+    /// <summary>
+    /// Fills the buffer with uniform random values in [lower, upper)
+    /// </summary>
+    /// <param name="values">the buffer to fill</param>
+    /// <param name="count">the number of values to fill</param>
+    /// <param name="lower">the lower bound</param>
+    /// <param name="upper">the upper bound</param>
+    virtual void fill_uniform(
+        double* values,
+        const size_t count,
+        const double lower,
+        const double upper) override;
+
+    /// <summary>
+    /// Fills the buffer with normally-distributed random values, using the
+    /// Box-Muller transform on pairs of uniform values
+    /// </summary>
+    /// <param name="values">the buffer to fill</param>
+    /// <param name="count">the number of values to fill</param>
+    /// <param name="mean">the mean of the distribution</param>
+    /// <param name="stddev">the standard deviation of the distribution</param>
+    virtual void fill_normal(
+        double* values,
+        const size_t count,
+        const double mean,
+        const double stddev) override;
+
+    /// <summary>
+    /// Provides a uniform random index in [0, count)
+    /// </summary>
+    /// <param name="count">the number of indices, at least one</param>
+    /// <returns>the random index</returns>
+    virtual size_t next_index(const size_t count) override;
+
+private:
+    /// <summary>
+    /// Fills the buffer with random 64-bit values
+    /// </summary>
+    /// <param name="values">the buffer to fill</param>
+    /// <param name="count">the number of values to fill</param>
+    void fill_bits(
+        uint64_t* values,
+        const size_t count);
+
+    /// <summary>
+    /// Steps each lane once, writing one value per lane
+    /// </summary>
+    /// <param name="values">the buffer to write lane_count values into</param>
+    void step_lanes(uint64_t* values);
+
+private:
+    /// <summary>
+    /// The number of generators stepped together
+    /// </summary>
+    static const size_t lane_count = 4;
+
+    /// <summary>
+    /// The four state words, each stored for every lane
+    /// </summary>
+    uint64_t state[4][lane_count];
+
+    /// <summary>
+    /// The values of the last block generated
+    /// </summary>
+    uint64_t block[lane_count];
+
+    /// <summary>
+    /// The index of the next unused value in the last block
+    /// </summary>
+    size_t block_index;
+};
+
+#endif
@@ -0,0 +1,247 @@
+#include "optim/restart.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+const size_t RestartOptim::stagnation_generations = 50;
+const double RestartOptim::improvement_tolerance = 1e-3;
+const double RestartOptim::min_spread = 1e-3;
+const size_t RestartOptim::population_growth = 2;
+const size_t RestartOptim::max_population_factor = 16;
+const double RestartOptim::small_run_spread = 0.05;
+
+RestartOptim::RestartOptim(
+    const Factory& factory,
+    const size_t num_designs,
+    const Strategy strategy,
+    std::unique_ptr<RandomSource> random_source) :
+    factory(factory),
+    strategy(strategy),
+    initial_designs(num_designs),
+    large_designs(num_designs),
+    current_generation(0),
+    run_generation(0),
+    run_best_fitness(std::numeric_limits<double>::lowest()),
+    run_best_generation(0),
+    generation_best_fitness(std::numeric_limits<double>::lowest()),
+    best_fitness(std::numeric_limits<double>::lowest()),
+    generation_spread(0.0),
+    num_restarts(0),
+    small_run(false),
+    large_evaluations(0),
+    small_evaluations(0),
+    random(std::move(random_source))
+{
+    // Check for valid inputs
+    if (!factory || num_designs < 2)
+    {
+        throw std::invalid_argument("restarts require an optimizer factory and at least two designs");
+    }
+
+    if (!random)
+    {
+        random = std::make_unique<Xoshiro256Random>(0);
+    }
+
+    // Create the first run with the optimizer's own seed, so that it matches the
+    // optimizer without restarts
+    optim = factory(num_designs, nullptr);
+    generation_spread = measure_spread();
+}
+
+const double* RestartOptim::get_design(const size_t i) const
+{
+    return optim->get_design(i);
+}
+
+size_t RestartOptim::design_count() const
+{
+    return optim->design_count();
+}
+
+size_t RestartOptim::design_variable_count() const
+{
+    return optim->design_variable_count();
+}
+
+void RestartOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (val > best_fitness)
+    {
+        const double* design = optim->get_design(ind);
+        best_fitness = val;
+        best_design.assign(design, design + optim->design_variable_count());
+    }
+
+    generation_best_fitness = std::max(generation_best_fitness, val);
+    optim->set_design_fitness(ind, val);
+}
+
+void RestartOptim::update_designs()
+{
+    // Reset the stagnation count once the run improves by more than the tolerance
+    if (generation_best_fitness > run_best_fitness + improvement_tolerance * std::max(1.0, std::abs(run_best_fitness)))
+    {
+        run_best_fitness = generation_best_fitness;
+        run_best_generation = run_generation;
+    }
+
+    generation_best_fitness = std::numeric_limits<double>::lowest();
+    generation_spread = measure_spread();
+
+    // Charge the evaluations of the generation to the regime of the run
+    if (small_run)
+    {
+        small_evaluations += optim->design_count();
+    }
+    else
+    {
+        large_evaluations += optim->design_count();
+    }
+
+    current_generation += 1;
+    run_generation += 1;
+
+    // Restart stagnant runs, and otherwise step the current run
+    if (run_generation - run_best_generation >= stagnation_generations || generation_spread < min_spread)
+    {
+        restart();
+    }
+    else
+    {
+        optim->update_designs();
+    }
+}
+
+size_t RestartOptim::get_generation() const
+{
+    return current_generation;
+}
+
+void RestartOptim::init_population()
+{
+    optim->init_population();
+    reset_run();
+}
+
+void RestartOptim::init_population(const std::vector<double>& other)
+{
+    optim->init_population(other);
+    reset_run();
+}
+
+void RestartOptim::seed_population(
+    const std::vector<std::vector<double>>& seeds,
+    const double spread,
+    const double interpolation_rate)
+{
+    optim->seed_population(seeds, spread, interpolation_rate);
+    reset_run();
+}
+
+const Optimizer& RestartOptim::get_optimizer() const
+{
+    return *optim;
+}
+
+size_t RestartOptim::restart_count() const
+{
+    return num_restarts;
+}
+
+double RestartOptim::get_best_fitness() const
+{
+    return best_fitness;
+}
+
+const std::vector<double>& RestartOptim::get_best_design() const
+{
+    return best_design;
+}
+
+double RestartOptim::get_spread() const
+{
+    return generation_spread;
+}
+
+void RestartOptim::restart()
+{
+    // Run the small regime while it has used fewer evaluations than the large regime,
+    // with a population between half the first population and half the large population
+    small_run = strategy == Strategy::BIPOP && small_evaluations < large_evaluations && !best_design.empty();
+
+    size_t num_designs = 0;
+    if (small_run)
+    {
+        const double u = random->uniform(0.0, 1.0);
+        const double ratio = 0.5 * static_cast<double>(large_designs) / static_cast<double>(initial_designs);
+        num_designs = static_cast<size_t>(std::floor(static_cast<double>(initial_designs) * std::pow(ratio, u * u)));
+    }
+    else
+    {
+        large_designs = std::min(large_designs * population_growth, initial_designs * max_population_factor);
+        num_designs = large_designs;
+    }
+
+    // Keep the population even, as required by the mirrored sampling of the evolution strategy
+    num_designs = std::max<size_t>(num_designs - num_designs % 2, 2);
+
+    // Create the run with a new seed, so that runs of the same size differ
+    const uint64_t seed = static_cast<uint64_t>(random->next_index(std::numeric_limits<size_t>::max()));
+    optim = factory(num_designs, std::make_unique<Xoshiro256Random>(seed));
+
+    if (small_run)
+    {
+        optim->seed_population({ best_design }, small_run_spread, 0.0);
+    }
+
+    num_restarts += 1;
+    reset_run();
+}
+
+void RestartOptim::reset_run()
+{
+    run_generation = 0;
+    run_best_fitness = std::numeric_limits<double>::lowest();
+    run_best_generation = 0;
+    generation_best_fitness = std::numeric_limits<double>::lowest();
+}
+
+double RestartOptim::measure_spread() const
+{
+    const size_t num_designs = optim->design_count();
+    const size_t num_des_var = optim->design_variable_count();
+
+    if (num_designs < 2 || num_des_var == 0)
+    {
+        return 0.0;
+    }
+
+    // Accumulate the sums of each design variable in a single pass over the designs
+    std::vector<double> sums(num_des_var, 0.0);
+    std::vector<double> square_sums(num_des_var, 0.0);
+
+    for (size_t i = 0; i < num_designs; ++i)
+    {
+        const double* design = optim->get_design(i);
+        for (size_t j = 0; j < num_des_var; ++j)
+        {
+            sums[j] += design[j];
+            square_sums[j] += design[j] * design[j];
+        }
+    }
+
+    double total = 0.0;
+    for (size_t j = 0; j < num_des_var; ++j)
+    {
+        const double mean = sums[j] / static_cast<double>(num_designs);
+        const double variance = square_sums[j] / static_cast<double>(num_designs) - mean * mean;
+        total += std::sqrt(std::max(variance, 0.0));
+    }
+
+    return total / static_cast<double>(num_des_var) / (upper_bound - lower_bound);
+}
@@ -0,0 +1,262 @@
+#ifndef __IO_OPTIM_RESTART__
+#define __IO_OPTIM_RESTART__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "optim/optimizer.h"
+#include "optim/random.h"
+
+/// <summary>
+/// RestartOptim runs a single-objective optimizer until it stagnates, and then restarts
+/// it with a new population. A run stagnates once its best fitness has not improved for
+/// a number of generations, or once the spread of its designs has collapsed. Restarts
+/// follow the IPOP schedule, doubling the population with each restart, or the BIPOP
+/// schedule, which alternates the doubled populations with smaller populations seeded
+/// around the best design so far, choosing the regime that has used fewer evaluations.
+/// The best design and fitness are kept across restarts
+/// </summary>
+class RestartOptim : public Optimizer
+{
+public:
+    /// <summary>
+    /// Provides options for the restart schedule
+    /// </summary>
+    enum class Strategy
+    {
+        IPOP = 0,
+        BIPOP = 1
+    };
+
+    /// <summary>
+    /// Creates the optimizer for each run, given the population size and the random
+    /// number generator to use, or nullptr for the optimizer's own fixed seed
+    /// </summary>
+    using Factory = std::function<std::unique_ptr<Optimizer>(const size_t, std::unique_ptr<RandomSource>)>;
+
+public:
+    /// <summary>
+    /// Constructs the restart strategy, creating the first run with the given population size
+    /// </summary>
+    /// <param name="factory">creates the optimizer for each run</param>
+    /// <param name="num_designs">the population size of the first run, which the later
+    /// population sizes are scaled from</param>
+    /// <param name="strategy">the restart schedule</param>
+    /// <param name="random_source">the random number generator used to seed each run
+    /// and size the BIPOP populations, or nullptr to use a Xoshiro256Random with a fixed seed</param>
+    RestartOptim(
+        const Factory& factory,
+        const size_t num_designs,
+        const Strategy strategy,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for a given design of the current run
+    /// </summary>
+    /// <param name="i">the design index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Provides the count of the current designs, which changes with each restart
+    /// </summary>
+    /// <returns>the number of designs in the current run</returns>
+    virtual size_t design_count() const override;
+
+    /// <summary>
+    /// Provides the count of the design variables
+    /// </summary>
+    /// <returns>the number of design variables in the optimization</returns>
+    virtual size_t design_variable_count() const override;
+
+    /// <summary>
+    /// Sets the fitness score for a given design, keeping the design if it is the best so far
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Checks the current run for stagnation, restarting it if stagnant and otherwise
+    /// updating its designs
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the current generation count over all runs
+    /// </summary>
+    /// <returns>the number of times update_designs has been called</returns>
+    virtual size_t get_generation() const override;
+
+    /// <summary>
+    /// Initializes the designs of the current run to random values within the upper
+    /// and lower bound values
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes the designs of the current run to random values roughly
+    /// surrounding the given design variables
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Initializes the designs of the current run from several seed designs
+    /// </summary>
+    /// <param name="seeds">the seed design variables, ordered from the most preferred</param>
+    /// <param name="spread">the scale of the random offsets added to the seeded designs,
+    /// as a fraction of the design range</param>
+    /// <param name="interpolation_rate">the probability that a seeded design is
+    /// interpolated between two seeds rather than taken from one</param>
+    virtual void seed_population(
+        const std::vector<std::vector<double>>& seeds,
+        const double spread,
+        const double interpolation_rate) override;
+
+    /// <summary>
+    /// Provides the optimizer of the current run
+    /// </summary>
+    /// <returns>the current optimizer</returns>
+    const Optimizer& get_optimizer() const;
+
+    /// <summary>
+    /// Provides the number of restarts so far
+    /// </summary>
+    /// <returns>the restart count</returns>
+    size_t restart_count() const;
+
+    /// <summary>
+    /// Provides the best fitness over all runs
+    /// </summary>
+    /// <returns>the best fitness, or the lowest value if no fitness has been set</returns>
+    double get_best_fitness() const;
+
+    /// <summary>
+    /// Provides the design with the best fitness over all runs
+    /// </summary>
+    /// <returns>the best design variables, or an empty vector if no fitness has been set</returns>
+    const std::vector<double>& get_best_design() const;
+
+    /// <summary>
+    /// Provides the spread of the designs in the last generation
+    /// </summary>
+    /// <returns>the mean standard deviation of the design variables, as a fraction of the design range</returns>
+    double get_spread() const;
+
+private:
+    /// <summary>
+    /// Replaces the current run with a new optimizer, sized and seeded by the restart schedule
+    /// </summary>
+    void restart();
+
+    /// <summary>
+    /// Clears the stagnation measures of the current run
+    /// </summary>
+    void reset_run();
+
+    /// <summary>
+    /// Measures the mean standard deviation of the design variables of the current run
+    /// </summary>
+    /// <returns>the spread, as a fraction of the design range</returns>
+    double measure_spread() const;
+
+private:
+    /// <summary>
+    /// The number of generations a run may go without improving before it is restarted
+    /// </summary>
+    static const size_t stagnation_generations;
+
+    /// <summary>
+    /// The relative improvement of the best fitness of a run that resets its stagnation count
+    /// </summary>
+    static const double improvement_tolerance;
+
+    /// <summary>
+    /// The spread below which a run is restarted
+    /// </summary>
+    static const double min_spread;
+
+    /// <summary>
+    /// The factor applied to the large population with each large restart, and the
+    /// largest population as a multiple of the first population
+    /// </summary>
+    static const size_t population_growth;
+    static const size_t max_population_factor;
+
+    /// <summary>
+    /// The largest random offset of the designs of a small run seeded around the best
+    /// design, as a fraction of the design range
+    /// </summary>
+    static const double small_run_spread;
+
+    /// <summary>
+    /// Creates the optimizer for each run
+    /// </summary>
+    Factory factory;
+
+    /// <summary>
+    /// The restart schedule
+    /// </summary>
+    Strategy strategy;
+
+    /// <summary>
+    /// The population size of the first run, and of the latest large run
+    /// </summary>
+    size_t initial_designs;
+    size_t large_designs;
+
+    /// <summary>
+    /// The optimizer of the current run
+    /// </summary>
+    std::unique_ptr<Optimizer> optim;
+
+    /// <summary>
+    /// Storage for the current generation over all runs, and within the current run
+    /// </summary>
+    size_t current_generation;
+    size_t run_generation;
+
+    /// <summary>
+    /// The best fitness of the current run, the run generation it last improved, and
+    /// the best fitness of the current generation
+    /// </summary>
+    double run_best_fitness;
+    size_t run_best_generation;
+    double generation_best_fitness;
+
+    /// <summary>
+    /// The best fitness and design over all runs
+    /// </summary>
+    double best_fitness;
+    std::vector<double> best_design;
+
+    /// <summary>
+    /// The spread of the designs in the last generation
+    /// </summary>
+    double generation_spread;
+
+    /// <summary>
+    /// The number of restarts so far
+    /// </summary>
+    size_t num_restarts;
+
+    /// <summary>
+    /// Whether the current run is a small BIPOP run, and the number of evaluations
+    /// used by the large and the small runs
+    /// </summary>
+    bool small_run;
+    uint64_t large_evaluations;
+    uint64_t small_evaluations;
+
+    /// <summary>
+    /// The random number generator
+    /// </summary>
+    std::unique_ptr<RandomSource> random;
+};
+
+#endif
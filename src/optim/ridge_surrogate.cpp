@@ -0,0 +1,152 @@
+#include "optim/ridge_surrogate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+RidgeSurrogate::RidgeSurrogate(
+    const size_t num_features,
+    const double regularization,
+    const double forgetting) :
+    num_features(num_features),
+    regularization(regularization),
+    forgetting(forgetting),
+    gram((num_features + 1) * (num_features + 1), 0.0),
+    moments(num_features + 1, 0.0),
+    weights(num_features + 1, 0.0),
+    factor((num_features + 1) * (num_features + 1), 0.0)
+{
+    // Check for valid inputs
+    if (num_features == 0)
+    {
+        throw std::invalid_argument("surrogate feature count must be positive");
+    }
+    else if (!(regularization > 0.0))
+    {
+        throw std::invalid_argument("surrogate regularization must be positive");
+    }
+    else if (!(forgetting > 0.0 && forgetting <= 1.0))
+    {
+        throw std::invalid_argument("surrogate forgetting factor must be in (0, 1]");
+    }
+}
+
+void RidgeSurrogate::add_sample(
+    const double* features,
+    const double value)
+{
+    const size_t n = num_features + 1;
+
+    // Add the lower triangle of the outer product, with the bias as the last feature
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double x_i = (i < num_features) ? features[i] : 1.0;
+        double* row = &gram[i * n];
+
+        for (size_t j = 0; j < num_features && j <= i; ++j)
+        {
+            row[j] += x_i * features[j];
+        }
+
+        if (i == num_features)
+        {
+            row[num_features] += 1.0;
+        }
+
+        moments[i] += x_i * value;
+    }
+
+    sample_weight += 1.0;
+}
+
+void RidgeSurrogate::fit()
+{
+    if (sample_weight == 0.0)
+    {
+        return;
+    }
+
+    const size_t n = num_features + 1;
+
+    // Factor the regularized normal equations, with the penalty scaled by the sample
+    // weight so that it does not vanish as samples accumulate
+    const double penalty = regularization * sample_weight;
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        double diag = gram[j * n + j] + ((j < num_features) ? penalty : 0.0);
+        for (size_t k = 0; k < j; ++k)
+        {
+            diag -= factor[j * n + k] * factor[j * n + k];
+        }
+
+        // The bias term has no penalty, so guard against a singular factor
+        diag = std::sqrt(std::max(diag, 1e-12));
+        factor[j * n + j] = diag;
+
+        for (size_t i = j + 1; i < n; ++i)
+        {
+            double value = gram[i * n + j];
+            for (size_t k = 0; k < j; ++k)
+            {
+                value -= factor[i * n + k] * factor[j * n + k];
+            }
+
+            factor[i * n + j] = value / diag;
+        }
+    }
+
+    // Solve the lower and then the upper triangular systems
+    for (size_t i = 0; i < n; ++i)
+    {
+        double value = moments[i];
+        for (size_t k = 0; k < i; ++k)
+        {
+            value -= factor[i * n + k] * weights[k];
+        }
+
+        weights[i] = value / factor[i * n + i];
+    }
+
+    for (size_t i = n; i-- > 0;)
+    {
+        double value = weights[i];
+        for (size_t k = i + 1; k < n; ++k)
+        {
+            value -= factor[k * n + i] * weights[k];
+        }
+
+        weights[i] = value / factor[i * n + i];
+    }
+
+    trained = true;
+
+    // Discount the samples added so far
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j <= i; ++j)
+        {
+            gram[i * n + j] *= forgetting;
+        }
+
+        moments[i] *= forgetting;
+    }
+
+    sample_weight *= forgetting;
+}
+
+double RidgeSurrogate::predict(const double* features) const
+{
+    double value = weights[num_features];
+    for (size_t i = 0; i < num_features; ++i)
+    {
+        value += weights[i] * features[i];
+    }
+
+    return value;
+}
+
+bool RidgeSurrogate::is_trained() const
+{
+    return trained;
+}
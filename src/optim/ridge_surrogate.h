@@ -0,0 +1,103 @@
+#ifndef __IO_OPTIM_RIDGE_SURROGATE__
+#define __IO_OPTIM_RIDGE_SURROGATE__
+
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// RidgeSurrogate provides a linear model of the fitness of a design, fit by ridge
+/// regression. Samples are accumulated online into the normal equations, so adding
+/// a sample costs the square of the feature count and fitting costs a Cholesky solve,
+/// regardless of the number of samples. Older samples are discounted by the forgetting
+/// factor after each fit, so that the model follows the region being searched
+/// </summary>
+class RidgeSurrogate
+{
+public:
+    /// <summary>
+    /// Constructs an untrained surrogate
+    /// </summary>
+    /// <param name="num_features">the number of values in each sample</param>
+    /// <param name="regularization">the ridge penalty on the weights, not applied to the bias</param>
+    /// <param name="forgetting">the weight kept by the samples after each fit, in (0, 1]</param>
+    RidgeSurrogate(
+        const size_t num_features,
+        const double regularization,
+        const double forgetting);
+
+    /// <summary>
+    /// Adds a sample to the normal equations
+    /// </summary>
+    /// <param name="features">the num_features values of the sample</param>
+    /// <param name="value">the observed value</param>
+    void add_sample(
+        const double* features,
+        const double value);
+
+    /// <summary>
+    /// Fits the weights to the samples added so far, and then discounts the samples
+    /// </summary>
+    void fit();
+
+    /// <summary>
+    /// Predicts the value of a sample with the fitted weights
+    /// </summary>
+    /// <param name="features">the num_features values of the sample</param>
+    /// <returns>the predicted value, or zero before the first fit</returns>
+    double predict(const double* features) const;
+
+    /// <summary>
+    /// Determines whether the weights have been fit
+    /// </summary>
+    /// <returns>true once fit has been called with samples added</returns>
+    bool is_trained() const;
+
+private:
+    /// <summary>
+    /// The number of values in each sample
+    /// </summary>
+    size_t num_features;
+
+    /// <summary>
+    /// The ridge penalty on the weights
+    /// </summary>
+    double regularization;
+
+    /// <summary>
+    /// The weight kept by the samples after each fit
+    /// </summary>
+    double forgetting;
+
+    /// <summary>
+    /// The sum of the outer products of the samples extended with a bias term,
+    /// stored as a full row-major matrix
+    /// </summary>
+    std::vector<double> gram;
+
+    /// <summary>
+    /// The sum of the samples extended with a bias term, weighted by their values
+    /// </summary>
+    std::vector<double> moments;
+
+    /// <summary>
+    /// The total weight of the samples added
+    /// </summary>
+    double sample_weight = 0.0;
+
+    /// <summary>
+    /// The fitted weights, followed by the bias
+    /// </summary>
+    std::vector<double> weights;
+
+    /// <summary>
+    /// Storage for the Cholesky factor of the regularized normal equations
+    /// </summary>
+    std::vector<double> factor;
+
+    /// <summary>
+    /// Defines whether the weights have been fit
+    /// </summary>
+    bool trained = false;
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include "optim/steady_state_genetic.h"
+
+#include <cstring>
+#include <stdexcept>
+
+SteadyStateGeneticOptim::SteadyStateGeneticOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    std::unique_ptr<RandomSource> random_source) :
+    GeneticOptim(num_designs, num_des_var, std::move(random_source)),
+    num_members(0)
+{
+    // Check for valid inputs
+    if (num_designs < 2)
+    {
+        throw std::invalid_argument("population must have at least two designs");
+    }
+
+    // Move the initial population into the slots
+    reset_slots();
+}
+
+void SteadyStateGeneticOptim::init_population()
+{
+    GeneticOptim::init_population();
+    reset_slots();
+}
+
+void SteadyStateGeneticOptim::init_population(const std::vector<double>& other)
+{
+    GeneticOptim::init_population(other);
+    reset_slots();
+}
+
+void SteadyStateGeneticOptim::seed_population(
+    const std::vector<std::vector<double>>& seeds,
+    const double spread,
+    const double interpolation_rate)
+{
+    GeneticOptim::seed_population(seeds, spread, interpolation_rate);
+    reset_slots();
+}
+
+void SteadyStateGeneticOptim::reset_slots()
+{
+    designs.swap(next_designs);
+    designs.reset_fitness();
+    next_designs.reset_fitness();
+    num_members = 0;
+}
+
+const double* SteadyStateGeneticOptim::get_design(const size_t i) const
+{
+    if (i >= next_designs.size())
+    {
+        throw std::out_of_range("design index out of range for getting variables");
+    }
+    else
+    {
+        return next_designs.design(i);
+    }
+}
+
+size_t SteadyStateGeneticOptim::tournament(const bool fittest)
+{
+    const size_t i1 = random->next_index(num_members);
+    size_t i2 = i1;
+
+    while (i1 == i2)
+    {
+        i2 = random->next_index(num_members);
+    }
+
+    const bool first_fitter = designs.fitness(i1) > designs.fitness(i2);
+    return (first_fitter == fittest) ? i1 : i2;
+}
+
+void SteadyStateGeneticOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    if (ind >= next_designs.size())
+    {
+        throw std::out_of_range("design index out of range for setting fitness");
+    }
+
+    double* child = next_designs.design(ind);
+    next_designs.fitness(ind) = val;
+
+    // Add the child to the population while it fills, and afterwards replace the
+    // loser of a tournament if the child is at least as fit
+    size_t target = designs.size();
+
+    if (num_members < designs.size())
+    {
+        target = num_members;
+        num_members += 1;
+    }
+    else
+    {
+        const size_t loser = tournament(false);
+        if (val >= designs.fitness(loser))
+        {
+            target = loser;
+        }
+    }
+
+    if (target < designs.size())
+    {
+        std::memcpy(designs.design(target), child, num_des_var * sizeof(double));
+        designs.fitness(target) = val;
+        designs.step_size(target) = next_designs.step_size(ind);
+    }
+
+    // Breed the next child for the slot, using a random design until there are
+    // enough members to select two different parents
+    if (num_members >= 2)
+    {
+        const size_t ind1 = tournament(true);
+        const size_t ind2 = tournament(true);
+        next_designs.step_size(ind) = breed_child(ind1, ind2, child);
+    }
+    else
+    {
+        random->fill_uniform(child, num_des_var, lower_bound, upper_bound);
+        next_designs.step_size(ind) = mutation_scale;
+    }
+
+    next_designs.fitness(ind) = 0.0;
+}
+
+void SteadyStateGeneticOptim::update_designs()
+{
+    // Measure the statistics once the population has filled
+    if (num_members == designs.size())
+    {
+        record_generation_stats();
+    }
+
+    current_generation += 1;
+}
+
+size_t SteadyStateGeneticOptim::member_count() const
+{
+    return num_members;
+}
@@ -0,0 +1,102 @@
+#ifndef __IO_STEADY_STATE_GENETIC_OPTIM__
+#define __IO_STEADY_STATE_GENETIC_OPTIM__
+
+#include "optim/genetic.h"
+
+/// <summary>
+/// SteadyStateGeneticOptim provides a genetic optimization algorithm without a
+/// generation barrier. Each design index is an evaluation slot, such as a worker,
+/// holding a child under evaluation. As soon as the fitness of a slot is set, the
+/// child replaces the loser of a tournament in the population if it is at least as
+/// fit, and a new child is bred into the slot, so that no slot waits on the others
+/// </summary>
+class SteadyStateGeneticOptim : public GeneticOptim
+{
+public:
+    /// <summary>
+    /// Constructs the Steady-State Genetic Optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the size of the population and the number of evaluation slots</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    SteadyStateGeneticOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Obtain the design variables for the child in a given slot
+    /// </summary>
+    /// <param name="i">the slot index</param>
+    /// <returns>a pointer to the design_variable_count() design variables</returns>
+    virtual const double* get_design(const size_t i) const override;
+
+    /// <summary>
+    /// Sets the fitness score for the child in a given slot, inserting it into the
+    /// population and breeding a new child into the slot
+    /// </summary>
+    /// <param name="ind">the slot index</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Increments the generation count. The designs are updated as each fitness is
+    /// set, so this only marks that design_count() more fitness values have been set
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Initializes the slots to random values within the upper and lower bound
+    /// values, clearing the population
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes the slots to random values roughly surrounding the given
+    /// design variables, clearing the population
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Initializes the slots from several seed designs, clearing the population
+    /// </summary>
+    /// <param name="seeds">the seed design variables, ordered from the most preferred</param>
+    /// <param name="spread">the largest random offset, as a fraction of the design range</param>
+    /// <param name="interpolation_rate">the probability that a design is interpolated between two seeds</param>
+    virtual void seed_population(
+        const std::vector<std::vector<double>>& seeds,
+        const double spread,
+        const double interpolation_rate) override;
+
+    /// <summary>
+    /// Provides the number of evaluated designs in the population
+    /// </summary>
+    /// <returns>the population member count, up to design_count()</returns>
+    size_t member_count() const;
+
+protected:
+    /// <summary>
+    /// Moves the initialized designs into the slots and clears the population
+    /// </summary>
+    void reset_slots();
+
+    /// <summary>
+    /// Selects a population member by binary tournament
+    /// </summary>
+    /// <param name="fittest">true to select the fitter member, false to select the less fit member</param>
+    /// <returns>the selected member index</returns>
+    size_t tournament(const bool fittest);
+
+protected:
+    /// <summary>
+    /// The number of evaluated designs in the population, which fills before
+    /// children begin to replace members
+    /// </summary>
+    size_t num_members;
+};
+
+#endif
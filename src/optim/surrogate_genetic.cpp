@@ -0,0 +1,205 @@
+#include "optim/surrogate_genetic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+const double SurrogateGeneticOptim::surrogate_regularization = 1.0;
+const double SurrogateGeneticOptim::surrogate_forgetting = 0.5;
+
+// Sets the rank of each value in ascending order, with tied values given their mean rank
+static void average_ranks(
+    const std::vector<double>& values,
+    std::vector<double>& ranks)
+{
+    std::vector<size_t> order(values.size(), 0);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&values](const size_t i1, const size_t i2)
+    {
+        return values[i1] < values[i2];
+    });
+
+    ranks.assign(values.size(), 0.0);
+
+    size_t begin = 0;
+    while (begin < order.size())
+    {
+        size_t end = begin + 1;
+        while (end < order.size() && values[order[end]] == values[order[begin]])
+        {
+            end += 1;
+        }
+
+        const double rank = 0.5 * static_cast<double>(begin + end - 1);
+        for (size_t k = begin; k < end; ++k)
+        {
+            ranks[order[k]] = rank;
+        }
+
+        begin = end;
+    }
+}
+
+// Provides the Spearman rank correlation between two sets of values, as the
+// correlation of their ranks, or zero if either set has a single rank
+static double rank_correlation_of(
+    const std::vector<double>& a,
+    const std::vector<double>& b)
+{
+    std::vector<double> ranks_a;
+    std::vector<double> ranks_b;
+    average_ranks(a, ranks_a);
+    average_ranks(b, ranks_b);
+
+    const double mean = 0.5 * static_cast<double>(a.size() - 1);
+
+    double cov = 0.0;
+    double var_a = 0.0;
+    double var_b = 0.0;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        const double da = ranks_a[i] - mean;
+        const double db = ranks_b[i] - mean;
+        cov += da * db;
+        var_a += da * da;
+        var_b += db * db;
+    }
+
+    if (var_a == 0.0 || var_b == 0.0)
+    {
+        return 0.0;
+    }
+    else
+    {
+        return cov / std::sqrt(var_a * var_b);
+    }
+}
+
+SurrogateGeneticOptim::SurrogateGeneticOptim(
+    const size_t num_designs,
+    const size_t num_des_var,
+    const size_t candidate_factor,
+    std::unique_ptr<RandomSource> random_source) :
+    GeneticOptim(num_designs, num_des_var, std::move(random_source)),
+    candidate_factor(candidate_factor),
+    surrogate(num_des_var, surrogate_regularization, surrogate_forgetting),
+    candidates(num_designs * std::max<size_t>(candidate_factor, 1), num_des_var),
+    candidate_order(num_designs * std::max<size_t>(candidate_factor, 1), 0),
+    predicted_fitness(num_designs, 0.0)
+{
+    // Check for valid inputs
+    if (num_designs < 2 || candidate_factor == 0)
+    {
+        throw std::invalid_argument("population must have at least two designs and the candidate factor must be positive");
+    }
+}
+
+void SurrogateGeneticOptim::init_population()
+{
+    GeneticOptim::init_population();
+    designs_predicted = false;
+}
+
+void SurrogateGeneticOptim::init_population(const std::vector<double>& other)
+{
+    GeneticOptim::init_population(other);
+    designs_predicted = false;
+}
+
+void SurrogateGeneticOptim::seed_population(
+    const std::vector<std::vector<double>>& seeds,
+    const double spread,
+    const double interpolation_rate)
+{
+    GeneticOptim::seed_population(seeds, spread, interpolation_rate);
+    designs_predicted = false;
+}
+
+void SurrogateGeneticOptim::set_design_fitness(
+    const size_t ind,
+    const double val)
+{
+    GeneticOptim::set_design_fitness(ind, val);
+    surrogate.add_sample(designs.design(ind), val);
+}
+
+void SurrogateGeneticOptim::update_designs()
+{
+    const size_t num_designs = designs.size();
+    record_generation_stats();
+
+    // Measure how well the surrogate ranked the simulated designs
+    if (designs_predicted)
+    {
+        std::vector<double> fitness(num_designs, 0.0);
+        for (size_t i = 0; i < num_designs; ++i)
+        {
+            fitness[i] = designs.fitness(i);
+        }
+
+        rank_correlation = rank_correlation_of(predicted_fitness, fitness);
+    }
+    else
+    {
+        rank_correlation = 0.0;
+    }
+
+    // Train the surrogate on the designs evaluated so far
+    surrogate.fit();
+
+    // Breed the candidates, with a new set of tournaments for each group of candidates
+    update_selection_fitness();
+
+    for (size_t g = 0; g < candidate_factor; ++g)
+    {
+        select_parents();
+
+        for (size_t i = 0; i < num_designs; ++i)
+        {
+            const size_t c = g * num_designs + i;
+            candidates.step_size(c) = breed_child(parent_indices[2 * i], parent_indices[2 * i + 1], candidates.design(c));
+            candidates.fitness(c) = surrogate.predict(candidates.design(c));
+        }
+    }
+
+    // Keep the candidates with the best predicted fitness after the elite designs
+    const size_t num_children = num_designs - elite_count;
+
+    std::iota(candidate_order.begin(), candidate_order.end(), 0);
+    std::partial_sort(candidate_order.begin(), candidate_order.begin() + num_children, candidate_order.end(), [this](const size_t i1, const size_t i2)
+    {
+        return candidates.fitness(i1) > candidates.fitness(i2);
+    });
+
+    for (size_t k = 0; k < num_children; ++k)
+    {
+        std::memcpy(next_designs.design(elite_count + k), candidates.design(candidate_order[k]), num_des_var * sizeof(double));
+        next_designs.step_size(elite_count + k) = candidates.step_size(candidate_order[k]);
+        predicted_fitness[elite_count + k] = candidates.fitness(candidate_order[k]);
+    }
+
+    saved_episodes = candidates.size() - num_children;
+
+    // Swap to the new population and predict the elite designs
+    swap_populations();
+
+    for (size_t i = 0; i < elite_count; ++i)
+    {
+        predicted_fitness[i] = surrogate.predict(designs.design(i));
+    }
+
+    designs_predicted = true;
+}
+
+double SurrogateGeneticOptim::get_rank_correlation() const
+{
+    return rank_correlation;
+}
+
+size_t SurrogateGeneticOptim::get_saved_episodes() const
+{
+    return saved_episodes;
+}
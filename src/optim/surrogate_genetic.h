@@ -0,0 +1,127 @@
+#ifndef __IO_SURROGATE_GENETIC_OPTIM__
+#define __IO_SURROGATE_GENETIC_OPTIM__
+
+#include "optim/genetic.h"
+#include "optim/ridge_surrogate.h"
+
+/// <summary>
+/// SurrogateGeneticOptim provides a genetic optimization algorithm that pre-screens
+/// its children with a ridge regression surrogate of the fitness, trained online on
+/// every evaluated design. Each generation breeds several times more candidates than
+/// the population size, and only the candidates with the best predicted fitness are
+/// kept for simulation
+/// </summary>
+class SurrogateGeneticOptim : public GeneticOptim
+{
+public:
+    /// <summary>
+    /// Constructs the surrogate-assisted genetic optimization algorithm
+    /// </summary>
+    /// <param name="num_designs">the number of designs to have in the population</param>
+    /// <param name="num_des_var">the number of design variables to have</param>
+    /// <param name="candidate_factor">the number of candidates bred for each simulated child</param>
+    /// <param name="random_source">the random number generator to use, or nullptr
+    /// to use a Xoshiro256Random with a fixed seed</param>
+    SurrogateGeneticOptim(
+        const size_t num_designs,
+        const size_t num_des_var,
+        const size_t candidate_factor,
+        std::unique_ptr<RandomSource> random_source = nullptr);
+
+    /// <summary>
+    /// Sets the fitness score for a given design, adding it to the surrogate samples
+    /// </summary>
+    /// <param name="ind">the design index to check</param>
+    /// <param name="val">the fitness value to assign</param>
+    virtual void set_design_fitness(
+        const size_t ind,
+        const double val) override;
+
+    /// <summary>
+    /// Initializes the designs to random values within the upper and lower bound
+    /// values, discarding the predictions
+    /// </summary>
+    virtual void init_population() override;
+
+    /// <summary>
+    /// Initializes the designs to random values roughly surrounding the given
+    /// design variables, discarding the predictions
+    /// </summary>
+    /// <param name="other">the design variables to target around</param>
+    virtual void init_population(const std::vector<double>& other) override;
+
+    /// <summary>
+    /// Initializes the designs from several seed designs, discarding the predictions
+    /// </summary>
+    /// <param name="seeds">the seed design variables, ordered from the most preferred</param>
+    /// <param name="spread">the largest random offset, as a fraction of the design range</param>
+    /// <param name="interpolation_rate">the probability that a design is interpolated between two seeds</param>
+    virtual void seed_population(
+        const std::vector<std::vector<double>>& seeds,
+        const double spread,
+        const double interpolation_rate) override;
+
+    /// <summary>
+    /// Trains the surrogate and breeds the next population from the best predicted candidates
+    /// </summary>
+    virtual void update_designs() override;
+
+    /// <summary>
+    /// Provides the Spearman rank correlation between the predicted and the simulated
+    /// fitness of the last generation
+    /// </summary>
+    /// <returns>the rank correlation, or zero if the generation was not screened</returns>
+    double get_rank_correlation() const;
+
+    /// <summary>
+    /// Provides the number of candidates rejected by the surrogate in the last
+    /// generation, each of which would otherwise have been simulated
+    /// </summary>
+    /// <returns>the number of episodes saved</returns>
+    size_t get_saved_episodes() const;
+
+protected:
+    /// <summary>
+    /// The ridge penalty of the surrogate, relative to the sample weight
+    /// </summary>
+    static const double surrogate_regularization;
+
+    /// <summary>
+    /// The weight kept by the surrogate samples after each generation
+    /// </summary>
+    static const double surrogate_forgetting;
+
+    /// <summary>
+    /// The number of candidates bred for each simulated child
+    /// </summary>
+    size_t candidate_factor;
+
+    /// <summary>
+    /// The surrogate model of the fitness
+    /// </summary>
+    RidgeSurrogate surrogate;
+
+    /// <summary>
+    /// The bred candidates, with the predicted fitness stored as the fitness
+    /// </summary>
+    Population candidates;
+
+    /// <summary>
+    /// The candidate indices, ordered by predicted fitness
+    /// </summary>
+    std::vector<size_t> candidate_order;
+
+    /// <summary>
+    /// The predicted fitness of each design in the population, and whether it was predicted
+    /// </summary>
+    std::vector<double> predicted_fitness;
+    bool designs_predicted = false;
+
+    /// <summary>
+    /// The statistics of the last generation
+    /// </summary>
+    double rank_correlation = 0.0;
+    size_t saved_episodes = 0;
+};
+
+#endif
@@ -1,5 +1,8 @@
 #include "states/game_state.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 
@@ -9,6 +12,10 @@
 
 #include <cassert>
 
+#include "neural/low_rank_net.h"
+#include "neural/mixture_net.h"
+#include "neural/net.h"
+
 const size_t GameState::num_forward_outputs = 10;
 const size_t GameState::num_turn_outputs = 10;
 
@@ -19,8 +26,59 @@ const size_t GameState::tile_grid_height = 9;
 
 static const bool include_inverse = false;
 
+// Defines the longest simulated time of an episode at full fidelity and when
+// screening at low fidelity, in seconds
+static const double full_episode_time = 300.0;
+static const double screening_episode_time = 60.0;
+
+// Defines whether the convergence statistics of each generation of the genetic
+// algorithms are logged to telemetry.csv in the working directory
+static const bool write_optim_telemetry = false;
+
+// Defines whether the optimization is seeded from the networks saved by earlier runs,
+// read from the files named by each prefix followed by a number and .txt, such as the
+// temp_<count>.txt best networks, the elite_<index>.txt library or the pareto_<index>.txt front
+static const bool warm_start_optim = false;
+static const std::vector<std::string> warm_start_prefixes = { "temp_" };
+
+// Defines the most saved networks used to seed the optimization, preferring the
+// files with the highest numbers, which are the latest best networks
+static const size_t warm_start_max_networks = 50;
+
+// Defines how the outputs of optimized networks are interpreted, with the voting
+// head using num_forward_outputs + num_turn_outputs outputs and the continuous
+// head using one output for each control input
+static const NeuralModel::OutputHead optim_output_head = NeuralModel::OutputHead::VOTING;
+
+// Creates the network for the given configuration, reading mixture networks
+// by their header and all other networks as a NeuralNetwork
+static std::unique_ptr<NeuralModel> create_network_from_config(const std::string& config)
+{
+    if (MixtureNetwork::is_mixture_config(config))
+    {
+        return std::make_unique<MixtureNetwork>(MixtureNetwork::from_config(config));
+    }
+    else
+    {
+        return std::make_unique<NeuralNetwork>(NeuralNetwork::from_config(config));
+    }
+}
+
+// Reads the text of the given file, providing an empty string if the file cannot be read
+static std::string read_text_file(const std::string& fname)
+{
+    std::ifstream input(fname);
+    std::ostringstream text;
+    std::string l;
+    while (std::getline(input, l))
+    {
+        text << l << std::endl;
+    }
+    return text.str();
+}
+
 GameState::GameState() :
-    optim_state(car.sensor_count() * (include_inverse ? 2 : 1), num_forward_outputs + num_turn_outputs)
+    optim_state(car.sensor_count() * (include_inverse ? 2 : 1), get_output_count(optim_output_head), optim_output_head)
 {
     // Read the file result
     file_net_loaded = false;
@@ -35,7 +93,7 @@ GameState::GameState() :
             config << l << std::endl;
         }
 
-        net_file = NeuralNetwork::from_config(config.str());
+        net_file = create_network_from_config(config.str());
         file_net_loaded = true;
     }
     catch (const std::invalid_argument&)
@@ -196,6 +254,15 @@ GameState::GameState() :
         tile_grids.push_back(tile_grid);
     }
 
+    // Provide the tracks for the optimization to evaluate on
+    optim_state.set_track_count(tile_grids.size());
+
+    // Seed the optimization from the networks saved by earlier runs
+    if (warm_start_optim)
+    {
+        warm_start_optimization();
+    }
+
     // Initialize the tile grid values to the first grid
     tile_grid_index = 0;
     set_tile_grid_index(tile_grid_index);
@@ -232,7 +299,8 @@ void GameState::set_game_mode(GameMode mode)
     // Set the new mode
     current_mode = mode;
 
-    // Reset the car and set the optimization state flag to reset
+    // Reset the car at full fidelity and set the optimization state flag to reset
+    car.set_fidelity(Car::Fidelity::FULL);
     car.reset();
     optim_state.set_update_design_flag();
 }
@@ -252,61 +320,42 @@ void GameState::step_state()
 
 void GameState::step_state_inner()
 {
-    // Update the optimization step
-    if (optim_state.update_network_design())
+    // Update the optimization step, where skipping the cached designs at the end of
+    // a generation also moves to the next generation
+    const size_t generation = optim_state.get_current_generation();
+    const bool new_design = optim_state.update_network_design();
+
+    if (optim_state.get_current_generation() != generation)
     {
-        reset_car();
+        write_generation_files();
     }
 
-    // Extract the current network
-    NeuralNetwork* selected_net = get_selected_network();
-
-    // Set the input sensor and inverse sensor inputs
-    for (size_t i = 0; i < car.sensor_count(); ++i)
+    if (new_design)
     {
-        const double dist_val = car.get_sensor(i).dist;
-        if (!selected_net->set_input(i, dist_val))
-        {
-            assert(false);
-        }
-
-        if (include_inverse)
+        // Move to the track the new design is evaluated on, simulating at its fidelity
+        if (current_mode == GameMode::OPTIM)
         {
-            if (!selected_net->set_input(car.sensor_count() + i, 1.0 - dist_val))
+            if (optim_state.get_track_id() != tile_grid_index)
             {
-                assert(false);
+                set_tile_grid_index(optim_state.get_track_id());
             }
+
+            car.set_fidelity(optim_state.get_episode_fidelity());
         }
-    }
 
-    // Step the network
-    if (!selected_net->step_network())
-    {
-        throw std::runtime_error("unable to step network");
+        reset_car();
     }
 
-    // Set the outputs
-    input_forward = get_input_value(
-        selected_net,
-        0,
-        num_forward_outputs);
-    input_right = get_input_value(
-        selected_net,
-        num_forward_outputs,
-        num_turn_outputs);
-
-    // Step the car
-    car.step_movement(*get_tile_grid(), input_forward, input_right);
+    // Extract the current network
+    NeuralModel* selected_net = get_selected_network();
 
-    // Determine if the car is stuck
-    const bool is_stuck = std::abs(car.get_forward_input()) < 1e-3 || car.get_distance() < -10.0 ||
-        (std::abs(input_forward) < 1e-6 && std::abs(car.get_forward_input()) < 1e-6) ||
-        (std::abs(car.get_delta_distance() < 0.05) && car.get_step_count() * car.step_period() > 3.0);
+    // Step the car with the network
+    step_car(car, selected_net, *get_tile_grid(), input_forward, input_right);
 
     // Perform special consideration values for
     if (current_mode == GameMode::OPTIM)
     {
-        if (car.has_collided() || car.get_step_count() > 300 * car_step_base_frequency || is_stuck)
+        if (is_episode_complete(car, input_forward) || optim_state.should_abort_episode(car))
         {
             // Check if the provided distance is better than the previous value
             if (optim_state.check_update_best_design(car) && save_optim_network_flag)
@@ -328,16 +377,195 @@ void GameState::step_state_inner()
             }
 
             // Move to the next value
+            const size_t generation = optim_state.get_current_generation();
             optim_state.step_to_next_design();
 
+            if (optim_state.get_current_generation() != generation)
+            {
+                write_generation_files();
+            }
+
             // Reset the car
             reset_car();
         }
     }
 }
 
+void GameState::step_car(
+    Car& target_car,
+    NeuralModel* selected_net,
+    const RoadGrid& grid,
+    double& forward,
+    double& right) const
+{
+    // Set the input sensor and inverse sensor inputs
+    for (size_t i = 0; i < target_car.sensor_count(); ++i)
+    {
+        const double dist_val = target_car.get_sensor(i).dist;
+        if (!selected_net->set_input(i, dist_val))
+        {
+            assert(false);
+        }
+
+        if (include_inverse)
+        {
+            if (!selected_net->set_input(target_car.sensor_count() + i, 1.0 - dist_val))
+            {
+                assert(false);
+            }
+        }
+    }
+
+    // Step the network
+    if (!selected_net->step_network())
+    {
+        throw std::runtime_error("unable to step network");
+    }
+
+    // Set the outputs
+    if (selected_net->get_output_head() == NeuralModel::OutputHead::CONTINUOUS)
+    {
+        forward = get_continuous_value(selected_net, 0);
+        right = get_continuous_value(selected_net, 1);
+    }
+    else
+    {
+        forward = get_input_value(
+            selected_net,
+            0,
+            num_forward_outputs);
+        right = get_input_value(
+            selected_net,
+            num_forward_outputs,
+            num_turn_outputs);
+    }
+
+    // Step the car
+    target_car.step_movement(grid, forward, right);
+}
+
+bool GameState::is_episode_complete(
+    const Car& target_car,
+    const double forward) const
+{
+    // Determine if the car is stuck
+    const bool is_stuck = std::abs(target_car.get_forward_input()) < 1e-3 || target_car.get_distance() < -10.0 ||
+        (std::abs(forward) < 1e-6 && std::abs(target_car.get_forward_input()) < 1e-6) ||
+        (std::abs(target_car.get_delta_distance() < 0.05) && target_car.get_step_count() * target_car.step_period() > 3.0);
+
+    // Check for the end conditions, with a shorter time limit when screening
+    const double max_time = (target_car.get_fidelity() == Car::Fidelity::SCREENING) ? screening_episode_time : full_episode_time;
+    const uint64_t max_steps = static_cast<uint64_t>(std::llround(max_time / target_car.step_period()));
+    return target_car.has_collided() || target_car.get_step_count() > max_steps || is_stuck;
+}
+
+GameState::EpisodeResult GameState::run_episode(
+    NeuralModel* selected_net,
+    const size_t grid_index) const
+{
+    // Define a separate car so that the displayed state is not modified
+    Car episode_car;
+    const RoadGrid& grid = tile_grids.at(grid_index);
+    place_car_at_start(episode_car, grid);
+
+    EpisodeResult result;
+    double forward = 0.0;
+    double right = 0.0;
+
+    do
+    {
+        step_car(episode_car, selected_net, grid, forward, right);
+    } while (!is_episode_complete(episode_car, forward));
+
+    result.distance = episode_car.get_distance();
+    result.steps = episode_car.get_step_count();
+
+    return result;
+}
+
+void GameState::place_car_at_start(
+    Car& target_car,
+    const RoadGrid& grid) const
+{
+    const RoadGrid::GridLoc* start_pos = grid.at(grid.get_start_ind());
+    target_car.set_pos(start_pos->get_center_x(), start_pos->get_center_y());
+    target_car.set_start_rotation(3 * target_car.PI / 2);
+}
+
+void GameState::write_rank_report(const std::string& fname)
+{
+    // Expand the selected network into the full network form, which is not
+    // available for mixture networks
+    const std::string config = get_selected_network()->get_config();
+    if (MixtureNetwork::is_mixture_config(config))
+    {
+        return;
+    }
+
+    const NeuralNetwork full_net = NeuralNetwork::from_config(config);
+
+    // Determine the largest rank needed to represent every layer
+    const std::vector<size_t> sizes = full_net.get_layer_sizes();
+    size_t max_rank = 1;
+    for (size_t i = 1; i < sizes.size(); ++i)
+    {
+        max_rank = std::max(max_rank, std::min(sizes[i], sizes[i - 1] + 1));
+    }
+
+    std::ostringstream report;
+    report << "rank,parameters,distance,steps,step_time_us" << std::endl;
+
+    // Define the number of network steps used to time each network
+    const size_t timing_steps = 10000;
+
+    // Add a row for the full network and for each factorized rank
+    for (size_t rank = 0; rank <= max_rank; ++rank)
+    {
+        std::unique_ptr<NeuralModel> net;
+        if (rank == 0)
+        {
+            net = full_net.clone();
+        }
+        else
+        {
+            net = std::make_unique<LowRankNetwork>(LowRankNetwork::from_network(full_net, rank));
+        }
+
+        // Run the network on the current track
+        const EpisodeResult result = run_episode(net.get(), tile_grid_index);
+
+        // Time the network step alone, separate from the car simulation
+        const auto start_time = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < timing_steps; ++i)
+        {
+            net->step_network();
+        }
+        const double step_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        report << ((rank == 0) ? std::string("full") : std::to_string(rank)) << ",";
+        report << net->parameter_count() << ",";
+        report << result.distance << ",";
+        report << result.steps << ",";
+        report << 1e6 * step_seconds / static_cast<double>(timing_steps) << std::endl;
+    }
+
+    // Write the resulting report
+    std::ofstream output(fname);
+    if (output.is_open())
+    {
+        output << report.str();
+        output.close();
+    }
+    else
+    {
+        std::ostringstream error_str;
+        error_str << "Error opening file " << fname << " for writing" << std::endl;
+        throw std::runtime_error(error_str.str().c_str());
+    }
+}
+
 double GameState::get_input_value(
-    const NeuralNetwork* selected_net,
+    const NeuralModel* selected_net,
     const size_t init_index,
     const size_t input_size) const
 {
@@ -367,6 +595,31 @@ double GameState::get_input_value(
     return input_value;
 }
 
+double GameState::get_continuous_value(
+    const NeuralModel* selected_net,
+    const size_t index) const
+{
+    double val = 0.0;
+    if (!selected_net->get_output(index, val))
+    {
+        assert(false);
+    }
+
+    return std::tanh(val);
+}
+
+size_t GameState::get_output_count(const NeuralModel::OutputHead head)
+{
+    if (head == NeuralModel::OutputHead::CONTINUOUS)
+    {
+        return 2;
+    }
+    else
+    {
+        return num_forward_outputs + num_turn_outputs;
+    }
+}
+
 GameState::GameMode GameState::get_current_mode() const
 {
     return current_mode;
@@ -389,14 +642,226 @@ std::string GameState::get_temp_fname() const
     return fname.str();
 }
 
-NeuralNetwork* GameState::get_selected_network()
+// Writes the text to the given file, throwing if the file cannot be opened
+static void write_text_file(
+    const std::string& fname,
+    const std::string& text)
+{
+    std::ofstream output(fname);
+    if (output.is_open())
+    {
+        output << text;
+        output.close();
+    }
+    else
+    {
+        std::ostringstream error_str;
+        error_str << "Error opening file " << fname << " for writing" << std::endl;
+        throw std::runtime_error(error_str.str().c_str());
+    }
+}
+
+// Appends the line to the given log file, starting the file with the header for a
+// new log, and throwing if the file cannot be opened
+static void append_log_line(
+    const std::string& fname,
+    const std::string& header,
+    const std::string& line,
+    const bool new_log)
+{
+    std::ofstream output(fname, new_log ? std::ios::trunc : std::ios::app);
+    if (output.is_open())
+    {
+        if (new_log)
+        {
+            output << header << std::endl;
+        }
+
+        output << line << std::endl;
+        output.close();
+    }
+    else
+    {
+        std::ostringstream error_str;
+        error_str << "Error opening file " << fname << " for writing" << std::endl;
+        throw std::runtime_error(error_str.str().c_str());
+    }
+}
+
+void GameState::write_generation_files() const
+{
+    // Save the Pareto front of multi-objective optimizers and the elite library of
+    // quality-diversity optimizers with each new generation
+    if (save_optim_network_flag)
+    {
+        if (optim_state.get_pareto_front_size() > 0)
+        {
+            write_pareto_front();
+        }
+
+        if (optim_state.get_elite_library_size() > 0)
+        {
+            write_elite_library();
+        }
+    }
+
+    // Log the agreement between the fidelities and the convergence of the
+    // population with each new generation
+    if (optim_state.has_multi_fidelity())
+    {
+        write_fidelity_log();
+    }
+
+    if (write_optim_telemetry && optim_state.has_generation_stats())
+    {
+        write_telemetry_log();
+    }
+}
+
+void GameState::write_pareto_front() const
+{
+    std::ostringstream report;
+    report << "index,distance,average_speed,smoothness" << std::endl;
+
+    for (size_t i = 0; i < optim_state.get_pareto_front_size(); ++i)
+    {
+        const double* objectives = optim_state.get_pareto_objectives(i);
+        report << i << "," << objectives[0] << "," << objectives[1] << "," << objectives[2] << std::endl;
+
+        // Save the network for the design
+        std::ostringstream fname;
+        fname << "pareto_" << i << ".txt";
+        write_text_file(fname.str(), optim_state.get_pareto_network(i)->get_config());
+    }
+
+    // Write the objectives of the front
+    write_text_file("pareto_front.csv", report.str());
+}
+
+void GameState::write_fidelity_log() const
+{
+    std::ostringstream line;
+    line << optim_state.get_current_generation() << ",";
+    line << optim_state.get_generation_episode_count() << ",";
+    line << optim_state.get_fidelity_promoted_count() << ",";
+    line << optim_state.get_fidelity_correlation();
+
+    append_log_line(
+        "fidelity_log.csv",
+        "generation,episodes,promoted,correlation",
+        line.str(),
+        optim_state.get_current_generation() == 1);
+}
+
+void GameState::write_telemetry_log() const
+{
+    const GeneticOptim::GenerationStats& stats = optim_state.get_generation_stats();
+
+    std::ostringstream line;
+    line << stats.generation << ",";
+    line << stats.fitness_min << "," << stats.fitness_lower_quartile << "," << stats.fitness_median << ",";
+    line << stats.fitness_upper_quartile << "," << stats.fitness_max << ",";
+    line << stats.spread << ",";
+    line << stats.step_size_mean << "," << stats.step_size_min << "," << stats.step_size_max << ",";
+    line << optim_state.get_restart_count() << "," << optim_state.get_population_size();
+
+    append_log_line(
+        "telemetry.csv",
+        "generation,fitness_min,fitness_q25,fitness_median,fitness_q75,fitness_max,spread,step_size_mean,step_size_min,step_size_max,restarts,population",
+        line.str(),
+        optim_state.get_current_generation() == 1);
+}
+
+void GameState::write_elite_library() const
+{
+    std::ostringstream report;
+    report << "index,distance,average_speed,average_turn" << std::endl;
+
+    for (size_t i = 0; i < optim_state.get_elite_library_size(); ++i)
+    {
+        const double* behavior = optim_state.get_elite_behavior(i);
+        report << i << "," << optim_state.get_elite_distance(i) << "," << behavior[0] << "," << behavior[1] << std::endl;
+
+        // Save the network for the design
+        std::ostringstream fname;
+        fname << "elite_" << i << ".txt";
+        write_text_file(fname.str(), optim_state.get_elite_network(i)->get_config());
+    }
+
+    // Write the fitness and behavior of each elite
+    write_text_file("elites.csv", report.str());
+}
+
+void GameState::warm_start_optimization()
+{
+    // Find the numbered network files for each prefix
+    std::vector<std::pair<size_t, std::string>> files;
+
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator("."))
+    {
+        const std::string fname = entry.path().filename().string();
+        const std::string suffix = ".txt";
+
+        for (const std::string& prefix : warm_start_prefixes)
+        {
+            if (fname.size() <= prefix.size() + suffix.size() ||
+                fname.compare(0, prefix.size(), prefix) != 0 ||
+                fname.compare(fname.size() - suffix.size(), suffix.size(), suffix) != 0)
+            {
+                continue;
+            }
+
+            const std::string number = fname.substr(prefix.size(), fname.size() - prefix.size() - suffix.size());
+            if (std::all_of(number.begin(), number.end(), [](const char c) { return c >= '0' && c <= '9'; }))
+            {
+                try
+                {
+                    files.emplace_back(std::stoul(number), fname);
+                }
+                catch (const std::out_of_range&)
+                {
+                    // Skip numbers too large to order
+                }
+            }
+        }
+    }
+
+    std::sort(files.begin(), files.end(), [](const std::pair<size_t, std::string>& f1, const std::pair<size_t, std::string>& f2)
+    {
+        return f1.first > f2.first || (f1.first == f2.first && f1.second < f2.second);
+    });
+
+    if (files.size() > warm_start_max_networks)
+    {
+        files.resize(warm_start_max_networks);
+    }
+
+    // Read the parameters of each network, skipping files that are not valid networks
+    std::vector<std::vector<double>> parameters;
+
+    for (const std::pair<size_t, std::string>& file : files)
+    {
+        try
+        {
+            parameters.push_back(create_network_from_config(read_text_file(file.second))->get_parameters());
+        }
+        catch (const std::logic_error&)
+        {
+            // Skip the file
+        }
+    }
+
+    optim_state.warm_start(parameters);
+}
+
+NeuralModel* GameState::get_selected_network()
 {
     switch (current_mode)
     {
     case GameMode::OPTIM:
         return optim_state.get_optim_network();
     case GameMode::FILE:
-        return &net_file;
+        return net_file.get();
     case GameMode::BEST:
         return optim_state.get_best_network();
     default:
@@ -486,12 +951,10 @@ void GameState::set_tile_grid_index(const size_t ind)
     {
         // Set the index
         tile_grid_index = ind;
+        optim_state.set_track_id(ind);
 
         // Initialize the starting position
-        const RoadGrid* selected_grid = get_tile_grid();
-        const RoadGrid::GridLoc* start_pos = selected_grid->at(selected_grid->get_start_ind());
-        car.set_pos(start_pos->get_center_x(), start_pos->get_center_y());
-        car.set_start_rotation(3 * car.PI / 2);
+        place_car_at_start(car, *get_tile_grid());
     }
 }
 
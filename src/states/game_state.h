@@ -2,10 +2,11 @@
 #define __IO_GAME_STATE__
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "car/car.h"
-#include "neural/net.h"
+#include "neural/model.h"
 #include "states/optim_state.h"
 #include "tiles/tile_grid.h"
 
@@ -25,6 +26,22 @@ public:
         BEST = 2
     };
 
+    /// <summary>
+    /// Provides the result of an episode run outside of the displayed game state
+    /// </summary>
+    struct EpisodeResult
+    {
+        /// <summary>
+        /// The distance traveled by the car
+        /// </summary>
+        double distance = 0.0;
+
+        /// <summary>
+        /// The number of steps taken by the car
+        /// </summary>
+        uint64_t steps = 0;
+    };
+
 public:
     /// <summary>
     /// Initializes the game state
@@ -53,12 +70,67 @@ public:
     /// </summary>
     void step_state();
 
+    /// <summary>
+    /// Runs a complete episode for the given network on a separate car,
+    /// without modifying the displayed car or optimization state
+    /// </summary>
+    /// <param name="selected_net">the network to drive the car with</param>
+    /// <param name="grid_index">the tile grid index to run the episode on</param>
+    /// <returns>the episode result</returns>
+    EpisodeResult run_episode(
+        NeuralModel* selected_net,
+        const size_t grid_index) const;
+
+    /// <summary>
+    /// Writes a report of the lap distance and network step time on the current
+    /// tile grid against the rank of a low-rank factorization of the selected network.
+    /// No report is written for mixture networks, which have no single full network form
+    /// </summary>
+    /// <param name="fname">the filename to write the report to</param>
+    void write_rank_report(const std::string& fname);
+
 private:
     /// <summary>
     /// Performs the inner-step to perform one iteration of the step
     /// </summary>
     void step_state_inner();
 
+    /// <summary>
+    /// Sets the network inputs from the car sensors, steps the network, and steps
+    /// the car with the resulting network outputs
+    /// </summary>
+    /// <param name="target_car">the car to step</param>
+    /// <param name="selected_net">the network to drive the car with</param>
+    /// <param name="grid">the road grid the car is on</param>
+    /// <param name="forward">the output parameter for the requested forward input</param>
+    /// <param name="right">the output parameter for the requested right input</param>
+    void step_car(
+        Car& target_car,
+        NeuralModel* selected_net,
+        const RoadGrid& grid,
+        double& forward,
+        double& right) const;
+
+    /// <summary>
+    /// Determines whether the episode for the car has ended, due to collision,
+    /// time limit, or the car being stuck
+    /// </summary>
+    /// <param name="target_car">the car to check</param>
+    /// <param name="forward">the last requested forward input</param>
+    /// <returns>true if the episode is complete</returns>
+    bool is_episode_complete(
+        const Car& target_car,
+        const double forward) const;
+
+    /// <summary>
+    /// Places the car at the start location of the given road grid
+    /// </summary>
+    /// <param name="target_car">the car to place</param>
+    /// <param name="grid">the road grid to use</param>
+    void place_car_at_start(
+        Car& target_car,
+        const RoadGrid& grid) const;
+
     /// <summary>
     /// Obtains an input value from the given network
     /// </summary>
@@ -67,10 +139,28 @@ private:
     /// <param name="input_size">the number of contributing network indices</param>
     /// <returns>the resulting input value, between [-1.0, 1.0], inclusive</returns>
     double get_input_value(
-        const NeuralNetwork* selected_net,
+        const NeuralModel* selected_net,
         const size_t init_index,
         const size_t input_size) const;
 
+    /// <summary>
+    /// Obtains an input value from a single network output for the continuous head,
+    /// saturating the output with a hyperbolic tangent
+    /// </summary>
+    /// <param name="selected_net">the neural network to obtain outputs from</param>
+    /// <param name="index">the output index</param>
+    /// <returns>the resulting input value, between [-1.0, 1.0], inclusive</returns>
+    double get_continuous_value(
+        const NeuralModel* selected_net,
+        const size_t index) const;
+
+    /// <summary>
+    /// Provides the number of network outputs used by the given output head
+    /// </summary>
+    /// <param name="head">the output head</param>
+    /// <returns>the number of non-bias outputs</returns>
+    static size_t get_output_count(const NeuralModel::OutputHead head);
+
 public:
     /// <summary>
     /// Provides the current game mode
@@ -96,11 +186,46 @@ public:
     /// <returns></returns>
     std::string get_temp_fname() const;
 
+    /// <summary>
+    /// Writes the Pareto front, elite library and logs that are updated with each new generation
+    /// </summary>
+    void write_generation_files() const;
+
+    /// <summary>
+    /// Writes the objectives of the designs on the Pareto front to pareto_front.csv,
+    /// and the network of each design to pareto_<index>.txt
+    /// </summary>
+    void write_pareto_front() const;
+
+    /// <summary>
+    /// Writes the distance and behavior of the elites of a quality-diversity optimizer
+    /// to elites.csv, and the network of each elite to elite_<index>.txt
+    /// </summary>
+    void write_elite_library() const;
+
+    /// <summary>
+    /// Appends the episode count and the correlation between the screening and full
+    /// fidelity scores of the last generation to fidelity_log.csv
+    /// </summary>
+    void write_fidelity_log() const;
+
+    /// <summary>
+    /// Appends the fitness quantiles, population spread and mutation step sizes of
+    /// the last generation to telemetry.csv
+    /// </summary>
+    void write_telemetry_log() const;
+
+    /// <summary>
+    /// Seeds the optimization from the networks saved by earlier runs, read from the
+    /// numbered network files for each warm start prefix
+    /// </summary>
+    void warm_start_optimization();
+
     /// <summary>
     /// Provides the current network for the given mode
     /// </summary>
     /// <returns>the current network associated with the given mdoe</returns>
-    NeuralNetwork* get_selected_network();
+    NeuralModel* get_selected_network();
 
     /// <summary>
     /// Increases the step frequency counter to a limit
@@ -244,7 +369,7 @@ private:
     /// <summary>
     /// Provides the neural network to use when loading from a file
     /// </summary>
-    NeuralNetwork net_file;
+    std::unique_ptr<NeuralModel> net_file;
 
     /// <summary>
     /// Defines whether the network file was loaded successfully
@@ -1,16 +1,357 @@
 #include "states/optim_state.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "neural/autotune.h"
+#include "neural/graph_net.h"
+#include "neural/low_rank_net.h"
+#include "neural/mixture_net.h"
+#include "neural/net.h"
+#include "neural/ternary_net.h"
+#include "optim/cmaes.h"
+#include "optim/differential.h"
+#include "optim/discrete_genetic.h"
+#include "optim/es.h"
+#include "optim/genetic.h"
+#include "optim/map_elites.h"
+#include "optim/neat.h"
+#include "optim/nsga.h"
+#include "optim/restart.h"
+#include "optim/steady_state_genetic.h"
+#include "optim/surrogate_genetic.h"
+
 const size_t OptimState::num_designs = 200;
 
+// Defines the type of network to optimize
+static const OptimState::NetworkType optim_network_type = OptimState::NetworkType::FULL;
+
+// Defines the rank of each layer's weight matrix for low-rank networks
+static const size_t low_rank_network_rank = 4;
+
+// Defines the number of experts for mixture networks, each of which has a
+// hidden layer the size of the input layer
+static const size_t mixture_expert_count = 4;
+
+// Defines whether full networks are evaluated with the fastest kernel for the
+// running machine, selected on the first run and loaded from the cache afterwards,
+// which writes the cache file to the working directory
+static const bool autotune_network_kernel = false;
+
+// Defines the file used to cache the selected kernels
+static const std::string autotune_cache_fname = "autotune_cache.txt";
+
+// Creates the network to optimize for the given input and output sizes
+static std::unique_ptr<NeuralModel> create_optim_network(
+    const size_t num_inputs,
+    const size_t num_outputs,
+    const NeuralModel::OutputHead output_head)
+{
+    const std::vector<size_t> layers = { num_inputs, num_inputs * 2, num_outputs };
+    std::unique_ptr<NeuralModel> net;
+
+    switch (optim_network_type)
+    {
+    case OptimState::NetworkType::LOW_RANK:
+        net = std::make_unique<LowRankNetwork>(LowRankNetwork::from_layers(layers, low_rank_network_rank));
+        break;
+    case OptimState::NetworkType::TERNARY:
+        net = std::make_unique<TernaryNetwork>(TernaryNetwork::from_layers(layers));
+        break;
+    case OptimState::NetworkType::MIXTURE:
+        net = std::make_unique<MixtureNetwork>(MixtureNetwork::from_layers({ num_inputs, num_inputs, num_outputs }, mixture_expert_count));
+        break;
+    default:
+        if (autotune_network_kernel)
+        {
+            // Networks are stepped one at a time, and only exact kernels are allowed
+            // so that the trained gains behave the same when saved
+            const NeuralNetwork full_net = NeuralNetwork::from_layers(layers);
+            KernelTuner tuner(autotune_cache_fname);
+            const KernelTuner::Kernel kernel = tuner.select_kernel(full_net, 1, false);
+            net = KernelTuner::create_model(kernel, full_net);
+        }
+        else
+        {
+            net = std::make_unique<NeuralNetwork>(NeuralNetwork::from_layers(layers));
+        }
+        break;
+    }
+
+    net->set_output_head(output_head);
+    return net;
+}
+
+// Defines the optimization algorithm for continuous networks. Ternary networks
+// always use the discrete genetic algorithm
+static const OptimState::Algorithm optim_algorithm = OptimState::Algorithm::GENETIC;
+
+// Defines the number of objectives for the multi-objective optimizer, which are
+// the distance, the average speed and the smoothness of the steering
+static const size_t optim_objective_count = 3;
+
+// Defines the number of MAP-Elites cells along the average speed and average turn
+// behaviors, and the range of each behavior covered by the cells
+static const size_t map_elites_speed_cells = 10;
+static const size_t map_elites_turn_cells = 10;
+static const double map_elites_max_speed = 1.5;
+static const double map_elites_max_turn = 1.0;
+
+// Defines the probability that each design variable is mutated for continuous
+// networks, with rates below one mutating only the selected design variables
+static const double optim_mutation_rate = 1.0;
+
+// Defines the distribution of mutation values for continuous networks
+static const GeneticOptim::MutationDistribution optim_mutation_distribution = GeneticOptim::MutationDistribution::UNIFORM;
+
+// Defines the mutation scale for continuous networks, as a fraction of the design range
+static const double optim_mutation_scale = 0.05;
+
+// Defines the largest random offset of the designs seeded from saved networks, as a
+// fraction of the design range, and the probability that a seeded design is
+// interpolated between two saved networks rather than offset from one
+static const double warm_start_spread = 0.02;
+static const double warm_start_interpolation_rate = 0.5;
+
+// Defines whether each design carries its own mutation step size for continuous
+// networks, starting from the mutation scale and adapted as the designs are bred
+static const bool optim_self_adaptive_mutation = false;
+
+// Defines the genome distance within which designs share fitness when the genetic
+// algorithms select parents, keeping the population spread over several niches, or
+// zero to select on the fitness alone
+static const double optim_sharing_radius = 0.0;
+
+// Defines the number of candidates bred by the surrogate-assisted genetic algorithm
+// for each simulated child, with the rest rejected by the surrogate
+static const size_t optim_surrogate_candidate_factor = 4;
+
+// Defines the number of the fittest designs carried into each new population
+// unchanged by the genetic algorithms
+static const size_t optim_elite_count = 2;
+
+// Defines whether the fitness of each simulated design is cached, so that
+// identical designs, such as the elite designs, are not simulated again
+static const bool optim_fitness_cache = true;
+
+// Defines whether designs are evaluated across tracks by successive halving, with
+// every design evaluated on the first track and the better half on each next track
+static const bool optim_successive_halving = false;
+
+// Defines whether every design is screened with the low fidelity simulation, with only
+// the best screened designs simulated again at full fidelity
+static const bool optim_multi_fidelity = false;
+
+// Defines the fraction of the designs promoted from screening to full fidelity
+static const double fidelity_promote_fraction = 0.25;
+
+// Defines the number of designs held in the fitness cache before it is cleared
+static const size_t fitness_cache_size = 100000;
+
+// Defines whether episodes are aborted once they fall behind the previous generation,
+// or only measured for the steps and fitness that aborting them would change
+static const RacingMonitor::Mode racing_mode = RacingMonitor::Mode::OFF;
+
+// Defines the number of simulation steps between racing checkpoints
+static const uint64_t racing_checkpoint_steps = 100;
+
+// Defines the fraction of the previous generation an episode must stay ahead of at each
+// checkpoint, with a design in this fraction winning at most this share of its tournaments
+static const double racing_percentile = 0.25;
+
+// Defines the weight of novelty in the fitness of single-objective optimizers, blended
+// with the distance, where zero disables novelty search and one searches for novelty alone
+static const double novelty_weight = 0.0;
+
+// Defines the number of trajectory samples in the behavior descriptor, which ends
+// with the final position of the car
+static const size_t novelty_trajectory_samples = 4;
+
+// Defines the number of nearest archived behaviors averaged for the novelty
+static const size_t novelty_neighbors = 15;
+
+// Defines the number of behaviors held in the novelty archive, with the oldest removed first
+static const size_t novelty_archive_size = 10000;
+
+// Defines the number of the most novel behaviors added to the archive each generation
+static const size_t novelty_archive_additions = 5;
+
+// Sets the behavior descriptor of the car, as the sampled trajectory followed by the final
+// position, where samples the episode did not reach are set to the final position
+static void behavior_descriptor(
+    const Car& car,
+    double* descriptor)
+{
+    const std::vector<double>& trajectory = car.get_trajectory();
+
+    for (size_t i = 0; i <= novelty_trajectory_samples; ++i)
+    {
+        if (i < novelty_trajectory_samples && 2 * i + 1 < trajectory.size())
+        {
+            descriptor[2 * i] = trajectory[2 * i];
+            descriptor[2 * i + 1] = trajectory[2 * i + 1];
+        }
+        else
+        {
+            descriptor[2 * i] = car.get_car_x();
+            descriptor[2 * i + 1] = car.get_car_y();
+        }
+    }
+}
+
+// Defines whether single-objective optimizers are restarted with a new population once
+// they stagnate, and the schedule of the population sizes. NEAT removes its own stagnant
+// species, and the archives of NSGA-II and MAP-Elites are kept for the whole run
+static const bool optim_restarts = false;
+static const RestartOptim::Strategy optim_restart_strategy = RestartOptim::Strategy::BIPOP;
+
+// Creates the optimizer for the given population and network, where only NEAT
+// uses the network inputs and outputs to evolve its own topologies
+static std::unique_ptr<Optimizer> create_base_optimizer(
+    const size_t num_designs,
+    const size_t num_inputs,
+    const size_t num_outputs,
+    const size_t num_des_var,
+    std::unique_ptr<RandomSource> random_source)
+{
+    if (optim_network_type == OptimState::NetworkType::TERNARY)
+    {
+        std::unique_ptr<DiscreteGeneticOptim> optim = std::make_unique<DiscreteGeneticOptim>(num_designs, num_des_var, std::move(random_source));
+        optim->set_elite_count(optim_elite_count);
+        optim->set_sharing_radius(optim_sharing_radius);
+        return optim;
+    }
+    else if (optim_algorithm == OptimState::Algorithm::CMAES)
+    {
+        return std::make_unique<CmaesOptim>(num_designs, num_des_var, false, std::move(random_source));
+    }
+    else if (optim_algorithm == OptimState::Algorithm::SEP_CMAES)
+    {
+        return std::make_unique<CmaesOptim>(num_designs, num_des_var, true, std::move(random_source));
+    }
+    else if (optim_algorithm == OptimState::Algorithm::ES)
+    {
+        return std::make_unique<EsOptim>(num_designs, num_des_var, std::move(random_source));
+    }
+    else if (optim_algorithm == OptimState::Algorithm::NEAT)
+    {
+        return std::make_unique<NeatOptim>(num_designs, num_inputs, num_outputs, std::move(random_source));
+    }
+    else if (optim_algorithm == OptimState::Algorithm::NSGA)
+    {
+        return std::make_unique<NsgaOptim>(num_designs, num_des_var, optim_objective_count, std::move(random_source));
+    }
+    else if (optim_algorithm == OptimState::Algorithm::MAP_ELITES)
+    {
+        return std::make_unique<MapElitesOptim>(
+            num_designs,
+            num_des_var,
+            std::vector<size_t>{ map_elites_speed_cells, map_elites_turn_cells },
+            std::vector<double>{ 0.0, 0.0 },
+            std::vector<double>{ map_elites_max_speed, map_elites_max_turn },
+            std::move(random_source));
+    }
+    else if (optim_algorithm == OptimState::Algorithm::DE_RAND)
+    {
+        return std::make_unique<DifferentialOptim>(num_designs, num_des_var, DifferentialOptim::Strategy::RAND_1_BIN, std::move(random_source));
+    }
+    else if (optim_algorithm == OptimState::Algorithm::DE_CURRENT_TO_BEST)
+    {
+        return std::make_unique<DifferentialOptim>(num_designs, num_des_var, DifferentialOptim::Strategy::CURRENT_TO_BEST_1_BIN, std::move(random_source));
+    }
+    else
+    {
+        std::unique_ptr<GeneticOptim> optim;
+        if (optim_algorithm == OptimState::Algorithm::STEADY_STATE_GENETIC)
+        {
+            optim = std::make_unique<SteadyStateGeneticOptim>(num_designs, num_des_var, std::move(random_source));
+        }
+        else if (optim_algorithm == OptimState::Algorithm::SURROGATE_GENETIC)
+        {
+            optim = std::make_unique<SurrogateGeneticOptim>(num_designs, num_des_var, optim_surrogate_candidate_factor, std::move(random_source));
+        }
+        else
+        {
+            optim = std::make_unique<GeneticOptim>(num_designs, num_des_var, std::move(random_source));
+        }
+
+        optim->set_mutation(optim_mutation_rate, optim_mutation_distribution, optim_mutation_scale);
+        optim->set_self_adaptation(optim_self_adaptive_mutation);
+        optim->set_elite_count(optim_elite_count);
+        optim->set_sharing_radius(optim_sharing_radius);
+        return optim;
+    }
+}
+
+// Creates the optimizer for the given population and network, restarting the
+// single-objective optimizers once they stagnate if requested
+static std::unique_ptr<Optimizer> create_optimizer(
+    const size_t num_designs,
+    const size_t num_inputs,
+    const size_t num_outputs,
+    const size_t num_des_var)
+{
+    const bool restart_optim =
+        optim_restarts &&
+        optim_algorithm != OptimState::Algorithm::NEAT &&
+        optim_algorithm != OptimState::Algorithm::NSGA &&
+        optim_algorithm != OptimState::Algorithm::MAP_ELITES;
+
+    if (restart_optim)
+    {
+        return std::make_unique<RestartOptim>(
+            [num_inputs, num_outputs, num_des_var](const size_t run_designs, std::unique_ptr<RandomSource> random_source)
+            {
+                return create_base_optimizer(run_designs, num_inputs, num_outputs, num_des_var, std::move(random_source));
+            },
+            num_designs,
+            optim_restart_strategy);
+    }
+    else
+    {
+        return create_base_optimizer(num_designs, num_inputs, num_outputs, num_des_var, nullptr);
+    }
+}
+
+// Compiles the enabled links of the given NEAT genome into a network
+static std::unique_ptr<NeuralModel> create_genome_network(
+    const NeatOptim& neat,
+    const size_t i,
+    const NeuralModel::OutputHead output_head)
+{
+    std::vector<GraphNetwork::Link> links;
+    for (const NeatOptim::LinkGene& gene : neat.get_genome(i))
+    {
+        if (gene.enabled)
+        {
+            links.push_back(GraphNetwork::Link{ gene.from_node_id, gene.to_node_id, gene.gain });
+        }
+    }
+
+    std::unique_ptr<NeuralModel> net = std::make_unique<GraphNetwork>(neat.input_count(), neat.output_count(), links);
+    net->set_output_head(output_head);
+    return net;
+}
+
 OptimState::OptimState(
     const size_t num_inputs,
-    const size_t num_outputs)
+    const size_t num_outputs,
+    const NeuralModel::OutputHead output_head)
     :
-    net_optim(NeuralNetwork::from_layers({ num_inputs, num_inputs * 2, num_outputs })),
-    net_best(net_optim),
-    optim(num_designs, net_optim.get_links().size())
+    net_optim(create_optim_network(num_inputs, num_outputs, output_head)),
+    net_best(net_optim->clone()),
+    optim(create_optimizer(num_designs, num_inputs, num_outputs, net_optim->parameter_count())),
+    fitness_cache(fitness_cache_size),
+    racing(racing_mode, racing_checkpoint_steps, racing_percentile),
+    novelty_archive(2 * (novelty_trajectory_samples + 1), novelty_neighbors, novelty_archive_size)
 {
-    // Empty Constructor
+    // Schedule the episodes across fidelities, where only a single fitness is scheduled
+    if (optim_multi_fidelity && optim->objective_count() == 1)
+    {
+        fidelity = std::make_unique<FidelitySchedule>(optim->design_count(), fidelity_promote_fraction);
+        current_design_index = fidelity->current_design();
+    }
 }
 
 bool OptimState::update_network_design()
@@ -19,14 +360,37 @@ bool OptimState::update_network_design()
     bool reset_car = false;
 
     // Check if we need to update the design
-    if (update_design)
+    while (update_design)
     {
-        // Set the gain values to the current network's design variables
-        const std::vector<double>& current_desvars = optim.get_design(current_design_index);
-        for (size_t i = 0; i < optim.design_variable_count(); ++i)
+        const double* design = optim->get_design(current_design_index);
+
+        // Skip designs that have already been simulated on the current track, where
+        // only a single fitness value is cached
+        if (use_fitness_cache())
+        {
+            current_design_key = FitnessCache::design_key(design, optim->design_variable_count(), track_id);
+
+            double cached_fitness = 0.0;
+            if (fitness_cache.lookup(current_design_key, cached_fitness))
+            {
+                set_episode_fitness(cached_fitness);
+                step_to_next_design();
+                continue;
+            }
+        }
+
+        // Compile the topology of each NEAT genome, and otherwise set the network
+        // parameters to the current design variables
+        const NeatOptim* neat = dynamic_cast<const NeatOptim*>(optim.get());
+        if (neat != nullptr)
+        {
+            net_optim = create_genome_network(*neat, current_design_index, net_optim->get_output_head());
+        }
+        else
         {
-            net_optim.get_links()[i].set_gain(current_desvars[i]);
+            net_optim->set_parameters(design);
         }
+        racing.start_episode();
 
         // Reset State
         update_design = false;
@@ -42,15 +406,49 @@ bool OptimState::check_update_best_design(const Car& car)
     // Set the score
     const double score = car.get_distance();
 
-    // Set the fitness score
-    optim.set_design_fitness(current_design_index, score);
+    // Set the fitness score, or each objective for multi-objective optimizers
+    if (optim->objective_count() > 1)
+    {
+        const double objectives[optim_objective_count] = {
+            score,
+            car.get_average_speed(),
+            -std::max(car.get_max_turn_left(), car.get_max_turn_right())
+        };
+
+        optim->set_design_objectives(current_design_index, objectives);
+    }
+    else
+    {
+        set_episode_fitness(get_episode_fitness(car));
+    }
+
+    // Set the behavior for quality-diversity optimizers
+    if (optim->behavior_count() > 0)
+    {
+        const double behavior[] = { car.get_average_speed(), car.get_average_turn() };
+        optim->set_design_behavior(current_design_index, behavior);
+    }
+
+    // Cache the fitness of complete episodes only, as an aborted episode would give
+    // later identical designs its truncated distance
+    if (use_fitness_cache() && !racing.was_aborted())
+    {
+        fitness_cache.insert(current_design_key, score);
+    }
 
-    // Check if we should update the values
-    if (score > score_best)
+    // Racing thresholds are only kept for episodes at a single fidelity on a single
+    // track, as distances on different tracks are not comparable
+    if (!fidelity && !schedule)
+    {
+        racing.end_episode(car.get_step_count(), score);
+    }
+
+    // Check if we should update the values, where only full fidelity scores are compared
+    if (score > score_best && get_episode_fidelity() == Car::Fidelity::FULL)
     {
         // Update value and save if requested
         score_best = score;
-        net_best = net_optim;
+        net_best = net_optim->clone();
         num_best_update_count += 1;
         generation_best = current_generation;
 
@@ -63,20 +461,170 @@ bool OptimState::check_update_best_design(const Car& car)
     }
 }
 
+bool OptimState::should_abort_episode(const Car& car)
+{
+    return !fidelity && !schedule && racing.check_episode(car.get_step_count(), car.get_distance());
+}
+
+void OptimState::set_episode_fitness(const double score)
+{
+    if (schedule)
+    {
+        schedule->report(score);
+    }
+    else if (fidelity)
+    {
+        fidelity->report(score);
+    }
+    else
+    {
+        optim->set_design_fitness(current_design_index, score);
+    }
+}
+
+bool OptimState::use_fitness_cache() const
+{
+    return optim_fitness_cache && !fidelity && novelty_weight == 0.0 && optim->objective_count() == 1 && optim->behavior_count() == 0;
+}
+
+double OptimState::get_episode_fitness(const Car& car)
+{
+    if (novelty_weight == 0.0)
+    {
+        return car.get_distance();
+    }
+
+    // Score the behavior against the archive, keeping it as a candidate for the archive
+    const size_t descriptor_size = novelty_archive.descriptor_size();
+    generation_behaviors.resize(generation_behaviors.size() + descriptor_size);
+
+    double* descriptor = &generation_behaviors[generation_behaviors.size() - descriptor_size];
+    behavior_descriptor(car, descriptor);
+
+    const double novelty = novelty_archive.novelty(descriptor);
+    generation_novelty.push_back(novelty);
+
+    return (1.0 - novelty_weight) * car.get_distance() + novelty_weight * novelty;
+}
+
+void OptimState::update_novelty_archive()
+{
+    // Order the behaviors of the generation by novelty, with the first generation
+    // scored against an empty archive and so ordered as simulated
+    std::vector<size_t> order(generation_novelty.size(), 0);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+
+    const size_t num_additions = std::min(novelty_archive_additions, order.size());
+    std::partial_sort(order.begin(), order.begin() + num_additions, order.end(), [this](const size_t i1, const size_t i2)
+    {
+        return generation_novelty[i1] > generation_novelty[i2];
+    });
+
+    // Add the most novel behaviors together, so that the tree is rebuilt once
+    const size_t descriptor_size = novelty_archive.descriptor_size();
+    std::vector<double> additions(num_additions * descriptor_size, 0.0);
+
+    for (size_t k = 0; k < num_additions; ++k)
+    {
+        std::copy(&generation_behaviors[order[k] * descriptor_size], &generation_behaviors[(order[k] + 1) * descriptor_size], &additions[k * descriptor_size]);
+    }
+
+    if (num_additions > 0)
+    {
+        novelty_archive.insert(additions.data(), num_additions);
+    }
+
+    generation_behaviors.clear();
+    generation_novelty.clear();
+}
+
+const Optimizer* OptimState::get_run_optimizer() const
+{
+    const RestartOptim* restart = dynamic_cast<const RestartOptim*>(optim.get());
+    return (restart != nullptr) ? &restart->get_optimizer() : optim.get();
+}
+
 void OptimState::step_to_next_design()
 {
-    // Increment the population index
-    current_design_index += 1;
+    // Increment the population index, or move to the next scheduled episode
+    bool generation_complete = false;
+
+    if (schedule)
+    {
+        generation_complete = !schedule->advance();
+    }
+    else if (fidelity)
+    {
+        generation_complete = !fidelity->advance();
+    }
+    else
+    {
+        current_design_index += 1;
+        generation_complete = current_design_index >= optim->design_count();
+    }
 
     // Check if we need to roll-over to the next generation
-    if (current_design_index >= num_designs)
+    if (generation_complete)
     {
+        const size_t population = optim->design_count();
+
+        // Set the budget-normalized fitness of each scheduled design
+        if (schedule)
+        {
+            for (size_t i = 0; i < population; ++i)
+            {
+                optim->set_design_fitness(i, schedule->get_fitness(i));
+            }
+
+            schedule->start_generation();
+        }
+        else if (fidelity)
+        {
+            for (size_t i = 0; i < population; ++i)
+            {
+                optim->set_design_fitness(i, fidelity->get_fitness(i));
+            }
+
+            fidelity->start_generation();
+        }
+
         // If so, update the design variables and set parameters
-        optim.update_designs();
+        optim->update_designs();
+        fitness_cache.end_generation();
+
+        // Size the schedules for the new population of a restarted optimizer
+        if (optim->design_count() != population)
+        {
+            if (schedule)
+            {
+                schedule = std::make_unique<EvaluationSchedule>(optim->design_count(), track_count);
+            }
+            else if (fidelity)
+            {
+                fidelity = std::make_unique<FidelitySchedule>(optim->design_count(), fidelity_promote_fraction);
+            }
+        }
+
+        racing.end_generation();
+        update_novelty_archive();
         current_generation += 1;
         current_design_index = 0;
     }
 
+    // Select the design and track of the next scheduled episode
+    if (schedule)
+    {
+        current_design_index = schedule->current_design();
+        track_id = schedule->current_track();
+    }
+    else if (fidelity)
+    {
+        current_design_index = fidelity->current_design();
+    }
+
     // Set the flag to update the design variables on next update call
     set_update_design_flag();
 }
@@ -86,14 +634,14 @@ double OptimState::get_best_distance() const
     return score_best;
 }
 
-NeuralNetwork* OptimState::get_optim_network()
+NeuralModel* OptimState::get_optim_network()
 {
-    return &net_optim;
+    return net_optim.get();
 }
 
-NeuralNetwork* OptimState::get_best_network()
+NeuralModel* OptimState::get_best_network()
 {
-    return &net_best;
+    return net_best.get();
 }
 
 size_t OptimState::get_current_generation() const
@@ -120,3 +668,228 @@ size_t OptimState::get_num_best_update_counts() const
 {
     return num_best_update_count;
 }
+
+void OptimState::set_track_id(const size_t id)
+{
+    // The track of each episode is chosen by the schedule when there is one
+    if (!schedule)
+    {
+        track_id = id;
+    }
+}
+
+size_t OptimState::get_track_id() const
+{
+    return track_id;
+}
+
+void OptimState::set_track_count(const size_t count)
+{
+    track_count = count;
+
+    // Schedule the episodes across tracks only when there is more than one track,
+    // and only for a single objective at a single fidelity
+    if (optim_successive_halving && count > 1 && optim->objective_count() == 1 && !fidelity)
+    {
+        schedule = std::make_unique<EvaluationSchedule>(optim->design_count(), count);
+        current_design_index = schedule->current_design();
+        track_id = schedule->current_track();
+    }
+    else
+    {
+        schedule.reset();
+    }
+
+    set_update_design_flag();
+}
+
+size_t OptimState::warm_start(const std::vector<std::vector<double>>& parameters)
+{
+    std::vector<std::vector<double>> seeds;
+    for (const std::vector<double>& values : parameters)
+    {
+        if (values.size() == optim->design_variable_count())
+        {
+            seeds.push_back(values);
+        }
+    }
+
+    if (!seeds.empty())
+    {
+        optim->seed_population(seeds, warm_start_spread, warm_start_interpolation_rate);
+        set_update_design_flag();
+    }
+
+    return seeds.size();
+}
+
+size_t OptimState::get_generation_episode_count() const
+{
+    if (schedule)
+    {
+        return schedule->get_episode_count();
+    }
+    else if (fidelity)
+    {
+        return fidelity->get_episode_count();
+    }
+    else
+    {
+        return optim->design_count();
+    }
+}
+
+Car::Fidelity OptimState::get_episode_fidelity() const
+{
+    return (fidelity && fidelity->is_screening()) ? Car::Fidelity::SCREENING : Car::Fidelity::FULL;
+}
+
+bool OptimState::has_track_schedule() const
+{
+    return static_cast<bool>(schedule);
+}
+
+bool OptimState::has_multi_fidelity() const
+{
+    return static_cast<bool>(fidelity);
+}
+
+size_t OptimState::get_fidelity_promoted_count() const
+{
+    return fidelity ? fidelity->get_promoted_count() : optim->design_count();
+}
+
+double OptimState::get_fidelity_correlation() const
+{
+    return fidelity ? fidelity->get_correlation() : 0.0;
+}
+
+double OptimState::get_cache_hit_rate() const
+{
+    return fitness_cache.get_last_hit_rate();
+}
+
+size_t OptimState::get_pareto_front_size() const
+{
+    const NsgaOptim* nsga = dynamic_cast<const NsgaOptim*>(optim.get());
+    return (nsga != nullptr) ? nsga->archive_size() : 0;
+}
+
+const double* OptimState::get_pareto_objectives(const size_t i) const
+{
+    const NsgaOptim* nsga = dynamic_cast<const NsgaOptim*>(optim.get());
+    if (nsga == nullptr)
+    {
+        throw std::runtime_error("the optimizer does not provide a Pareto front");
+    }
+
+    return nsga->get_archive_objectives(i);
+}
+
+std::unique_ptr<NeuralModel> OptimState::get_pareto_network(const size_t i) const
+{
+    const NsgaOptim* nsga = dynamic_cast<const NsgaOptim*>(optim.get());
+    if (nsga == nullptr)
+    {
+        throw std::runtime_error("the optimizer does not provide a Pareto front");
+    }
+
+    std::unique_ptr<NeuralModel> net = net_optim->clone();
+    net->set_parameters(nsga->get_archive_design(i));
+    return net;
+}
+
+size_t OptimState::get_elite_library_size() const
+{
+    const MapElitesOptim* map_elites = dynamic_cast<const MapElitesOptim*>(optim.get());
+    return (map_elites != nullptr) ? map_elites->elite_count() : 0;
+}
+
+double OptimState::get_elite_distance(const size_t i) const
+{
+    const MapElitesOptim* map_elites = dynamic_cast<const MapElitesOptim*>(optim.get());
+    if (map_elites == nullptr)
+    {
+        throw std::runtime_error("the optimizer does not provide an elite library");
+    }
+
+    return map_elites->get_elite_fitness(i);
+}
+
+const double* OptimState::get_elite_behavior(const size_t i) const
+{
+    const MapElitesOptim* map_elites = dynamic_cast<const MapElitesOptim*>(optim.get());
+    if (map_elites == nullptr)
+    {
+        throw std::runtime_error("the optimizer does not provide an elite library");
+    }
+
+    return map_elites->get_elite_behavior(i);
+}
+
+std::unique_ptr<NeuralModel> OptimState::get_elite_network(const size_t i) const
+{
+    const MapElitesOptim* map_elites = dynamic_cast<const MapElitesOptim*>(optim.get());
+    if (map_elites == nullptr)
+    {
+        throw std::runtime_error("the optimizer does not provide an elite library");
+    }
+
+    std::unique_ptr<NeuralModel> net = net_optim->clone();
+    net->set_parameters(map_elites->get_elite_design(i));
+    return net;
+}
+
+bool OptimState::has_surrogate() const
+{
+    return dynamic_cast<const SurrogateGeneticOptim*>(get_run_optimizer()) != nullptr;
+}
+
+double OptimState::get_surrogate_rank_correlation() const
+{
+    const SurrogateGeneticOptim* surrogate = dynamic_cast<const SurrogateGeneticOptim*>(get_run_optimizer());
+    return (surrogate != nullptr) ? surrogate->get_rank_correlation() : 0.0;
+}
+
+size_t OptimState::get_surrogate_saved_episodes() const
+{
+    const SurrogateGeneticOptim* surrogate = dynamic_cast<const SurrogateGeneticOptim*>(get_run_optimizer());
+    return (surrogate != nullptr) ? surrogate->get_saved_episodes() : 0;
+}
+
+bool OptimState::has_generation_stats() const
+{
+    return dynamic_cast<const GeneticOptim*>(get_run_optimizer()) != nullptr;
+}
+
+const GeneticOptim::GenerationStats& OptimState::get_generation_stats() const
+{
+    const GeneticOptim* genetic = dynamic_cast<const GeneticOptim*>(get_run_optimizer());
+    if (genetic == nullptr)
+    {
+        throw std::runtime_error("the optimizer does not provide generation statistics");
+    }
+
+    return genetic->get_generation_stats();
+}
+
+bool OptimState::has_restarts() const
+{
+    return dynamic_cast<const RestartOptim*>(optim.get()) != nullptr;
+}
+
+size_t OptimState::get_restart_count() const
+{
+    const RestartOptim* restart = dynamic_cast<const RestartOptim*>(optim.get());
+    return (restart != nullptr) ? restart->restart_count() : 0;
+}
+
+size_t OptimState::get_population_size() const
+{
+    return optim->design_count();
+}
+
+const RacingMonitor& OptimState::get_racing_monitor() const
+{
+    return racing;
+}
@@ -1,8 +1,16 @@
 #ifndef __IO_OPTIM_STATE__
 #define __IO_OPTIM_STATE
 
-#include "neural/net.h"
+#include <memory>
+
+#include "neural/model.h"
+#include "optim/evaluation_schedule.h"
+#include "optim/fidelity_schedule.h"
+#include "optim/fitness_cache.h"
 #include "optim/genetic.h"
+#include "optim/novelty_archive.h"
+#include "optim/optimizer.h"
+#include "optim/racing.h"
 
 #include "car/car.h"
 
@@ -11,17 +19,52 @@
 /// </summary>
 class OptimState
 {
+public:
+    /// <summary>
+    /// Provides options for the type of network to optimize
+    /// </summary>
+    enum class NetworkType
+    {
+        FULL = 0,
+        LOW_RANK = 1,
+        TERNARY = 2,
+        MIXTURE = 3
+    };
+
+    /// <summary>
+    /// Provides options for the optimization algorithm used for continuous networks
+    /// </summary>
+    enum class Algorithm
+    {
+        GENETIC = 0,
+        CMAES = 1,
+        SEP_CMAES = 2,
+        ES = 3,
+        DE_RAND = 4,
+        DE_CURRENT_TO_BEST = 5,
+        STEADY_STATE_GENETIC = 6,
+        NSGA = 7,
+        MAP_ELITES = 8,
+        SURROGATE_GENETIC = 9,
+        NEAT = 10
+    };
+
 public:
     /// <summary>
     /// Constructs an object to track the overall optimization state
     /// </summary>
     /// <param name="sensor_count">the number of inputs to set</param>
     /// <param name="num_outputs">the number of outputs to set</param>
-    OptimState(const size_t num_inputs, const size_t num_outputs);
+    /// <param name="output_head">how the outputs of the optimized networks are interpreted</param>
+    OptimState(
+        const size_t num_inputs,
+        const size_t num_outputs,
+        const NeuralModel::OutputHead output_head);
 
     /// <summary>
     /// Steps the initial setup for the optimization to update the design
-    /// currently contained in the neural network
+    /// currently contained in the neural network. Designs with a cached fitness
+    /// on the current track are given that fitness and skipped without simulation
     /// </summary>
     /// <returns>true if the car should be reset</returns>
     bool update_network_design();
@@ -34,6 +77,14 @@ public:
     /// <returns>true if the best design has been updated</returns>
     bool check_update_best_design(const Car& car);
 
+    /// <summary>
+    /// Checks the current episode against the racing thresholds, where episodes are
+    /// not raced at multiple fidelities or across scheduled tracks
+    /// </summary>
+    /// <param name="car">the car being simulated with the current design</param>
+    /// <returns>true if the episode should be aborted</returns>
+    bool should_abort_episode(const Car& car);
+
     /// <summary>
     /// Steps to the next network, updating the optimization design variables as necessary
     /// if all designs have been set and accounted for
@@ -50,13 +101,13 @@ public:
     /// Provides the neural network currently used in optimization
     /// </summary>
     /// <returns>the neural network used in optimization for the current generation/design</returns>
-    NeuralNetwork* get_optim_network();
+    NeuralModel* get_optim_network();
 
     /// <summary>
     /// Provides the neural network with the best fitness
     /// </summary>
     /// <returns>the neural network with the best fitness</returns>
-    NeuralNetwork* get_best_network();
+    NeuralModel* get_best_network();
 
     /// <summary>
     /// Provides the current generation
@@ -87,10 +138,224 @@ public:
     /// <returns>the number of calls to check_update_best_design that return true</returns>
     size_t get_num_best_update_counts() const;
 
+    /// <summary>
+    /// Sets the track that designs are evaluated on, used to key the fitness cache,
+    /// which is ignored while the track schedule chooses the track of each episode
+    /// </summary>
+    /// <param name="id">the track index</param>
+    void set_track_id(const size_t id);
+
+    /// <summary>
+    /// Provides the track that the current design is evaluated on
+    /// </summary>
+    /// <returns>the track index</returns>
+    size_t get_track_id() const;
+
+    /// <summary>
+    /// Sets the number of tracks available, scheduling the episodes across the
+    /// tracks by successive halving if enabled
+    /// </summary>
+    /// <param name="count">the track count</param>
+    void set_track_count(const size_t count);
+
+    /// <summary>
+    /// Seeds the optimization from the parameters of previously saved networks,
+    /// ignoring networks whose parameter count does not match the optimized network
+    /// </summary>
+    /// <param name="parameters">the parameters of each network, ordered from the most preferred</param>
+    /// <returns>the number of networks used to seed the optimization</returns>
+    size_t warm_start(const std::vector<std::vector<double>>& parameters);
+
+    /// <summary>
+    /// Provides the number of episodes needed for the last generation
+    /// </summary>
+    /// <returns>the episode count, which is the design count unless scheduled across tracks</returns>
+    size_t get_generation_episode_count() const;
+
+    /// <summary>
+    /// Provides the simulation fidelity of the current episode
+    /// </summary>
+    /// <returns>the fidelity to simulate the current design with</returns>
+    Car::Fidelity get_episode_fidelity() const;
+
+    /// <summary>
+    /// Determines whether designs are evaluated across tracks by successive halving,
+    /// with the track of each episode chosen by the schedule
+    /// </summary>
+    /// <returns>true if the track schedule is used</returns>
+    bool has_track_schedule() const;
+
+    /// <summary>
+    /// Determines whether designs are screened at low fidelity before the best are
+    /// simulated at full fidelity
+    /// </summary>
+    /// <returns>true if multi-fidelity evaluation is used</returns>
+    bool has_multi_fidelity() const;
+
+    /// <summary>
+    /// Provides the number of designs promoted to full fidelity each generation
+    /// </summary>
+    /// <returns>the promoted design count, or the design count without multi-fidelity evaluation</returns>
+    size_t get_fidelity_promoted_count() const;
+
+    /// <summary>
+    /// Provides the correlation between the screening and full fidelity scores of the
+    /// promoted designs in the last generation
+    /// </summary>
+    /// <returns>the correlation, or zero without multi-fidelity evaluation</returns>
+    double get_fidelity_correlation() const;
+
+    /// <summary>
+    /// Provides the fraction of designs in the last generation whose fitness was
+    /// found in the cache instead of being simulated
+    /// </summary>
+    /// <returns>the cache hit rate of the last generation</returns>
+    double get_cache_hit_rate() const;
+
+    /// <summary>
+    /// Provides the number of designs on the Pareto front of a multi-objective optimization
+    /// </summary>
+    /// <returns>the Pareto front size, or zero for single-objective optimizers</returns>
+    size_t get_pareto_front_size() const;
+
+    /// <summary>
+    /// Provides the objectives of a design on the Pareto front, as the distance,
+    /// the average speed and the smoothness
+    /// </summary>
+    /// <param name="i">the Pareto front index</param>
+    /// <returns>a pointer to the objective values</returns>
+    const double* get_pareto_objectives(const size_t i) const;
+
+    /// <summary>
+    /// Provides a network with the design variables of a design on the Pareto front
+    /// </summary>
+    /// <param name="i">the Pareto front index</param>
+    /// <returns>the network for the design</returns>
+    std::unique_ptr<NeuralModel> get_pareto_network(const size_t i) const;
+
+    /// <summary>
+    /// Provides the number of elites in the library of a quality-diversity optimization
+    /// </summary>
+    /// <returns>the elite count, or zero for other optimizers</returns>
+    size_t get_elite_library_size() const;
+
+    /// <summary>
+    /// Provides the distance of an elite in the library
+    /// </summary>
+    /// <param name="i">the elite index</param>
+    /// <returns>the distance</returns>
+    double get_elite_distance(const size_t i) const;
+
+    /// <summary>
+    /// Provides the behavior of an elite in the library, as the average speed and
+    /// the average turn
+    /// </summary>
+    /// <param name="i">the elite index</param>
+    /// <returns>a pointer to the behavior values</returns>
+    const double* get_elite_behavior(const size_t i) const;
+
+    /// <summary>
+    /// Provides a network with the design variables of an elite in the library
+    /// </summary>
+    /// <param name="i">the elite index</param>
+    /// <returns>the network for the elite</returns>
+    std::unique_ptr<NeuralModel> get_elite_network(const size_t i) const;
+
+    /// <summary>
+    /// Determines whether the children are pre-screened by a surrogate model
+    /// </summary>
+    /// <returns>true if the optimizer is the surrogate-assisted genetic algorithm</returns>
+    bool has_surrogate() const;
+
+    /// <summary>
+    /// Provides the rank correlation between the surrogate predictions and the
+    /// simulated fitness of the last generation
+    /// </summary>
+    /// <returns>the Spearman rank correlation, or zero without a surrogate</returns>
+    double get_surrogate_rank_correlation() const;
+
+    /// <summary>
+    /// Provides the number of episodes the surrogate saved in the last generation
+    /// </summary>
+    /// <returns>the number of candidates rejected without simulation, or zero without a surrogate</returns>
+    size_t get_surrogate_saved_episodes() const;
+
+    /// <summary>
+    /// Determines whether the optimizer measures the convergence statistics of each generation
+    /// </summary>
+    /// <returns>true if the optimizer is one of the genetic algorithms</returns>
+    bool has_generation_stats() const;
+
+    /// <summary>
+    /// Provides the convergence statistics of the last generation
+    /// </summary>
+    /// <returns>the fitness quantiles, population spread and mutation step sizes</returns>
+    const GeneticOptim::GenerationStats& get_generation_stats() const;
+
+    /// <summary>
+    /// Determines whether the optimizer is restarted with a new population once it stagnates
+    /// </summary>
+    /// <returns>true if restarts are used</returns>
+    bool has_restarts() const;
+
+    /// <summary>
+    /// Provides the number of times the optimizer has been restarted
+    /// </summary>
+    /// <returns>the restart count, or zero without restarts</returns>
+    size_t get_restart_count() const;
+
+    /// <summary>
+    /// Provides the number of designs in the current generation, which grows or
+    /// shrinks with each restart
+    /// </summary>
+    /// <returns>the population size</returns>
+    size_t get_population_size() const;
+
+    /// <summary>
+    /// Provides the monitor used to race episodes, with the statistics of the last generation
+    /// </summary>
+    /// <returns>the racing monitor</returns>
+    const RacingMonitor& get_racing_monitor() const;
+
+private:
+    /// <summary>
+    /// Records the fitness of the current episode with the track or fidelity schedule,
+    /// or with the optimizer if the episodes are not scheduled
+    /// </summary>
+    /// <param name="score">the fitness of the episode</param>
+    void set_episode_fitness(const double score);
+
+    /// <summary>
+    /// Determines whether the fitness of designs is cached, which requires the fitness
+    /// to be a single value that depends only on the design and the track
+    /// </summary>
+    /// <returns>true if the fitness cache is used</returns>
+    bool use_fitness_cache() const;
+
+    /// <summary>
+    /// Provides the fitness of an episode, blending the distance with the novelty of the
+    /// behavior of the car if novelty search is enabled
+    /// </summary>
+    /// <param name="car">the car simulated with the current design</param>
+    /// <returns>the fitness of the episode</returns>
+    double get_episode_fitness(const Car& car);
+
+    /// <summary>
+    /// Adds the most novel behaviors of the generation to the novelty archive
+    /// </summary>
+    void update_novelty_archive();
+
+    /// <summary>
+    /// Provides the optimizer of the current run, which is the optimizer itself unless
+    /// it is restarted with new populations
+    /// </summary>
+    /// <returns>the current optimizer</returns>
+    const Optimizer* get_run_optimizer() const;
+
 private:
     /// <summary>
-    /// The overall number of designs to use in the optimization within
-    /// each generation
+    /// The number of designs to use in the optimization within each generation,
+    /// or within the first run if the optimizer is restarted
     /// </summary>
     static const size_t num_designs;
 
@@ -98,17 +363,61 @@ private:
     /// <summary>
     /// The neural network used in optimization
     /// </summary>
-    NeuralNetwork net_optim;
+    std::unique_ptr<NeuralModel> net_optim;
 
     /// <summary>
     /// The neural network with the best found so far fitness
     /// </summary>
-    NeuralNetwork net_best;
+    std::unique_ptr<NeuralModel> net_best;
 
     /// <summary>
     /// The optimization algorithm
     /// </summary>
-    GeneticOptim optim;
+    std::unique_ptr<Optimizer> optim;
+
+    /// <summary>
+    /// The schedule of episodes across tracks, or nullptr to evaluate each design once
+    /// on the current track
+    /// </summary>
+    std::unique_ptr<EvaluationSchedule> schedule;
+
+    /// <summary>
+    /// The schedule of episodes across simulation fidelities, or nullptr to simulate
+    /// each design once at full fidelity
+    /// </summary>
+    std::unique_ptr<FidelitySchedule> fidelity;
+
+    /// <summary>
+    /// The fitness of designs already simulated
+    /// </summary>
+    FitnessCache fitness_cache;
+
+    /// <summary>
+    /// The monitor used to abort episodes that fall behind the previous generation
+    /// </summary>
+    RacingMonitor racing;
+
+    /// <summary>
+    /// The behaviors of past designs used to score novelty
+    /// </summary>
+    NoveltyArchive novelty_archive;
+
+    /// <summary>
+    /// The behavior descriptors and novelty of the episodes in the current generation
+    /// </summary>
+    std::vector<double> generation_behaviors;
+    std::vector<double> generation_novelty;
+
+    /// <summary>
+    /// The cache key of the design currently contained in the neural network
+    /// </summary>
+    uint64_t current_design_key = 0;
+
+    /// <summary>
+    /// The track that designs are evaluated on, and the number of tracks
+    /// </summary>
+    size_t track_id = 0;
+    size_t track_count = 1;
 
     /// <summary>
     /// The best distance so far